@@ -0,0 +1,55 @@
+# SPDX-FileCopyrightText: 2023 Gottlieb+Freitag <info@gottliebtfreitag.de>
+# SPDX-License-Identifier: CC0-1.0
+
+# Compile time benchmark
+#
+# Compiles src/benchmarkCompileTime/compileTime.cpp once per matrix size and records the build time
+# of each size in benchmarkCompileTime.csv of the build directory:
+#
+#   cmake --build <build> --target benchmarkCompileTime
+#
+# The compiler is called with gcc/clang style flags. Included by CMakeLists.txt, the file runs
+# itself in script mode (cmake -P) to time each compilation.
+
+if (NOT CMAKE_SCRIPT_MODE_FILE)
+    set(SILI_COMPILE_TIME_SIZES 2 4 6 8 10 12 16 20 CACHE STRING "matrix sizes of the compile time benchmark")
+    set(SILI_COMPILE_TIME_FLAGS "-O2" CACHE STRING "compiler flags of the compile time benchmark")
+
+    string(REPLACE ";" "," sizes "${SILI_COMPILE_TIME_SIZES}")
+    add_custom_target(benchmarkCompileTime
+        COMMAND ${CMAKE_COMMAND}
+                "-DCXX=${CMAKE_CXX_COMPILER}"
+                "-DFLAGS=${SILI_COMPILE_TIME_FLAGS}"
+                "-DSIZES=${sizes}"
+                "-DSOURCE=${CMAKE_CURRENT_SOURCE_DIR}/src/benchmarkCompileTime/compileTime.cpp"
+                "-DINCLUDE=${CMAKE_CURRENT_SOURCE_DIR}/src"
+                "-DOBJECT=${CMAKE_CURRENT_BINARY_DIR}/benchmarkCompileTime.o"
+                "-DOUTPUT=${CMAKE_CURRENT_BINARY_DIR}/benchmarkCompileTime.csv"
+                -P "${CMAKE_CURRENT_LIST_FILE}"
+        COMMENT "Measuring compile times per matrix size"
+        USES_TERMINAL
+        VERBATIM
+    )
+    return()
+endif()
+
+string(REPLACE "," ";" SIZES "${SIZES}")
+separate_arguments(FLAGS UNIX_COMMAND "${FLAGS}")
+
+file(WRITE "${OUTPUT}" "size,milliseconds\n")
+foreach (N IN LISTS SIZES)
+    # seconds followed by six digits of microseconds
+    string(TIMESTAMP start "%s%f")
+    execute_process(COMMAND "${CXX}" -std=c++20 ${FLAGS} "-I${INCLUDE}" "-DSILI_COMPILE_TIME_N=${N}"
+                            -c "${SOURCE}" -o "${OBJECT}"
+                    RESULT_VARIABLE result)
+    string(TIMESTAMP stop "%s%f")
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "compiling ${SOURCE} with ${N}x${N} matrices failed")
+    endif()
+
+    math(EXPR milliseconds "(${stop} - ${start}) / 1000")
+    message(STATUS "${N}x${N}: ${milliseconds} ms")
+    file(APPEND "${OUTPUT}" "${N},${milliseconds}\n")
+endforeach()
+file(REMOVE "${OBJECT}")
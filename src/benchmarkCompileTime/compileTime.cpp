@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+// Translation unit of the compile time benchmark (see cmake/benchmarkCompileTime.cmake),
+// instantiates the compile time unrolled operations for matrices of size SILI_COMPILE_TIME_N.
+
+#include <sili/sili.h>
+
+#ifndef SILI_COMPILE_TIME_N
+#define SILI_COMPILE_TIME_N 10
+#endif
+
+namespace {
+constexpr size_t N = SILI_COMPILE_TIME_N;
+using M = sili::Matrix<N, N, double>;
+
+// fully unrolled element wise loop, independent of SILI_UNROLL_LIMIT
+auto scaleAdd(M& y, M const& x) -> bool {
+    sili::for_each_index<M, sili::unroll::Always>([&](size_t row, size_t col) {
+        y(row, col) += 2. * x(row, col);
+    });
+    return sili::for_each_constexpr<M>([&]<size_t row, size_t col>() {
+        return y(row, col) == x(row, col);
+    });
+}
+}
+
+auto main() -> int {
+    auto a = M{};
+    auto b = M{};
+    for (size_t i{0}; i < N; ++i) {
+        a(i, i) = 2.;
+        b(i, i) = 1.;
+    }
+    auto c = a * b + view_trans(a);
+    auto equal = scaleAdd(c, b);
+    auto [d, ai] = inv(c);
+    auto llt = sili::LLT{c * view_trans(c)};
+    auto x = llt.solve(view_col<0>(b));
+    return equal or d == 0. or sum(ai) == 0. or x(0) == 0.;
+}
@@ -3,6 +3,10 @@
 
 #include "DataGenerator.h"
 
+#include <sili/sili-Quaternion.h>
+
+#include <vector>
+
 #include <nanobench.h>
 
 
@@ -56,11 +60,114 @@ void benchmarkMultiplication() {
         using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
         auto [m1, m2] = data.template getMatrix<Matrix>();
         bench.run(prefix + "multiplication - Eigen3", [&]() {
-            auto z  = Matrix{m1 + m2};
+            auto z  = Matrix{m1 * m2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
+// products with transposed operands, as in normal equations (AᵀA) and covariances (AAᵀ)
+template <typename T, size_t N>
+void benchmarkTransposedMultiplication() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        bench.run(prefix + "multiplication AᵀB - sili", [&]() {
+            auto z  = sili::Matrix{view_trans(m1) * m2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "multiplication ABᵀ - sili", [&]() {
+            auto z  = sili::Matrix{m1 * view_trans(m2)};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "multiplication AᵀBᵀ - sili", [&]() {
+            auto z  = sili::Matrix{view_trans(m1) * view_trans(m2)};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        auto [m1, m2] = data.template getMatrix(arma::Mat<T>(N, N));
+        bench.run(prefix + "multiplication AᵀB - armadillo", [&]() {
+            auto z  = arma::Mat<T>{m1.t() * m2};
+            ankerl::nanobench::doNotOptimizeAway(&z);
+        });
+        bench.run(prefix + "multiplication ABᵀ - armadillo", [&]() {
+            auto z  = arma::Mat<T>{m1 * m2.t()};
+            ankerl::nanobench::doNotOptimizeAway(&z);
+        });
+        bench.run(prefix + "multiplication AᵀBᵀ - armadillo", [&]() {
+            auto z  = arma::Mat<T>{m1.t() * m2.t()};
+            ankerl::nanobench::doNotOptimizeAway(&z);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
+        auto [m1, m2] = data.template getMatrix<Matrix>();
+        bench.run(prefix + "multiplication AᵀB - Eigen3", [&]() {
+            auto z  = Matrix{m1.transpose() * m2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "multiplication ABᵀ - Eigen3", [&]() {
+            auto z  = Matrix{m1 * m2.transpose()};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "multiplication AᵀBᵀ - Eigen3", [&]() {
+            auto z  = Matrix{m1.transpose() * m2.transpose()};
             ankerl::nanobench::doNotOptimizeAway(z);
         });
     }
 }
+// accumulating products into an existing matrix, as in the covariance update of a filter
+template <typename T, size_t N>
+void benchmarkAccumulatedMultiplication() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        auto c = sili::Matrix<N, N, T>{};
+        auto y = sili::Matrix<N, 1, T>{};
+        bench.run(prefix + "multiplication C += A * B - sili", [&]() {
+            c += m1 * m2;
+            ankerl::nanobench::doNotOptimizeAway(c);
+        });
+        bench.run(prefix + "multiplication C += A * B - sili gemm_into", [&]() {
+            sili::gemm_into(c, m1, m2);
+            ankerl::nanobench::doNotOptimizeAway(c);
+        });
+        bench.run(prefix + "multiplication y += A * x - sili", [&]() {
+            y += m1 * view_col<0>(m2);
+            ankerl::nanobench::doNotOptimizeAway(y);
+        });
+        bench.run(prefix + "multiplication y += A * x - sili gemv_into", [&]() {
+            sili::gemv_into(y, m1, view_col<0>(m2));
+            ankerl::nanobench::doNotOptimizeAway(y);
+        });
+    }
+    {
+        auto [m1, m2] = data.template getMatrix(arma::Mat<T>(N, N));
+        auto c = arma::Mat<T>(N, N);
+        bench.run(prefix + "multiplication C += A * B - armadillo", [&]() {
+            c += m1 * m2;
+            ankerl::nanobench::doNotOptimizeAway(&c);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
+        auto [m1, m2] = data.template getMatrix<Matrix>();
+        auto c = Matrix{};
+        auto y = Eigen::Matrix<T, N, 1>{};
+        c.setZero();
+        y.setZero();
+        bench.run(prefix + "multiplication C += A * B - Eigen3", [&]() {
+            c.noalias() += m1 * m2;
+            ankerl::nanobench::doNotOptimizeAway(c);
+        });
+        bench.run(prefix + "multiplication y += A * x - Eigen3", [&]() {
+            y.noalias() += m1 * m2.col(0);
+            ankerl::nanobench::doNotOptimizeAway(y);
+        });
+    }
+}
 template <typename T, size_t N>
 void benchmarkDet() {
     auto data = GenerateData<T, N>{};
@@ -71,6 +178,13 @@ void benchmarkDet() {
             auto z  = det(m1);
             ankerl::nanobench::doNotOptimizeAway(z);
         });
+        if constexpr (N == 4) {
+            // previous path of 4x4 matrices
+            bench.run(prefix + "determinant - sili LU", [&]() {
+                auto z  = sili::LU{m1}.det();
+                ankerl::nanobench::doNotOptimizeAway(z);
+            });
+        }
     }
     {
         auto [m1, m2] = data.template getMatrix(arma::Mat<T>(N, N));
@@ -98,6 +212,13 @@ void benchmarkInv() {
             auto z  = inv(m1);
             ankerl::nanobench::doNotOptimizeAway(z);
         });
+        if constexpr (N == 4) {
+            // previous path of 4x4 matrices
+            bench.run(prefix + "inverse - sili LU", [&]() {
+                auto z  = sili::LU{m1}.inverse();
+                ankerl::nanobench::doNotOptimizeAway(z);
+            });
+        }
     }
     {
         auto [m1, m2] = data.template getMatrix(arma::Mat<T>(N, N));
@@ -116,15 +237,415 @@ void benchmarkInv() {
     }
 }
 
+template <typename T, size_t N>
+void benchmarkCholesky() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        auto a = sili::Matrix{m1 * trans(m1) + sili::makeI<N, T>() * T(N)};
+        auto b = sili::Matrix{view_col<0>(m2)};
+        bench.run(prefix + "inverse times b - sili", [&]() {
+            auto z = sili::Matrix{std::get<1>(inv(a)) * b};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "solve - sili", [&]() {
+            auto z = solve(a, b);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "LU solve - sili", [&]() {
+            auto z = sili::LU{a}.solve(b);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "cholesky solve - sili", [&]() {
+            auto z = sili::LLT{a}.solve(b);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
+        using Vector = Eigen::Matrix<T, N, 1>;
+        auto [m1, m2] = data.template getMatrix<Matrix>();
+        auto a = Matrix{m1 * m1.transpose() + Matrix::Identity() * T(N)};
+        auto b = Vector{m2.col(0)};
+        bench.run(prefix + "cholesky solve - Eigen3", [&]() {
+            auto z = Vector{a.llt().solve(b)};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
 
+template <typename T, size_t N>
+void benchmarkBatch() {
+    constexpr size_t Lanes = sili::details::simd_lanes<T>;
+    auto data  = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    bench.batch(Lanes);
+    auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+    auto ms1 = std::array<sili::Matrix<N, N, T>, Lanes>{};
+    auto ms2 = std::array<sili::Matrix<N, N, T>, Lanes>{};
+    for (size_t i{0}; i < Lanes; ++i) {
+        ms1[i] = m1 * T(i + 1);
+        ms2[i] = m2 * T(i + 1);
+    }
+    {
+        bench.run(prefix + "batch multiplication - sili", [&]() {
+            for (size_t i{0}; i < Lanes; ++i) {
+                auto z = sili::Matrix{ms1[i] * ms2[i]};
+                ankerl::nanobench::doNotOptimizeAway(z);
+            }
+        });
+        auto b1 = sili::load_batch<Lanes>(ms1.data());
+        auto b2 = sili::load_batch<Lanes>(ms2.data());
+        bench.run(prefix + "batch multiplication - sili MatrixBatch", [&]() {
+            auto z = sili::Matrix{b1 * b2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        bench.run(prefix + "batch inverse - sili", [&]() {
+            for (size_t i{0}; i < Lanes; ++i) {
+                auto z = inv(ms1[i]);
+                ankerl::nanobench::doNotOptimizeAway(z);
+            }
+        });
+        auto b1 = sili::load_batch<Lanes>(ms1.data());
+        bench.run(prefix + "batch inverse - sili MatrixBatch", [&]() {
+            auto z = inv(b1);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
+
+
+template <typename T, size_t R, size_t C>
+void benchmarkLstsq() {
+    auto data = GenerateData<T, R>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<R, R, T>>();
+        auto a = sili::Matrix{view<0, 0, R, C>(m1)};
+        auto b = sili::Matrix{view_col<0>(m2)};
+        bench.run(prefix + "least squares normal equations - sili", [&]() {
+            auto z = sili::Matrix{std::get<1>(inv(trans(a) * a)) * (trans(a) * b)};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "least squares QR - sili", [&]() {
+            auto z = lstsq(a, b);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        auto [m1, m2] = data.template getMatrix<Eigen::Matrix<T, R, R>>();
+        auto a = Eigen::Matrix<T, R, C>{m1.leftCols(C)};
+        auto b = Eigen::Matrix<T, R, 1>{m2.col(0)};
+        bench.run(prefix + "least squares QR - Eigen3", [&]() {
+            auto z = Eigen::Matrix<T, C, 1>{a.householderQr().solve(b)};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
+
+template <typename T, size_t N>
+void benchmarkSVD() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        bench.run(prefix + "svd - sili", [&]() {
+            auto z = svd(m1);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
+        auto [m1, m2] = data.template getMatrix<Matrix>();
+        bench.run(prefix + "svd - Eigen3 JacobiSVD", [&]() {
+            auto z = Eigen::JacobiSVD<Matrix>{m1, Eigen::ComputeFullU | Eigen::ComputeFullV};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
+
+template <typename T, size_t N>
+void benchmarkEigSym() {
+    constexpr size_t Lanes = sili::details::simd_lanes<T>;
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        auto a = sili::Matrix{m1 + trans(m1)};
+        bench.run(prefix + "eig_sym - sili", [&]() {
+            auto z = eig_sym(a);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        auto as = std::array<sili::Matrix<N, N, T>, Lanes>{};
+        for (size_t i{0}; i < Lanes; ++i) {
+            as[i] = a * T(i + 1);
+        }
+        auto b = sili::load_batch<Lanes>(as.data());
+        bench.batch(Lanes).run(prefix + "eig_sym - sili MatrixBatch", [&]() {
+            auto z = eig_sym(b);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.batch(1);
+    }
+    {
+        using Matrix = Eigen::Matrix<T, N, N, 0, N, N>;
+        auto [m1, m2] = data.template getMatrix<Matrix>();
+        auto a = Matrix{m1 + m1.transpose()};
+        bench.run(prefix + "eig_sym - Eigen3 SelfAdjointEigenSolver", [&]() {
+            auto z = Eigen::SelfAdjointEigenSolver<Matrix>{a};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        if constexpr (N == 3) {
+            bench.run(prefix + "eig_sym - Eigen3 computeDirect", [&]() {
+                auto z = Eigen::SelfAdjointEigenSolver<Matrix>{};
+                z.computeDirect(a);
+                ankerl::nanobench::doNotOptimizeAway(z);
+            });
+        }
+    }
+}
+
+template <typename T>
+void benchmarkTransform() {
+    auto data = GenerateData<T, 4>{};
+    auto bench = ankerl::nanobench::Bench{};
+    auto [m1, m2] = data.template getMatrix<sili::Matrix<4, 4, T>>();
+    auto c = T(std::cos(0.3));
+    auto s = T(std::sin(0.3));
+    auto rot = sili::Matrix{{{c, -s, T{0}},
+                             {s,  c, T{0}},
+                             {T{0}, T{0}, T{1}}}};
+    auto r1 = sili::rigid(rot, view<0, 3, 3, 4>(m1));
+    auto r2 = sili::rigid(trans(rot), view<0, 3, 3, 4>(m2));
+    auto g1 = sili::Matrix<4, 4, T>{r1};
+    auto g2 = sili::Matrix<4, 4, T>{r2};
+    auto p  = sili::Matrix<3, 1, T>{view<0, 0, 3, 1>(m2)};
+    auto ph = sili::Matrix<4, 1, T>{p(0), p(1), p(2), T{1}};
+    bench.run(prefix + "compose - sili Matrix", [&]() {
+        auto z = sili::Matrix{g1 * g2};
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+    bench.run(prefix + "compose - sili Rigid3", [&]() {
+        auto z = r1 * r2;
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+    bench.run(prefix + "inverse - sili Matrix", [&]() {
+        auto z = inv(g1);
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+    bench.run(prefix + "inverse - sili Rigid3", [&]() {
+        auto z = inv(r1);
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+    bench.run(prefix + "transform point - sili Matrix", [&]() {
+        auto z = sili::Matrix{g1 * ph};
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+    bench.run(prefix + "transform point - sili Rigid3", [&]() {
+        auto z = r1 * p;
+        ankerl::nanobench::doNotOptimizeAway(z);
+    });
+}
+
+template <typename T>
+void benchmarkQuaternion() {
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto q1 = sili::Quaternion<T>{T{0.3}, sili::Matrix<3, 1, T>{T{1}, T{2}, T{3}}};
+        auto q2 = sili::Quaternion<T>{T{1.1}, sili::Matrix<3, 1, T>{T{-2}, T{0.5}, T{1}}};
+        auto v  = sili::Matrix<3, 1, T>{T{0.5}, T{-1}, T{2}};
+        bench.run(prefix + "hamilton product - sili", [&]() {
+            auto z = q1 * q2;
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "rotate - sili", [&]() {
+            auto z = q1.rotate(v);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "rotate via mat() - sili", [&]() {
+            auto z = sili::Matrix{q1.mat() * v};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+    {
+        using Vector = Eigen::Matrix<T, 3, 1>;
+        auto q1 = Eigen::Quaternion<T>{Eigen::AngleAxis<T>{T{0.3}, Vector{T{1}, T{2}, T{3}}.normalized()}};
+        auto q2 = Eigen::Quaternion<T>{Eigen::AngleAxis<T>{T{1.1}, Vector{T{-2}, T{0.5}, T{1}}.normalized()}};
+        auto v  = Vector{T{0.5}, T{-1}, T{2}};
+        bench.run(prefix + "hamilton product - Eigen3", [&]() {
+            auto z = Eigen::Quaternion<T>{q1 * q2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "rotate - Eigen3", [&]() {
+            auto z = Vector{q1 * v};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+    }
+}
+
+template <typename T>
+void benchmarkInterpolation() {
+    constexpr auto n = size_t{1000};
+    auto bench = ankerl::nanobench::Bench{};
+    bench.batch(n);
+    auto q0 = std::vector<sili::Quaternion<T>>{};
+    auto q1 = std::vector<sili::Quaternion<T>>{};
+    auto t  = std::vector<T>{};
+    for (size_t i{0}; i < n; ++i) {
+        q0.emplace_back(T(0.003 * i), sili::Matrix<3, 1, T>{T{1}, T(i % 7), T{2}});
+        q1.emplace_back(T(3. - 0.002 * i), sili::Matrix<3, 1, T>{T(i % 5), T{-1}, T{1}});
+        t.push_back(T(i % 100) / T{100});
+    }
+    auto out = std::vector<sili::Quaternion<T>>(n);
+    bench.run(prefix + "slerp - sili Quaternion::slerp", [&]() {
+        for (size_t i{0}; i < n; ++i) {
+            out[i] = q0[i].slerp(q1[i], t[i]);
+        }
+        ankerl::nanobench::doNotOptimizeAway(out.data());
+    });
+    bench.run(prefix + "slerp - sili batch", [&]() {
+        sili::slerp(q0, q1, t, out);
+        ankerl::nanobench::doNotOptimizeAway(out.data());
+    });
+    bench.run(prefix + "nlerp - sili batch", [&]() {
+        sili::slerp(q0, q1, t, out, sili::Interpolation::nlerp);
+        ankerl::nanobench::doNotOptimizeAway(out.data());
+    });
+    {
+        auto e0 = std::vector<Eigen::Quaternion<T>>{};
+        auto e1 = std::vector<Eigen::Quaternion<T>>{};
+        for (size_t i{0}; i < n; ++i) {
+            e0.emplace_back(q0[i](0), q0[i](1), q0[i](2), q0[i](3));
+            e1.emplace_back(q1[i](0), q1[i](1), q1[i](2), q1[i](3));
+        }
+        auto eOut = std::vector<Eigen::Quaternion<T>>(n);
+        bench.run(prefix + "slerp - Eigen3", [&]() {
+            for (size_t i{0}; i < n; ++i) {
+                eOut[i] = e0[i].slerp(t[i], e1[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(eOut.data());
+        });
+    }
+}
+
+template <typename T, size_t N>
+void benchmarkDynamic() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        // the arena is reset once per iteration, like once per frame of a real time loop,
+        // m1 and m2 stay at its front and are reserved again after each reset
+        auto buffer = std::vector<std::byte>(8 * N * N * sizeof(T) + 1024);
+        auto arena  = sili::Arena{buffer};
+        auto [m1, m2] = data.template getMatrix(sili::DynMatrix<T>{N, N, &arena});
+        auto used = arena.used();
+        bench.run(prefix + "dynamic addition - sili DynMatrix", [&]() {
+            auto z = m1 + m2;
+            ankerl::nanobench::doNotOptimizeAway(z.data());
+            arena.reset();
+            arena.allocate(used, 1);
+        });
+        bench.run(prefix + "dynamic multiplication - sili DynMatrix", [&]() {
+            auto z = m1 * m2;
+            ankerl::nanobench::doNotOptimizeAway(z.data());
+            arena.reset();
+            arena.allocate(used, 1);
+        });
+    }
+    {
+        auto [m1, m2] = data.template getMatrix(arma::Mat<T>(N, N));
+        bench.run(prefix + "dynamic addition - armadillo", [&]() {
+            auto z = arma::Mat<T>{m1 + m2};
+            ankerl::nanobench::doNotOptimizeAway(&z);
+        });
+        bench.run(prefix + "dynamic multiplication - armadillo", [&]() {
+            auto z = arma::Mat<T>{m1 * m2};
+            ankerl::nanobench::doNotOptimizeAway(&z);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+        auto [m1, m2] = data.template getMatrix(Matrix(N, N));
+        bench.run(prefix + "dynamic addition - Eigen3", [&]() {
+            auto z = Matrix{m1 + m2};
+            ankerl::nanobench::doNotOptimizeAway(z.data());
+        });
+        bench.run(prefix + "dynamic multiplication - Eigen3", [&]() {
+            auto z = Matrix{m1 * m2};
+            ankerl::nanobench::doNotOptimizeAway(z.data());
+        });
+    }
+}
+
+// N×N inside a 12×12 bound, so all sizes share one instantiation
+template <typename T, size_t N>
+void benchmarkBounded() {
+    auto data = GenerateData<T, N>{};
+    auto bench = ankerl::nanobench::Bench{};
+    {
+        auto [m1, m2] = data.template getMatrix(sili::BoundedMatrix<12, 12, T>{N, N});
+        bench.run(prefix + "bounded multiplication - sili BoundedMatrix", [&]() {
+            auto z = m1 * m2;
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded inverse - sili BoundedMatrix", [&]() {
+            auto [d, z] = inv(m1);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded solve - sili BoundedMatrix", [&]() {
+            auto [x, singular] = solve(m1, view_col(m2, 0));
+            ankerl::nanobench::doNotOptimizeAway(x);
+        });
+    }
+    {
+        auto [m1, m2] = data.template getMatrix<sili::Matrix<N, N, T>>();
+        bench.run(prefix + "bounded multiplication - sili fixed size", [&]() {
+            auto z = sili::Matrix{m1 * m2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded inverse - sili fixed size", [&]() {
+            auto [d, z] = inv(m1);
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded solve - sili fixed size", [&]() {
+            auto [x, singular] = solve(m1, view_col<0>(m2));
+            ankerl::nanobench::doNotOptimizeAway(x);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor, 12, 12>;
+        auto [m1, m2] = data.template getMatrix(Matrix(N, N));
+        bench.run(prefix + "bounded multiplication - Eigen3", [&]() {
+            auto z = Matrix{m1 * m2};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded inverse - Eigen3", [&]() {
+            auto z = Matrix{m1.inverse()};
+            ankerl::nanobench::doNotOptimizeAway(z);
+        });
+        bench.run(prefix + "bounded solve - Eigen3", [&]() {
+            auto x = Eigen::Matrix<T, Eigen::Dynamic, 1, 0, 12, 1>{m1.partialPivLu().solve(m2.col(0))};
+            ankerl::nanobench::doNotOptimizeAway(x);
+        });
+    }
+}
 
 template <typename T, size_t N>
 void benchmark() {
     benchmarkAddition<T, N>();
     benchmarkMultiplication<T, N>();
+    benchmarkTransposedMultiplication<T, N>();
     if constexpr (std::is_floating_point_v<T>) {
+        benchmarkAccumulatedMultiplication<T, N>();
         benchmarkDet<T, N>();
         benchmarkInv<T, N>();
+        benchmarkCholesky<T, N>();
+        if constexpr (N <= 6) {
+            benchmarkBatch<T, N>();
+        }
     }
 }
 
@@ -171,3 +692,53 @@ TEST_CASE("Matrix", "[benchmark]") {
     SECTION("int64 20x20", "[int64][20x20]")  { prefix="int64 20x20"; benchmark<int64_t, 20>(); }
 
 }
+
+TEST_CASE("Least squares", "[benchmark]") {
+    SECTION("float 12x6",   "[float][12x6]")   { prefix="float 12x6";   benchmarkLstsq<float,  12, 6>(); }
+    SECTION("float 20x3",   "[float][20x3]")   { prefix="float 20x3";   benchmarkLstsq<float,  20, 3>(); }
+    SECTION("double 12x6",  "[double][12x6]")  { prefix="double 12x6";  benchmarkLstsq<double, 12, 6>(); }
+    SECTION("double 20x3",  "[double][20x3]")  { prefix="double 20x3";  benchmarkLstsq<double, 20, 3>(); }
+}
+
+TEST_CASE("Singular value decomposition", "[benchmark]") {
+    SECTION("float 3x3",  "[float][3x3]")  { prefix="float 3x3";  benchmarkSVD<float,  3>(); }
+    SECTION("float 6x6",  "[float][6x6]")  { prefix="float 6x6";  benchmarkSVD<float,  6>(); }
+    SECTION("double 3x3", "[double][3x3]") { prefix="double 3x3"; benchmarkSVD<double, 3>(); }
+    SECTION("double 6x6", "[double][6x6]") { prefix="double 6x6"; benchmarkSVD<double, 6>(); }
+}
+
+TEST_CASE("Symmetric eigen decomposition", "[benchmark]") {
+    SECTION("float 3x3",  "[float][3x3]")  { prefix="float 3x3";  benchmarkEigSym<float,  3>(); }
+    SECTION("float 6x6",  "[float][6x6]")  { prefix="float 6x6";  benchmarkEigSym<float,  6>(); }
+    SECTION("double 3x3", "[double][3x3]") { prefix="double 3x3"; benchmarkEigSym<double, 3>(); }
+    SECTION("double 6x6", "[double][6x6]") { prefix="double 6x6"; benchmarkEigSym<double, 6>(); }
+}
+
+TEST_CASE("Transformations", "[benchmark]") {
+    SECTION("float",  "[float]")  { prefix="float 4x4";  benchmarkTransform<float>(); }
+    SECTION("double", "[double]") { prefix="double 4x4"; benchmarkTransform<double>(); }
+}
+
+TEST_CASE("Dynamic matrix", "[benchmark]") {
+    SECTION("float 5x5",    "[float][5x5]")    { prefix="float 5x5";    benchmarkDynamic<float,   5>(); }
+    SECTION("float 20x20",  "[float][20x20]")  { prefix="float 20x20";  benchmarkDynamic<float,  20>(); }
+    SECTION("double 5x5",   "[double][5x5]")   { prefix="double 5x5";   benchmarkDynamic<double,  5>(); }
+    SECTION("double 20x20", "[double][20x20]") { prefix="double 20x20"; benchmarkDynamic<double, 20>(); }
+}
+
+TEST_CASE("Bounded matrix", "[benchmark]") {
+    SECTION("float 6x6",    "[float][6x6]")    { prefix="float 6x6";    benchmarkBounded<float,   6>(); }
+    SECTION("float 12x12",  "[float][12x12]")  { prefix="float 12x12";  benchmarkBounded<float,  12>(); }
+    SECTION("double 6x6",   "[double][6x6]")   { prefix="double 6x6";   benchmarkBounded<double,  6>(); }
+    SECTION("double 12x12", "[double][12x12]") { prefix="double 12x12"; benchmarkBounded<double, 12>(); }
+}
+
+TEST_CASE("Quaternion", "[benchmark]") {
+    SECTION("float",  "[float]")  { prefix="float ";  benchmarkQuaternion<float>(); }
+    SECTION("double", "[double]") { prefix="double "; benchmarkQuaternion<double>(); }
+}
+
+TEST_CASE("Quaternion interpolation", "[benchmark]") {
+    SECTION("float",  "[float]")  { prefix="float ";  benchmarkInterpolation<float>(); }
+    SECTION("double", "[double]") { prefix="double "; benchmarkInterpolation<double>(); }
+}
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+#include <sili/sili.h>
+#include <sili/parallel.h>
+#include <armadillo>
+#include <eigen3/Eigen/Dense>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+template <typename M>
+void fillRandom(M& m, size_t rows, size_t cols, unsigned seed) {
+    auto gen  = std::mt19937{seed};
+    auto dist = std::uniform_real_distribution<double>{-1., 1.};
+    for (size_t row{0}; row < rows; ++row) {
+        for (size_t col{0}; col < cols; ++col) {
+            m(row, col) = dist(gen);
+        }
+    }
+}
+
+// large runtime sized products, reported as floating point operations per second
+template <typename T>
+void benchmarkGemm(std::string const& prefix, size_t m, size_t k, size_t n) {
+    auto bench = ankerl::nanobench::Bench{};
+    bench.unit("flop");
+    bench.batch(2 * m * n * k);
+    bench.minEpochIterations(1);
+    {
+        auto a = sili::DynMatrix<T>{m, k};
+        auto b = sili::DynMatrix<T>{k, n};
+        fillRandom(a, m, k, 1);
+        fillRandom(b, k, n, 2);
+        bench.run(prefix + "gemm - sili DynMatrix", [&]() {
+            auto c = a * b;
+            ankerl::nanobench::doNotOptimizeAway(c.data());
+        });
+    }
+    {
+        auto a = arma::Mat<T>(m, k);
+        auto b = arma::Mat<T>(k, n);
+        fillRandom(a, m, k, 1);
+        fillRandom(b, k, n, 2);
+        bench.run(prefix + "gemm - armadillo", [&]() {
+            auto c = arma::Mat<T>{a * b};
+            ankerl::nanobench::doNotOptimizeAway(&c);
+        });
+    }
+    {
+        using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+        auto a = Matrix(m, k);
+        auto b = Matrix(k, n);
+        fillRandom(a, m, k, 1);
+        fillRandom(b, k, n, 2);
+        bench.run(prefix + "gemm - Eigen3", [&]() {
+            auto c = Matrix{a * b};
+            ankerl::nanobench::doNotOptimizeAway(c.data());
+        });
+    }
+}
+
+// scaling of the tiled parallel product from a single thread up to all hardware threads
+template <typename T>
+void benchmarkGemmParallel(std::string const& prefix, size_t m, size_t k, size_t n) {
+    auto a = sili::DynMatrix<T>{m, k};
+    auto b = sili::DynMatrix<T>{k, n};
+    fillRandom(a, m, k, 1);
+    fillRandom(b, k, n, 2);
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.unit("flop");
+    bench.batch(2 * m * n * k);
+    bench.minEpochIterations(1);
+    bench.relative(true);
+
+    // 1, 2, 4, … threads and all hardware threads
+    auto maxThreads   = size_t{std::max(1u, std::thread::hardware_concurrency())};
+    auto threadCounts = std::vector<size_t>{};
+    for (size_t threads{1}; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (auto threads : threadCounts) {
+        auto pool = sili::parallel::ThreadPool{threads};
+        bench.run(prefix + "parallel gemm - " + std::to_string(threads) + " threads", [&]() {
+            auto c = sili::parallel::multiply(pool, a, b);
+            ankerl::nanobench::doNotOptimizeAway(c.data());
+        });
+    }
+}
+}
+
+TEST_CASE("gemm", "[benchmark][gemm]") {
+    SECTION("float 256x256",   "[float][square]")  { benchmarkGemm<float>("float 256x256 ",   256,  256,  256); }
+    SECTION("float 1024x1024", "[float][square]")  { benchmarkGemm<float>("float 1024x1024 ", 1024, 1024, 1024); }
+    SECTION("double 256x256",  "[double][square]") { benchmarkGemm<double>("double 256x256 ",  256,  256,  256); }
+    SECTION("double 1024x1024","[double][square]") { benchmarkGemm<double>("double 1024x1024 ", 1024, 1024, 1024); }
+    SECTION("double 4096x4096","[double][square]") { benchmarkGemm<double>("double 4096x4096 ", 4096, 4096, 4096); }
+
+    // tall-skinny: a long block times a small matrix, and the inner product of two long blocks
+    SECTION("double 8192x64 * 64x64",   "[double][tall]") { benchmarkGemm<double>("double 8192x64 * 64x64 ",   8192, 64,   64); }
+    SECTION("double 64x8192 * 8192x64", "[double][tall]") { benchmarkGemm<double>("double 64x8192 * 8192x64 ", 64,   8192, 64); }
+    SECTION("float 8192x64 * 64x64",    "[float][tall]")  { benchmarkGemm<float>("float 8192x64 * 64x64 ",     8192, 64,   64); }
+}
+
+TEST_CASE("parallel gemm", "[benchmark][gemm][parallel]") {
+    SECTION("float 2048x2048",  "[float][square]")  { benchmarkGemmParallel<float>("float 2048x2048 ",   2048, 2048, 2048); }
+    SECTION("double 1024x1024", "[double][square]") { benchmarkGemmParallel<double>("double 1024x1024 ", 1024, 1024, 1024); }
+    SECTION("double 4096x4096", "[double][square]") { benchmarkGemmParallel<double>("double 4096x4096 ", 4096, 4096, 4096); }
+    SECTION("double 16384x64 * 64x256", "[double][tall]") { benchmarkGemmParallel<double>("double 16384x64 * 64x256 ", 16384, 64, 256); }
+}
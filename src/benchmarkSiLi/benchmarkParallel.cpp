@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+#include <sili/sili.h>
+#include <sili/parallel.h>
+
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+template <typename T, size_t N>
+auto generateMatrices(size_t n) {
+    auto gen  = std::mt19937{N};
+    auto dist = std::uniform_real_distribution<double>{-1000., 1000.};
+    auto ms   = std::vector<sili::Matrix<N, N, T>>(n);
+    for (auto& m : ms) {
+        for (size_t row{0}; row < N; ++row) {
+            for (size_t col{0}; col < N; ++col) {
+                m(row, col) = static_cast<T>(dist(gen));
+            }
+        }
+    }
+    return ms;
+}
+
+// scaling of the parallel functions from a single thread up to all hardware threads
+template <typename T, size_t N>
+void benchmarkParallel(std::string const& prefix) {
+    constexpr size_t n = 1 << 16;
+    auto a   = generateMatrices<T, N>(n);
+    auto b   = generateMatrices<T, N>(n);
+    auto out = std::vector<sili::Matrix<N, N, T>>(n);
+    auto ds  = std::vector<T>(n);
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.batch(n);
+    bench.relative(true);
+
+    // 1, 2, 4, … threads and all hardware threads
+    auto maxThreads   = size_t{std::max(1u, std::thread::hardware_concurrency())};
+    auto threadCounts = std::vector<size_t>{};
+    for (size_t threads{1}; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (auto threads : threadCounts) {
+        auto pool   = sili::parallel::ThreadPool{threads};
+        auto suffix = " - " + std::to_string(threads) + " threads";
+        bench.run(prefix + "multiplication" + suffix, [&]() {
+            sili::parallel::transform(pool, a, b, out, [](auto const& l, auto const& r) {
+                return l * r;
+            });
+            ankerl::nanobench::doNotOptimizeAway(out.data());
+        });
+        bench.run(prefix + "inverse" + suffix, [&]() {
+            sili::parallel::transform(pool, a, out, [](auto const& m) {
+                return std::get<1>(inv(m));
+            });
+            ankerl::nanobench::doNotOptimizeAway(out.data());
+        });
+        bench.run(prefix + "determinant sum" + suffix, [&]() {
+            auto s = sili::parallel::transform_reduce(pool, a, T{}, std::plus{}, [](auto const& m) {
+                return det(m);
+            });
+            ankerl::nanobench::doNotOptimizeAway(s);
+        });
+    }
+}
+}
+
+TEST_CASE("parallel", "[benchmark][parallel]") {
+    SECTION("float 3x3",  "[float][3x3]")  { benchmarkParallel<float,  3>("parallel float 3x3 ");  }
+    SECTION("double 3x3", "[double][3x3]") { benchmarkParallel<double, 3>("parallel double 3x3 "); }
+    SECTION("double 4x4", "[double][4x4]") { benchmarkParallel<double, 4>("parallel double 4x4 "); }
+    SECTION("double 6x6", "[double][6x6]") { benchmarkParallel<double, 6>("parallel double 6x6 "); }
+}
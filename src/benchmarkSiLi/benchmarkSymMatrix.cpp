@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+#include <sili/sili.h>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace {
+// covariance prediction, product with a vector and cholesky of a filter with N states,
+// full matrices against packed symmetric matrices
+template <size_t N, typename T>
+void benchmarkSymMatrix(std::string const& prefix) {
+    auto f = sili::Matrix<N, N, T>{};
+    auto m = sili::Matrix<N, N, T>{};
+    auto x = sili::Matrix<N, 1, T>{};
+    for (size_t row{0}; row < N; ++row) {
+        for (size_t col{0}; col < N; ++col) {
+            f(row, col) = T(row == col) + T(std::sin(double(row * N + col))) / T(N);
+            m(row, col) = T(std::cos(double(row * N + col)));
+        }
+        x(row) = T(row + 1) / T(N);
+    }
+    auto p = sili::Matrix{m * trans(m) + f * T(N)};
+    p = (p + trans(p)) * T(0.5);
+    auto q = sili::Matrix<N, N, T>{};
+    view_diag(q) = T(0.01);
+
+    auto ps = sili::SymMatrix{p};
+    auto qs = sili::SymMatrix{q};
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.relative(true);
+    bench.run(prefix + "F * P * Fᵀ + Q - Matrix", [&]() {
+        auto r = sili::Matrix{f * p * trans(f) + q};
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "F * P * Fᵀ + Q - SymMatrix", [&]() {
+        auto r = sandwich(f, ps) + qs;
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "P * x - Matrix", [&]() {
+        auto r = p * x;
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "P * x - SymMatrix", [&]() {
+        auto r = ps * x;
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "cholesky - Matrix", [&]() {
+        auto r = sili::LLT{p};
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "cholesky - SymMatrix", [&]() {
+        auto r = sili::LLT{ps};
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+}
+}
+
+TEST_CASE("symmetric matrix", "[benchmark][symmatrix]") {
+    SECTION("double 15x15", "[double][15x15]") { benchmarkSymMatrix<15, double>("double 15x15 "); }
+    SECTION("double 21x21", "[double][21x21]") { benchmarkSymMatrix<21, double>("double 21x21 "); }
+    SECTION("float 21x21",  "[float][21x21]")  { benchmarkSymMatrix<21, float>("float 21x21 "); }
+}
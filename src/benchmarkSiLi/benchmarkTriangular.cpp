@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+#include <sili/sili.h>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace {
+// solving with a lower triangular matrix, general solve against the triangular solve
+// with rolled and unrolled substitution
+template <size_t N, size_t C, typename T>
+void benchmarkTriangular(std::string const& prefix) {
+    auto l = sili::Matrix<N, N, T>{};
+    auto b = sili::Matrix<N, C, T>{};
+    for (size_t row{0}; row < N; ++row) {
+        for (size_t col{0}; col <= row; ++col) {
+            l(row, col) = T(row == col ? 2. : std::sin(double(row * N + col)));
+        }
+        for (size_t col{0}; col < C; ++col) {
+            b(row, col) = T(std::cos(double(row * C + col)));
+        }
+    }
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.relative(true);
+    bench.run(prefix + "solve", [&]() {
+        auto r = solve(l, b);
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "trsm - rolled", [&]() {
+        auto r = sili::trsm<sili::unroll::Never>(view_lower_tri(l), b);
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+    bench.run(prefix + "trsm - unrolled", [&]() {
+        auto r = sili::trsm<sili::unroll::Always>(view_lower_tri(l), b);
+        ankerl::nanobench::doNotOptimizeAway(r);
+    });
+}
+}
+
+TEST_CASE("triangular solve", "[benchmark][triangular]") {
+    SECTION("double 4x4 x1",  "[double][4x4]")  { benchmarkTriangular<4, 1, double>("double 4x4 x1 "); }
+    SECTION("double 6x6 x6",  "[double][6x6]")  { benchmarkTriangular<6, 6, double>("double 6x6 x6 "); }
+    SECTION("float 12x12 x1", "[float][12x12]") { benchmarkTriangular<12, 1, float>("float 12x12 x1 "); }
+}
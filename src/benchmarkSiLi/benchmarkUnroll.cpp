@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC-BY-4.0
+
+#include <catch2/catch_all.hpp>
+#include <nanobench.h>
+#include <sili/sili.h>
+
+#include <cstddef>
+#include <string>
+
+namespace {
+// element wise update and reduction, as in operator+=, apply() and sum()
+template <typename Policy, typename M>
+auto kernel(M& y, M const& x) {
+    sili::for_each_index<M, Policy>([&](size_t row, size_t col) {
+        y(row, col) += sili::value_t<M>(2) * x(row, col);
+    });
+    auto acc = sili::value_t<M>{};
+    sili::for_each_index<M, Policy>([&](size_t row, size_t col) {
+        acc += y(row, col);
+    });
+    return acc;
+}
+}
+
+// Each kernel is placed in a section of its own. The linker defines __start_<section> and
+// __stop_<section>, their distance is the size of the code of the kernel (ELF only).
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#define UNROLL_KERNEL(Name, Policy, N, T)                                                          \
+    extern "C" char const __start_##Name[];                                                        \
+    extern "C" char const __stop_##Name[];                                                         \
+    [[gnu::noinline, gnu::flatten, gnu::section(#Name)]]                                           \
+    auto Name(sili::Matrix<N, N, T>& y, sili::Matrix<N, N, T> const& x) -> T {                     \
+        return kernel<Policy>(y, x);                                                               \
+    }                                                                                              \
+    auto Name##_bytes() -> size_t {                                                                \
+        return static_cast<size_t>(__stop_##Name - __start_##Name);                                \
+    }
+#else
+#define UNROLL_KERNEL(Name, Policy, N, T)                                                          \
+    [[gnu::noinline]]                                                                              \
+    auto Name(sili::Matrix<N, N, T>& y, sili::Matrix<N, N, T> const& x) -> T {                     \
+        return kernel<Policy>(y, x);                                                               \
+    }                                                                                              \
+    auto Name##_bytes() -> size_t {                                                                \
+        return 0;                                                                                  \
+    }
+#endif
+
+UNROLL_KERNEL(sili_unrolled_float_4,  sili::unroll::Always, 4,  float)
+UNROLL_KERNEL(sili_rolled_float_4,    sili::unroll::Never,  4,  float)
+UNROLL_KERNEL(sili_unrolled_double_8, sili::unroll::Always, 8,  double)
+UNROLL_KERNEL(sili_rolled_double_8,   sili::unroll::Never,  8,  double)
+UNROLL_KERNEL(sili_unrolled_float_20, sili::unroll::Always, 20, float)
+UNROLL_KERNEL(sili_rolled_float_20,   sili::unroll::Never,  20, float)
+UNROLL_KERNEL(sili_unrolled_double_20, sili::unroll::Always, 20, double)
+UNROLL_KERNEL(sili_rolled_double_20,   sili::unroll::Never,  20, double)
+
+namespace {
+// speed of both modes, the code size in bytes is part of the name
+template <size_t N, typename T, typename Unrolled, typename Rolled>
+void benchmarkUnroll(std::string const& prefix, Unrolled unrolled, size_t unrolledBytes, Rolled rolled, size_t rolledBytes) {
+    auto x = sili::Matrix<N, N, T>{};
+    auto y = sili::Matrix<N, N, T>{};
+    for (size_t row{0}; row < N; ++row) {
+        for (size_t col{0}; col < N; ++col) {
+            x(row, col) = static_cast<T>((row * 7 + col * 3) % 11) / T(16);
+        }
+    }
+
+    auto bench = ankerl::nanobench::Bench{};
+    bench.relative(true);
+    bench.run(prefix + "unrolled (" + std::to_string(unrolledBytes) + " bytes)", [&]() {
+        ankerl::nanobench::doNotOptimizeAway(unrolled(y, x));
+    });
+    bench.run(prefix + "rolled (" + std::to_string(rolledBytes) + " bytes)", [&]() {
+        ankerl::nanobench::doNotOptimizeAway(rolled(y, x));
+    });
+}
+}
+
+TEST_CASE("unroll policy", "[benchmark][unroll]") {
+    SECTION("float 4x4", "[float][4x4]") {
+        benchmarkUnroll<4, float>("float 4x4 ", sili_unrolled_float_4, sili_unrolled_float_4_bytes(),
+                                                sili_rolled_float_4,   sili_rolled_float_4_bytes());
+    }
+    SECTION("double 8x8", "[double][8x8]") {
+        benchmarkUnroll<8, double>("double 8x8 ", sili_unrolled_double_8, sili_unrolled_double_8_bytes(),
+                                                  sili_rolled_double_8,   sili_rolled_double_8_bytes());
+    }
+    SECTION("float 20x20", "[float][20x20]") {
+        benchmarkUnroll<20, float>("float 20x20 ", sili_unrolled_float_20, sili_unrolled_float_20_bytes(),
+                                                   sili_rolled_float_20,   sili_rolled_float_20_bytes());
+    }
+    SECTION("double 20x20", "[double][20x20]") {
+        benchmarkUnroll<20, double>("double 20x20 ", sili_unrolled_double_20, sili_unrolled_double_20_bytes(),
+                                                     sili_rolled_double_20,   sili_rolled_double_20_bytes());
+    }
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "DynMatrix.h"
+#include "concepts.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+
+namespace sili {
+
+/*! Represents a runtime sized matrix with a compile time upper bound
+ * \shortexample sili::BoundedMatrix<MaxRows, MaxCols, double>
+ * \group Classes
+ *
+ * Fulfills the _concept::DynMatrix concept.
+ *
+ * \param MaxRows maximal number of rows
+ * \param MaxCols maximal number of columns
+ * \param T       type of the elements
+ *
+ * The elements are stored inline in a std::array of MaxRows × MaxCols elements, rows() and cols()
+ * are only known at runtime. A BoundedMatrix never allocates, and all sizes up to the bound share
+ * one instantiation of every operation.
+ * Results of operations on BoundedMatrix (operator*, solve, det, inv, …) are BoundedMatrix again,
+ * with bounds derived from the bounds of the operands.
+ * Combined with a DynMatrix the result is a DynMatrix allocated from the resource of the DynMatrix.
+ * Operations on a DynView of a BoundedMatrix return a DynMatrix allocated from the default resource,
+ * resource() of a BoundedMatrix is std::pmr::get_default_resource().
+ *
+ * \code
+ *   // a filter with 3 to 6 states
+ *   auto p = sili::BoundedMatrix<6, 6, double>{states, states};
+ *   view_diag(p) = 1.;
+ *   auto [d, pi] = inv(p * trans(p));
+ * \endcode
+ *
+ * \caption Methods
+ * \param data() returns pointer to the underlying data structure
+ * \param m(row,col) access element at ``row`` and ``col``
+ * \param resize(rows, cols) changes the size, all elements are zero afterwards
+ */
+template <size_t MaxRows, size_t MaxCols, typename T>
+class BoundedMatrix {
+    static_assert(MaxRows > 0 and MaxCols > 0);
+
+    std::array<T, MaxRows * MaxCols> mData{};
+    size_t                           mRows{0};
+    size_t                           mCols{0};
+
+    template <typename M>
+    constexpr void assign(M const& m) {
+        resize(m.rows(), m.cols());
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+    }
+
+public:
+    using value_t = T;
+
+    constexpr BoundedMatrix() = default;
+
+    // all elements are zero
+    constexpr BoundedMatrix(size_t rows, size_t cols)
+        : mRows{rows}
+        , mCols{cols}
+    {
+        assert(rows <= MaxRows and cols <= MaxCols);
+    }
+
+    constexpr BoundedMatrix(std::initializer_list<std::initializer_list<T>> values)
+        : BoundedMatrix{values.size(), values.size() ? values.begin()->size() : 0}
+    {
+        auto row = size_t{0};
+        for (auto const& r : values) {
+            assert(r.size() == mCols);
+            std::copy(r.begin(), r.end(), mData.data() + row * MaxCols);
+            ++row;
+        }
+    }
+
+    template <_concept::DynMatrix M> requires (not std::is_same_v<std::remove_cvref_t<M>, BoundedMatrix>)
+    constexpr explicit BoundedMatrix(M const& m) {
+        assign(m);
+    }
+
+    // copy of a fixed size matrix or view
+    template <_concept::Matrix M> requires (rows_v<M> <= MaxRows and cols_v<M> <= MaxCols)
+    constexpr explicit BoundedMatrix(M const& m)
+        : BoundedMatrix{rows_v<M>, cols_v<M>}
+    {
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+    }
+
+    template <_concept::DynMatrix M> requires (not std::is_same_v<std::remove_cvref_t<M>, BoundedMatrix>)
+    constexpr auto operator=(M const& m) -> BoundedMatrix& {
+        auto first = reinterpret_cast<std::uintptr_t>(mData.data());
+        auto ptr   = reinterpret_cast<std::uintptr_t>(m.data());
+        if (ptr >= first and ptr < first + sizeof(mData)) {
+            // m views this matrix, the elements are copied before they are overwritten
+            return *this = BoundedMatrix{m};
+        }
+        assign(m);
+        return *this;
+    }
+    template <_concept::Matrix M> requires (rows_v<M> <= MaxRows and cols_v<M> <= MaxCols)
+    constexpr auto operator=(M const& m) -> BoundedMatrix& {
+        return *this = BoundedMatrix{m};
+    }
+    constexpr auto operator=(T const& s) -> BoundedMatrix& {
+        for (size_t row{0}; row < mRows; ++row) {
+            std::fill_n(mData.data() + row * MaxCols, mCols, s);
+        }
+        return *this;
+    }
+
+    constexpr void resize(size_t rows, size_t cols) {
+        assert(rows <= MaxRows and cols <= MaxCols);
+        mRows = rows;
+        mCols = cols;
+        mData.fill(T{});
+    }
+
+    constexpr auto rows() const -> size_t {
+        return mRows;
+    }
+    constexpr auto cols() const -> size_t {
+        return mCols;
+    }
+    constexpr auto size() const -> size_t {
+        return mRows * mCols;
+    }
+    constexpr auto row_stride() const -> size_t {
+        return MaxCols;
+    }
+    constexpr auto col_stride() const -> size_t {
+        return 1;
+    }
+    auto resource() const -> std::pmr::memory_resource* {
+        return std::pmr::get_default_resource();
+    }
+
+    constexpr auto data() -> T* {
+        return mData.data();
+    }
+    constexpr auto data() const -> T const* {
+        return mData.data();
+    }
+
+    constexpr auto operator()(size_t row, size_t col) -> T& {
+        assert(row < mRows and col < mCols);
+        return mData[row * MaxCols + col];
+    }
+    constexpr auto operator()(size_t row, size_t col) const -> T const& {
+        assert(row < mRows and col < mCols);
+        return mData[row * MaxCols + col];
+    }
+    // element of a row or column vector
+    constexpr auto operator()(size_t i) -> T& {
+        assert(mRows == 1 or mCols == 1);
+        return mRows == 1 ? (*this)(0, i) : (*this)(i, 0);
+    }
+    constexpr auto operator()(size_t i) const -> T const& {
+        assert(mRows == 1 or mCols == 1);
+        return mRows == 1 ? (*this)(0, i) : (*this)(i, 0);
+    }
+    constexpr auto operator[](size_t i) -> T& {
+        return (*this)(i);
+    }
+    constexpr auto operator[](size_t i) const -> T const& {
+        return (*this)(i);
+    }
+
+    auto view() -> DynView<T> {
+        return {data(), mRows, mCols, MaxCols, 1, resource()};
+    }
+    auto view() const -> DynView<T const> {
+        return {data(), mRows, mCols, MaxCols, 1, resource()};
+    }
+    operator DynView<T>() {
+        return view();
+    }
+    operator DynView<T const>() const {
+        return view();
+    }
+};
+
+}
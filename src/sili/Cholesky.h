@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace sili {
+/*! Cholesky factorization of symmetric positive definite matrices
+ * \shortexample sili::LLT{m}
+ * \group Classes
+ *
+ * \param N size of the factorized matrix
+ * \param T type of the elements
+ *
+ * Factorizes a symmetric positive definite matrix as ``m = L * Lᵀ`` with a lower
+ * triangular L, only the lower triangle of ``m`` is read. ``m`` can also be a SymMatrix.
+ * It needs about half the operations of LU, all loops are unrolled at compile time.
+ * Once factorized, solve(), inverse(), det() and logdet() reuse the factorization.
+ *
+ * failed() is true if ``m`` is not positive definite, in this case all results are invalid.
+ * For a MatrixBatch (T is a Pack) failed() is a mask.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{4., 2.},
+ *                          {2., 5.}}};
+ *   auto llt = sili::LLT{a};
+ *   std::cout << llt.L() << "\n"; // prints {{2., 0.},
+ *                                            {1., 2.}}
+ *   auto x = llt.solve(sili::Matrix{{{6.}, {7.}}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <size_t N, typename T>
+class LLT {
+    using mask_t = std::remove_cvref_t<decltype(std::declval<T>() < std::declval<T>())>;
+
+    Matrix<N, N, T> l{};
+    Matrix<N, 1, T> invDiag{};
+    mask_t          isFailed{false};
+
+public:
+    using value_t = T;
+
+    template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == N and cols_v<M> == N)
+    constexpr explicit LLT(M const& m) {
+        using std::sqrt;
+        for_constexpr<size_t{0}, N>([&]<size_t j>() {
+            auto d = T(m.template at<j, j>());
+            for_constexpr<size_t{0}, j>([&]<size_t k>() {
+                d = d - l.template at<j, k>() * l.template at<j, k>();
+            });
+            // not positive definite, continue with 1 to keep the other lanes valid
+            auto notPositive = not (T{0} < d);
+            isFailed = isFailed || notPositive;
+            auto ljj = sqrt(select(notPositive, T{1}, d));
+            l.template at<j, j>() = ljj;
+            invDiag.template at<j, 0>() = T{1} / ljj;
+
+            for_constexpr<j + 1, N>([&]<size_t i>() {
+                auto s = T(m.template at<i, j>());
+                for_constexpr<size_t{0}, j>([&]<size_t k>() {
+                    s = s - l.template at<i, k>() * l.template at<j, k>();
+                });
+                l.template at<i, j>() = s * invDiag.template at<j, 0>();
+            });
+        });
+    }
+
+    // true (or a mask for packs) if the matrix is not positive definite
+    constexpr auto failed() const -> mask_t {
+        return isFailed;
+    }
+
+    // solves ``m * x = b`` for x, b can be a vector or a matrix with multiple right hand sides
+    template <_concept::Matrix B> requires (rows_v<B> == N)
+    constexpr auto solve(B const& b) const {
+        using R = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<sili::value_t<B>>())>;
+        auto x = Matrix<N, cols_v<B>, R>{b};
+        solve_in_place(x);
+        return x;
+    }
+
+    // inverse of the factorized matrix
+    constexpr auto inverse() const -> Matrix<N, N, T> {
+        auto id = Matrix<N, N, T>{};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            id.template at<k, k>() = T{1};
+        });
+        solve_in_place(id);
+        return id;
+    }
+
+    // determinant of the factorized matrix
+    constexpr auto det() const -> T {
+        auto d = T{1};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            d = d * l.template at<k, k>();
+        });
+        return d * d;
+    }
+
+    // natural logarithm of the determinant, does not overflow for large matrices
+    constexpr auto logdet() const -> T {
+        using std::log;
+        auto d = T{0};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            d = d + log(l.template at<k, k>());
+        });
+        return d + d;
+    }
+
+    // lower triangular matrix L
+    constexpr auto L() const -> Matrix<N, N, T> const& {
+        return l;
+    }
+
+private:
+    template <typename X>
+    constexpr void solve_in_place(X& x) const {
+        // L * y = b, then Lᵀ * x = y
+        constexpr auto C = cols_v<X>;
+        for_constexpr<size_t{0}, N>([&]<size_t row>() {
+            for_constexpr<size_t{0}, row>([&]<size_t k>() {
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() - l.template at<row, k>() * x.template at<k, col>();
+                });
+            });
+            for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                x.template at<row, col>() = x.template at<row, col>() * invDiag.template at<row, 0>();
+            });
+        });
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            constexpr auto row = N - 1 - i;
+            for_constexpr<row + 1, N>([&]<size_t k>() {
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() - l.template at<k, row>() * x.template at<k, col>();
+                });
+            });
+            for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                x.template at<row, col>() = x.template at<row, col>() * invDiag.template at<row, 0>();
+            });
+        });
+    }
+};
+
+template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == cols_v<M>)
+LLT(M const&) -> LLT<rows_v<M>, std::remove_cvref_t<value_t<M>>>;
+
+/*! Square root free Cholesky factorization of symmetric matrices
+ * \shortexample sili::LDLT{m}
+ * \group Classes
+ *
+ * \param N size of the factorized matrix
+ * \param T type of the elements
+ *
+ * Factorizes a symmetric matrix as ``m = L * D * Lᵀ`` with a unit lower triangular L
+ * and a diagonal D, only the lower triangle of ``m`` is read. ``m`` can also be a SymMatrix.
+ * No square roots are needed and, unlike LLT, symmetric indefinite matrices
+ * can be factorized as long as no pivot is zero. There is no pivoting.
+ *
+ * failed() is true if a pivot is zero, in this case all results are invalid.
+ * logdet() is only valid for positive definite matrices.
+ * For a MatrixBatch (T is a Pack) failed() is a mask.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{4., 2.},
+ *                          {2., 5.}}};
+ *   auto ldlt = sili::LDLT{a};
+ *   std::cout << ldlt.D() << "\n"; // prints {{4.}, {4.}}
+ *   std::cout << ldlt.det() << "\n"; // prints 16
+ * \endcode
+ */
+template <size_t N, typename T>
+class LDLT {
+    using mask_t = std::remove_cvref_t<decltype(std::declval<T>() < std::declval<T>())>;
+
+    Matrix<N, N, T> l{};
+    Matrix<N, 1, T> d{};
+    Matrix<N, 1, T> invD{};
+    mask_t          isFailed{false};
+
+public:
+    using value_t = T;
+
+    template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == N and cols_v<M> == N)
+    constexpr explicit LDLT(M const& m) {
+        using std::abs;
+        for_constexpr<size_t{0}, N>([&]<size_t j>() {
+            // work row: w(k) = L(j, k) * D(k)
+            auto w = Matrix<N, 1, T>{};
+            auto dj = T(m.template at<j, j>());
+            for_constexpr<size_t{0}, j>([&]<size_t k>() {
+                w.template at<k, 0>() = l.template at<j, k>() * d.template at<k, 0>();
+                dj = dj - w.template at<k, 0>() * l.template at<j, k>();
+            });
+            // zero pivot, continue with 1 to keep the other lanes valid
+            auto zero = abs(dj) <= T{0};
+            isFailed = isFailed || zero;
+            d.template at<j, 0>()    = dj;
+            invD.template at<j, 0>() = T{1} / select(zero, T{1}, dj);
+            l.template at<j, j>()    = T{1};
+
+            for_constexpr<j + 1, N>([&]<size_t i>() {
+                auto s = T(m.template at<i, j>());
+                for_constexpr<size_t{0}, j>([&]<size_t k>() {
+                    s = s - l.template at<i, k>() * w.template at<k, 0>();
+                });
+                l.template at<i, j>() = s * invD.template at<j, 0>();
+            });
+        });
+    }
+
+    // true (or a mask for packs) if a pivot is zero
+    constexpr auto failed() const -> mask_t {
+        return isFailed;
+    }
+
+    // solves ``m * x = b`` for x, b can be a vector or a matrix with multiple right hand sides
+    template <_concept::Matrix B> requires (rows_v<B> == N)
+    constexpr auto solve(B const& b) const {
+        using R = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<sili::value_t<B>>())>;
+        auto x = Matrix<N, cols_v<B>, R>{b};
+        solve_in_place(x);
+        return x;
+    }
+
+    // inverse of the factorized matrix
+    constexpr auto inverse() const -> Matrix<N, N, T> {
+        auto id = Matrix<N, N, T>{};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            id.template at<k, k>() = T{1};
+        });
+        solve_in_place(id);
+        return id;
+    }
+
+    // determinant of the factorized matrix
+    constexpr auto det() const -> T {
+        auto r = T{1};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            r = r * d.template at<k, 0>();
+        });
+        return r;
+    }
+
+    // natural logarithm of the determinant, does not overflow for large matrices
+    constexpr auto logdet() const -> T {
+        using std::log;
+        auto r = T{0};
+        for_constexpr<size_t{0}, N>([&]<size_t k>() {
+            r = r + log(d.template at<k, 0>());
+        });
+        return r;
+    }
+
+    // unit lower triangular matrix L
+    constexpr auto L() const -> Matrix<N, N, T> const& {
+        return l;
+    }
+
+    // diagonal of D
+    constexpr auto D() const -> Matrix<N, 1, T> const& {
+        return d;
+    }
+
+private:
+    template <typename X>
+    constexpr void solve_in_place(X& x) const {
+        // L * z = b, then D * y = z, then Lᵀ * x = y
+        constexpr auto C = cols_v<X>;
+        for_constexpr<size_t{0}, N>([&]<size_t row>() {
+            for_constexpr<size_t{0}, row>([&]<size_t k>() {
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() - l.template at<row, k>() * x.template at<k, col>();
+                });
+            });
+        });
+        for_constexpr<size_t{0}, N>([&]<size_t row>() {
+            for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                x.template at<row, col>() = x.template at<row, col>() * invD.template at<row, 0>();
+            });
+        });
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            constexpr auto row = N - 1 - i;
+            for_constexpr<row + 1, N>([&]<size_t k>() {
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() - l.template at<k, row>() * x.template at<k, col>();
+                });
+            });
+        });
+    }
+};
+
+template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == cols_v<M>)
+LDLT(M const&) -> LDLT<rows_v<M>, std::remove_cvref_t<value_t<M>>>;
+
+/*! Cholesky factorization
+ * \shortexample cholesky(m)
+ * \group Free Matrix Functions
+ *
+ * \param m _concept::Matrix or SymMatrix, symmetric positive definite
+ * \return  LLT factorization of m
+ */
+template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == cols_v<M>)
+constexpr auto cholesky(M const& m) {
+    return LLT{m};
+}
+
+/*! Square root free Cholesky factorization
+ * \shortexample ldlt(m)
+ * \group Free Matrix Functions
+ *
+ * \param m _concept::Matrix or SymMatrix, symmetric
+ * \return  LDLT factorization of m
+ */
+template <typename M> requires ((_concept::Matrix<M> or _concept::SymMatrix<M>) and rows_v<M> == cols_v<M>)
+constexpr auto ldlt(M const& m) {
+    return LDLT{m};
+}
+
+}
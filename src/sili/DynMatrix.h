@@ -0,0 +1,1317 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.h"
+#include "gemm.h"
+#include "storage.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sili {
+
+/*! Monotonic arena
+ * \shortexample sili::Arena{buffer}
+ * \group Classes
+ *
+ * \param buffer caller provided memory, the arena never allocates memory on its own
+ *
+ * A std::pmr::memory_resource which hands out consecutive pieces of ``buffer``.
+ * Deallocation does nothing, reset() releases all allocations at once, so a real time loop
+ * can allocate freely during one iteration and reset at its end.
+ * If the buffer is exhausted std::bad_alloc is thrown.
+ * Matrices allocated from the arena must not be used after reset().
+ *
+ * \code
+ *   auto buffer = std::array<std::byte, 4096>{};
+ *   auto arena  = sili::Arena{buffer};
+ *   while (running) {
+ *       auto m = sili::DynMatrix<double>{landmarks, 3, &arena};
+ *       …
+ *       arena.reset();
+ *   }
+ * \endcode
+ */
+class Arena : public std::pmr::memory_resource {
+    std::byte* mBuffer;
+    size_t     mCapacity;
+    size_t     mUsed{0};
+
+public:
+    explicit Arena(std::span<std::byte> buffer) noexcept
+        : mBuffer{buffer.data()}
+        , mCapacity{buffer.size()}
+    {}
+
+    Arena(Arena const&) = delete;
+    auto operator=(Arena const&) -> Arena& = delete;
+
+    // releases all allocations
+    void reset() noexcept {
+        mUsed = 0;
+    }
+
+    // bytes in use, including alignment padding
+    auto used() const noexcept -> size_t {
+        return mUsed;
+    }
+    auto capacity() const noexcept -> size_t {
+        return mCapacity;
+    }
+
+private:
+    auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+        auto address = reinterpret_cast<std::uintptr_t>(mBuffer) + mUsed;
+        auto padding = (alignment - address % alignment) % alignment;
+        if (padding + bytes > mCapacity - mUsed) {
+            throw std::bad_alloc{};
+        }
+        auto ptr = mBuffer + mUsed + padding;
+        mUsed += padding + bytes;
+        return ptr;
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+/*! Represents a view onto a runtime sized matrix
+ * \shortexample sili::DynView<double>
+ * \group Classes
+ *
+ * Fulfills the _concept::DynMatrix concept.
+ *
+ * \param T type of the elements, const for read only views
+ *
+ * Element (row, col) is at ``data()[row * row_stride() + col * col_stride()]``, so blocks,
+ * rows, columns, diagonals and transposed views are all DynViews.
+ * Assigning to a view writes its elements, a view is never rebound.
+ * Results of operations on a view are allocated from resource(), the resource of the viewed matrix.
+ *
+ * \caption Methods
+ * \param data() returns pointer to the first element
+ * \param m(row,col) access element at ``row`` and ``col``
+ */
+template <typename T>
+class DynView {
+    T*                         mData;
+    size_t                     mRows;
+    size_t                     mCols;
+    size_t                     mRowStride;
+    size_t                     mColStride;
+    std::pmr::memory_resource* mResource;
+
+    template <typename M>
+    constexpr void assign(M const& m) {
+        assert(rows() == m.rows() and cols() == m.cols());
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+    }
+
+public:
+    using value_t = T;
+
+    constexpr DynView(T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride = 1,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : mData{data}
+        , mRows{rows}
+        , mCols{cols}
+        , mRowStride{rowStride}
+        , mColStride{colStride}
+        , mResource{resource}
+    {}
+
+    // read only view of a writable view
+    template <typename U> requires (std::is_same_v<T, U const>)
+    constexpr DynView(DynView<U> const& v)
+        : DynView{v.data(), v.rows(), v.cols(), v.row_stride(), v.col_stride(), v.resource()}
+    {}
+
+    constexpr DynView(DynView const&) = default;
+
+    constexpr auto operator=(DynView const& v) -> DynView& requires (not std::is_const_v<T>) {
+        assign(v);
+        return *this;
+    }
+    template <_concept::DynMatrix M>
+    constexpr auto operator=(M const& m) -> DynView& requires (not std::is_const_v<T>) {
+        assign(m);
+        return *this;
+    }
+    template <_concept::Matrix M>
+    constexpr auto operator=(M const& m) -> DynView& requires (not std::is_const_v<T>) {
+        assert(rows() == rows_v<M> and cols() == cols_v<M>);
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+        return *this;
+    }
+    constexpr auto operator=(std::remove_const_t<T> const& s) -> DynView& requires (not std::is_const_v<T>) {
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = s;
+            }
+        }
+        return *this;
+    }
+
+    constexpr auto rows() const -> size_t {
+        return mRows;
+    }
+    constexpr auto cols() const -> size_t {
+        return mCols;
+    }
+    constexpr auto row_stride() const -> size_t {
+        return mRowStride;
+    }
+    constexpr auto col_stride() const -> size_t {
+        return mColStride;
+    }
+    constexpr auto resource() const -> std::pmr::memory_resource* {
+        return mResource;
+    }
+    constexpr auto data() const -> T* {
+        return mData;
+    }
+
+    constexpr auto operator()(size_t row, size_t col) const -> T& {
+        assert(row < mRows and col < mCols);
+        return mData[row * mRowStride + col * mColStride];
+    }
+    // element of a row or column vector
+    constexpr auto operator()(size_t i) const -> T& {
+        assert(mRows == 1 or mCols == 1);
+        return mRows == 1 ? (*this)(0, i) : (*this)(i, 0);
+    }
+    constexpr auto operator[](size_t i) const -> T& {
+        return (*this)(i);
+    }
+};
+
+/*! Represents a matrix whose size is only known at runtime
+ * \shortexample sili::DynMatrix<double>
+ * \group Classes
+ *
+ * Fulfills the _concept::DynMatrix concept.
+ *
+ * \param T type of the elements
+ *
+ * The elements are stored row major in one block, which is allocated from a
+ * std::pmr::memory_resource (e.g. an Arena). Without a resource the default resource
+ * (std::pmr::get_default_resource()) is used.
+ * Copies allocate from the resource of the copied matrix, results of operations from the resource
+ * of their left operand, so a computation never leaves the arena of its inputs.
+ * The storage is aligned to the widest vector register.
+ *
+ * \code
+ *   auto buffer = std::array<std::byte, 1024>{};
+ *   auto arena  = sili::Arena{buffer};
+ *   auto a = sili::DynMatrix<double>{{{1., 2.},
+ *                                     {3., 4.}}, &arena};
+ *   auto b = a * trans(a);
+ *   std::cout << b(1, 1) << "\n"; // prints 25
+ * \endcode
+ *
+ * \caption Methods
+ * \param data() returns pointer to the underlying data structure
+ * \param m(row,col) access element at ``row`` and ``col``
+ * \param resize(rows, cols) changes the size, all elements are zero afterwards
+ */
+template <typename T>
+class DynMatrix {
+    static constexpr size_t alignment = std::max(alignof(T), details::simd_register_bytes);
+
+    std::pmr::memory_resource* mResource;
+    T*                         mData{nullptr};
+    size_t                     mRows{0};
+    size_t                     mCols{0};
+
+    void allocate(size_t rows, size_t cols) {
+        if (rows * cols > 0) {
+            mData = static_cast<T*>(mResource->allocate(rows * cols * sizeof(T), alignment));
+            std::uninitialized_value_construct_n(mData, rows * cols);
+        }
+        mRows = rows;
+        mCols = cols;
+    }
+    void release() noexcept {
+        if (mData) {
+            std::destroy_n(mData, size());
+            mResource->deallocate(mData, size() * sizeof(T), alignment);
+        }
+        mData = nullptr;
+        mRows = 0;
+        mCols = 0;
+    }
+    template <typename M>
+    void assign(M const& m) {
+        if (m.rows() != mRows or m.cols() != mCols) {
+            release();
+            allocate(m.rows(), m.cols());
+        }
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+    }
+
+public:
+    using value_t = T;
+
+    explicit DynMatrix(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : mResource{resource}
+    {}
+
+    // all elements are zero
+    DynMatrix(size_t rows, size_t cols, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : mResource{resource}
+    {
+        allocate(rows, cols);
+    }
+
+    DynMatrix(std::initializer_list<std::initializer_list<T>> values, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : mResource{resource}
+    {
+        allocate(values.size(), values.size() ? values.begin()->size() : 0);
+        auto row = size_t{0};
+        for (auto const& r : values) {
+            assert(r.size() == mCols);
+            std::copy(r.begin(), r.end(), mData + row * mCols);
+            ++row;
+        }
+    }
+
+    template <_concept::DynMatrix M>
+    explicit DynMatrix(M const& m, std::pmr::memory_resource* resource)
+        : mResource{resource}
+    {
+        assign(m);
+    }
+    template <_concept::DynMatrix M> requires (not std::is_same_v<std::remove_cvref_t<M>, DynMatrix>)
+    DynMatrix(M const& m)
+        : DynMatrix{m, m.resource()}
+    {}
+
+    // copy of a fixed size matrix
+    template <_concept::Matrix M>
+    explicit DynMatrix(M const& m, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : mResource{resource}
+    {
+        allocate(rows_v<M>, cols_v<M>);
+        for (size_t row{0}; row < mRows; ++row) {
+            for (size_t col{0}; col < mCols; ++col) {
+                (*this)(row, col) = m(row, col);
+            }
+        }
+    }
+
+    DynMatrix(DynMatrix const& m)
+        : mResource{m.mResource}
+    {
+        assign(m);
+    }
+    DynMatrix(DynMatrix&& m) noexcept
+        : mResource{m.mResource}
+        , mData{std::exchange(m.mData, nullptr)}
+        , mRows{std::exchange(m.mRows, 0)}
+        , mCols{std::exchange(m.mCols, 0)}
+    {}
+
+    ~DynMatrix() {
+        release();
+    }
+
+    auto operator=(DynMatrix const& m) -> DynMatrix& {
+        if (this != &m) {
+            assign(m);
+        }
+        return *this;
+    }
+    // the storage is only taken over if both matrices use the same resource
+    auto operator=(DynMatrix&& m) -> DynMatrix& {
+        if (this == &m) {
+            return *this;
+        }
+        if (*mResource == *m.mResource) {
+            release();
+            mData = std::exchange(m.mData, nullptr);
+            mRows = std::exchange(m.mRows, 0);
+            mCols = std::exchange(m.mCols, 0);
+        } else {
+            assign(m);
+        }
+        return *this;
+    }
+    template <_concept::DynMatrix M>
+    auto operator=(M const& m) -> DynMatrix& {
+        auto first = reinterpret_cast<std::uintptr_t>(mData);
+        auto ptr   = reinterpret_cast<std::uintptr_t>(m.data());
+        if (ptr >= first and ptr < first + size() * sizeof(T)) {
+            // m views this matrix, the elements are copied before they are overwritten
+            return *this = DynMatrix{m, mResource};
+        }
+        assign(m);
+        return *this;
+    }
+    template <_concept::Matrix M>
+    auto operator=(M const& m) -> DynMatrix& {
+        return *this = DynMatrix{m, mResource};
+    }
+    auto operator=(T const& s) -> DynMatrix& {
+        std::fill_n(mData, size(), s);
+        return *this;
+    }
+
+    void resize(size_t rows, size_t cols) {
+        if (rows * cols != size()) {
+            release();
+            allocate(rows, cols);
+        } else {
+            mRows = rows;
+            mCols = cols;
+            std::fill_n(mData, size(), T{});
+        }
+    }
+
+    auto rows() const -> size_t {
+        return mRows;
+    }
+    auto cols() const -> size_t {
+        return mCols;
+    }
+    auto size() const -> size_t {
+        return mRows * mCols;
+    }
+    auto row_stride() const -> size_t {
+        return mCols;
+    }
+    auto col_stride() const -> size_t {
+        return 1;
+    }
+    auto resource() const -> std::pmr::memory_resource* {
+        return mResource;
+    }
+
+    auto data() -> T* {
+        return mData;
+    }
+    auto data() const -> T const* {
+        return mData;
+    }
+
+    auto operator()(size_t row, size_t col) -> T& {
+        assert(row < mRows and col < mCols);
+        return mData[row * mCols + col];
+    }
+    auto operator()(size_t row, size_t col) const -> T const& {
+        assert(row < mRows and col < mCols);
+        return mData[row * mCols + col];
+    }
+    // element of a row or column vector
+    auto operator()(size_t i) -> T& {
+        assert((mRows == 1 or mCols == 1) and i < size());
+        return mData[i];
+    }
+    auto operator()(size_t i) const -> T const& {
+        assert((mRows == 1 or mCols == 1) and i < size());
+        return mData[i];
+    }
+    auto operator[](size_t i) -> T& {
+        return (*this)(i);
+    }
+    auto operator[](size_t i) const -> T const& {
+        return (*this)(i);
+    }
+
+    auto view() -> DynView<T> {
+        return {mData, mRows, mCols, mCols, 1, mResource};
+    }
+    auto view() const -> DynView<T const> {
+        return {mData, mRows, mCols, mCols, 1, mResource};
+    }
+    operator DynView<T>() {
+        return view();
+    }
+    operator DynView<T const>() const {
+        return view();
+    }
+};
+
+namespace details {
+template <_concept::DynMatrix M>
+using dyn_value_t = std::remove_const_t<typename std::remove_cvref_t<M>::value_t>;
+
+// compile time upper bounds of the size, std::dynamic_extent if unbounded (DynMatrix and DynView)
+template <typename M>
+struct dyn_bounds {
+    static constexpr size_t rows = std::dynamic_extent;
+    static constexpr size_t cols = std::dynamic_extent;
+};
+template <size_t MaxRows, size_t MaxCols, typename T>
+struct dyn_bounds<BoundedMatrix<MaxRows, MaxCols, T>> {
+    static constexpr size_t rows = MaxRows;
+    static constexpr size_t cols = MaxCols;
+};
+template <typename M>
+constexpr size_t max_rows_v = dyn_bounds<std::remove_cvref_t<M>>::rows;
+template <typename M>
+constexpr size_t max_cols_v = dyn_bounds<std::remove_cvref_t<M>>::cols;
+
+constexpr auto bound_sum(size_t a, size_t b) -> size_t {
+    return a == std::dynamic_extent or b == std::dynamic_extent ? std::dynamic_extent : a + b;
+}
+constexpr auto bound_prod(size_t a, size_t b) -> size_t {
+    return a == std::dynamic_extent or b == std::dynamic_extent ? std::dynamic_extent : a * b;
+}
+
+// storage of a result, a BoundedMatrix if both bounds are known, otherwise a DynMatrix allocated from resource
+template <typename U, size_t MaxRows, size_t MaxCols>
+auto dyn_result(size_t rows, size_t cols, std::pmr::memory_resource* resource) {
+    if constexpr (MaxRows != std::dynamic_extent and MaxCols != std::dynamic_extent) {
+        return BoundedMatrix<MaxRows, MaxCols, U>{rows, cols};
+    } else {
+        return DynMatrix<U>{rows, cols, resource};
+    }
+}
+// result with the size and the bounds of m
+template <typename U, _concept::DynMatrix M>
+auto dyn_result_like(M const& m) {
+    return dyn_result<U, max_rows_v<M>, max_cols_v<M>>(m.rows(), m.cols(), m.resource());
+}
+// resource for the result of a binary operation, r provides it if l is a BoundedMatrix
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto dyn_resource(L const& l, R const& r) -> std::pmr::memory_resource* {
+    if constexpr (max_rows_v<L> != std::dynamic_extent) {
+        return r.resource();
+    } else {
+        return l.resource();
+    }
+}
+// copy of m with elements converted to U
+template <typename U, _concept::DynMatrix M>
+auto dyn_convert(M const& m) {
+    auto ret = dyn_result_like<U>(m);
+    for (size_t row{0}; row < m.rows(); ++row) {
+        for (size_t col{0}; col < m.cols(); ++col) {
+            ret(row, col) = U(m(row, col));
+        }
+    }
+    return ret;
+}
+
+// read only view of a DynMatrix or DynView
+template <_concept::DynMatrix M>
+auto dyn_view(M const& m) -> DynView<dyn_value_t<M> const> {
+    return {m.data(), m.rows(), m.cols(), m.row_stride(), m.col_stride(), m.resource()};
+}
+// writable view of a DynMatrix or DynView
+template <_concept::DynMatrix M>
+auto dyn_view_mut(M&& m) {
+    using T = std::remove_pointer_t<decltype(m.data())>;
+    return DynView<T>{m.data(), m.rows(), m.cols(), m.row_stride(), m.col_stride(), m.resource()};
+}
+
+template <_concept::DynMatrix M, typename Op>
+auto dyn_apply(M const& m, Op op) {
+    using U = std::remove_cvref_t<decltype(op(std::declval<dyn_value_t<M>>()))>;
+    auto ret = dyn_result_like<U>(m);
+    for (size_t row{0}; row < m.rows(); ++row) {
+        for (size_t col{0}; col < m.cols(); ++col) {
+            ret(row, col) = op(m(row, col));
+        }
+    }
+    return ret;
+}
+template <_concept::DynMatrix L, _concept::DynMatrix R, typename Op>
+auto dyn_apply(L const& l, R const& r, Op op) {
+    assert(l.rows() == r.rows() and l.cols() == r.cols());
+    using U = std::remove_cvref_t<decltype(op(std::declval<dyn_value_t<L>>(), std::declval<dyn_value_t<R>>()))>;
+    auto ret = dyn_result<U, max_rows_v<L>, max_cols_v<L>>(l.rows(), l.cols(), dyn_resource(l, r));
+    for (size_t row{0}; row < l.rows(); ++row) {
+        for (size_t col{0}; col < l.cols(); ++col) {
+            ret(row, col) = op(l(row, col), r(row, col));
+        }
+    }
+    return ret;
+}
+
+template <_concept::DynMatrix V>
+auto dyn_length(V const& v) -> size_t {
+    assert(v.rows() == 1 or v.cols() == 1);
+    return v.rows() * v.cols();
+}
+
+// in place LU factorization with partial pivoting, returns the sign of the permutation
+// and if the matrix is singular, pivots[k] is the row swapped with row k
+template <_concept::DynMatrix M>
+auto dyn_lu(M& lu, std::span<size_t> pivots) -> std::tuple<dyn_value_t<M>, bool> {
+    using std::abs;
+    using T       = dyn_value_t<M>;
+    auto n        = lu.rows();
+    auto sign     = T{1};
+    auto singular = false;
+    for (size_t k{0}; k < n; ++k) {
+        auto p = k;
+        for (size_t r{k + 1}; r < n; ++r) {
+            if (abs(lu(p, k)) < abs(lu(r, k))) {
+                p = r;
+            }
+        }
+        pivots[k] = p;
+        if (p != k) {
+            std::swap_ranges(&lu(k, 0), &lu(k, 0) + n, &lu(p, 0));
+            sign = -sign;
+        }
+        // a zero pivot means the column below is zero as well, there is nothing to eliminate
+        if (abs(lu(k, k)) <= T{0}) {
+            singular = true;
+            continue;
+        }
+        auto invPivot = T{1} / lu(k, k);
+        for (size_t r{k + 1}; r < n; ++r) {
+            auto f = lu(r, k) * invPivot;
+            lu(r, k) = f;
+            for (size_t col{k + 1}; col < n; ++col) {
+                lu(r, col) -= f * lu(k, col);
+            }
+        }
+    }
+    return {sign, singular};
+}
+
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+// ret += l * r with the packed gemm, the packing buffers are allocated from the resource of ret
+template <_concept::DynMatrix L, _concept::DynMatrix R, typename T>
+void dyn_gemm_packed(L const& l, R const& r, DynMatrix<T>& ret) {
+    auto packA = DynMatrix<T>{1, gemm_pack_a_size(l.rows(), l.cols()), ret.resource()};
+    auto packB = DynMatrix<T>{1, gemm_pack_b_size<T>(r.cols(), l.cols()), ret.resource()};
+    gemm_packed<T>(l.rows(), r.cols(), l.cols(),
+                   {l.data(), l.row_stride(), l.col_stride()},
+                   {r.data(), r.row_stride(), r.col_stride()},
+                   ret.data(), ret.row_stride(), packA.data(), packB.data());
+}
+#endif
+
+// pivot storage for dyn_lu, inline if the number of rows is bounded
+template <_concept::DynMatrix M>
+auto dyn_pivots(M const& m) {
+    if constexpr (max_rows_v<M> != std::dynamic_extent) {
+        return std::array<size_t, max_rows_v<M>>{};
+    } else {
+        return DynMatrix<size_t>{m.rows(), 1, m.resource()};
+    }
+}
+
+// solves lu * x = P * x in place, lu and pivots as computed by dyn_lu
+template <_concept::DynMatrix M, _concept::DynMatrix X>
+void dyn_lu_solve(M const& lu, std::span<size_t const> pivots, X& x) {
+    using T = dyn_value_t<M>;
+    auto n  = lu.rows();
+    auto k  = x.cols();
+    for (size_t i{0}; i < n; ++i) {
+        if (pivots[i] != i) {
+            for (size_t col{0}; col < k; ++col) {
+                std::swap(x(i, col), x(pivots[i], col));
+            }
+        }
+    }
+    for (size_t row{0}; row < n; ++row) {
+        for (size_t i{0}; i < row; ++i) {
+            for (size_t col{0}; col < k; ++col) {
+                x(row, col) -= lu(row, i) * x(i, col);
+            }
+        }
+    }
+    for (size_t row{n}; row-- > 0;) {
+        for (size_t i{row + 1}; i < n; ++i) {
+            for (size_t col{0}; col < k; ++col) {
+                x(row, col) -= lu(row, i) * x(i, col);
+            }
+        }
+        auto invPivot = T{1} / lu(row, row);
+        for (size_t col{0}; col < k; ++col) {
+            x(row, col) *= invPivot;
+        }
+    }
+}
+}
+
+/*! Number of rows
+ * \shortexample rows(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  number of rows of m
+ */
+template <_concept::DynMatrix M>
+auto rows(M const& m) -> size_t {
+    return m.rows();
+}
+
+/*! Number of columns
+ * \shortexample cols(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  number of columns of m
+ */
+template <_concept::DynMatrix M>
+auto cols(M const& m) -> size_t {
+    return m.cols();
+}
+
+/*! Elementwise addition
+ * \shortexample l + r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix of the same size
+ * \return  DynMatrix allocated from the resource of l
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator+(L const& l, R const& r) {
+    return details::dyn_apply(l, r, [](auto _l, auto _r) { return _l + _r; });
+}
+
+/*! Elementwise addition
+ * \shortexample l += r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix of the same size
+ * \return  l
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator+=(L&& l, R const& r) -> L&& {
+    assert(l.rows() == r.rows() and l.cols() == r.cols());
+    for (size_t row{0}; row < l.rows(); ++row) {
+        for (size_t col{0}; col < l.cols(); ++col) {
+            l(row, col) += r(row, col);
+        }
+    }
+    return std::forward<L>(l);
+}
+
+/*! Elementwise negation
+ * \shortexample -m
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix allocated from the resource of m
+ */
+template <_concept::DynMatrix M>
+auto operator-(M const& m) {
+    return details::dyn_apply(m, [](auto e) { return -e; });
+}
+
+/*! Elementwise subtraction
+ * \shortexample l - r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix of the same size
+ * \return  DynMatrix allocated from the resource of l
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator-(L const& l, R const& r) {
+    return details::dyn_apply(l, r, [](auto _l, auto _r) { return _l - _r; });
+}
+
+/*! Elementwise subtraction
+ * \shortexample l -= r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix of the same size
+ * \return  l
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator-=(L&& l, R const& r) -> L&& {
+    assert(l.rows() == r.rows() and l.cols() == r.cols());
+    for (size_t row{0}; row < l.rows(); ++row) {
+        for (size_t col{0}; col < l.cols(); ++col) {
+            l(row, col) -= r(row, col);
+        }
+    }
+    return std::forward<L>(l);
+}
+
+/*! Matrix multiplication
+ * \shortexample l * r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix with as many rows as l has columns
+ * \return  DynMatrix allocated from the resource of l
+ *
+ * Rows of r are accumulated into rows of the result, so contiguous rows are processed as vectors.
+ * Large products with a DynMatrix result are cache blocked: blocks of l and r are packed into buffers
+ * allocated from the resource of the result and multiplied with a register blocked SIMD kernel,
+ * so views with any stride (e.g. view_trans()) are read contiguously as well.
+ *
+ * \code
+ *   auto a = sili::DynMatrix<int>{{{1, 2},
+ *                                  {3, 4}}};
+ *   auto b = a * a;
+ *   std::cout << b(1, 0) << "\n"; // prints 15
+ * \endcode
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator*(L const& l, R const& r) {
+    assert(l.cols() == r.rows());
+    using U = std::remove_cvref_t<decltype(std::declval<details::dyn_value_t<L>>() * std::declval<details::dyn_value_t<R>>())>;
+    auto ret = details::dyn_result<U, details::max_rows_v<L>, details::max_cols_v<R>>(l.rows(), r.cols(), details::dyn_resource(l, r));
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    using TL = details::dyn_value_t<L>;
+    using TR = details::dyn_value_t<R>;
+    if constexpr (std::is_same_v<decltype(ret), DynMatrix<U>> and std::is_same_v<TL, U> and std::is_same_v<TR, U>
+                  and details::has_simd_register_v<U>) {
+        if (l.rows() * r.cols() * l.cols() >= details::gemm_packed_min) {
+            details::dyn_gemm_packed(l, r, ret);
+            return ret;
+        }
+    }
+#endif
+    auto n   = r.cols();
+    for (size_t i{0}; i < l.rows(); ++i) {
+        auto c = ret.data() + i * ret.row_stride();
+        for (size_t p{0}; p < l.cols(); ++p) {
+            auto a = l(i, p);
+            if (r.col_stride() == 1) {
+                auto b = r.data() + p * r.row_stride();
+                for (size_t j{0}; j < n; ++j) {
+                    c[j] += a * b[j];
+                }
+            } else {
+                for (size_t j{0}; j < n; ++j) {
+                    c[j] += a * r(p, j);
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+/*! Scalar multiplication
+ * \shortexample m * s
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \param s scalar
+ * \return  DynMatrix allocated from the resource of m
+ */
+template <_concept::DynMatrix M>
+auto operator*(M const& m, details::dyn_value_t<M> const& s) {
+    return details::dyn_apply(m, [&](auto e) { return e * s; });
+}
+template <_concept::DynMatrix M>
+auto operator*(details::dyn_value_t<M> const& s, M const& m) {
+    return details::dyn_apply(m, [&](auto e) { return s * e; });
+}
+
+/*! Scalar multiplication
+ * \shortexample m *= s
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \param s scalar
+ * \return  m
+ */
+template <_concept::DynMatrix M>
+auto operator*=(M&& m, details::dyn_value_t<M> const& s) -> M&& {
+    for (size_t row{0}; row < m.rows(); ++row) {
+        for (size_t col{0}; col < m.cols(); ++col) {
+            m(row, col) *= s;
+        }
+    }
+    return std::forward<M>(m);
+}
+
+/*! Divide elements by a scalar
+ * \shortexample m / s
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \param s scalar
+ * \return  DynMatrix allocated from the resource of m
+ */
+template <_concept::DynMatrix M>
+auto operator/(M const& m, details::dyn_value_t<M> const& s) {
+    return details::dyn_apply(m, [&](auto e) { return e / s; });
+}
+
+/*! Divide elements by a scalar
+ * \shortexample m /= s
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \param s scalar
+ * \return  m
+ */
+template <_concept::DynMatrix M>
+auto operator/=(M&& m, details::dyn_value_t<M> const& s) -> M&& {
+    for (size_t row{0}; row < m.rows(); ++row) {
+        for (size_t col{0}; col < m.cols(); ++col) {
+            m(row, col) /= s;
+        }
+    }
+    return std::forward<M>(m);
+}
+
+/*! Elementwise comparision
+ * \shortexample l == r
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix
+ * \return  true if l and r have the same size and all elements are equal
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator==(L const& l, R const& r) -> bool {
+    if (l.rows() != r.rows() or l.cols() != r.cols()) {
+        return false;
+    }
+    for (size_t row{0}; row < l.rows(); ++row) {
+        for (size_t col{0}; col < l.cols(); ++col) {
+            if (not (l(row, col) == r(row, col))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto operator!=(L const& l, R const& r) -> bool {
+    return not (l == r);
+}
+
+/*! View
+ * \shortexample view(m, start_row, start_col, end_row, end_col)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m         _concept::DynMatrix
+ * \param start_row starting row
+ * \param start_col starting column
+ * \param end_row   end row (exclusive)
+ * \param end_col   end column (exclusive)
+ * \return          DynView onto the block of m
+ *
+ * \code
+ *   auto a = sili::DynMatrix<int>{{{1, 2, 3},
+ *                                  {4, 5, 6}}};
+ *   view(a, 0, 1, 2, 3) = sili::DynMatrix<int>{2, 2};
+ *   std::cout << a(1, 2) << "\n"; // prints 0
+ * \endcode
+ */
+template <_concept::DynMatrix M>
+auto view(M&& m, size_t start_row, size_t start_col, size_t end_row, size_t end_col) {
+    assert(start_row <= end_row and end_row <= m.rows() and start_col <= end_col and end_col <= m.cols());
+    auto v = details::dyn_view_mut(m);
+    using V = decltype(v);
+    return V{v.data() + start_row * v.row_stride() + start_col * v.col_stride(),
+             end_row - start_row, end_col - start_col, v.row_stride(), v.col_stride(), v.resource()};
+}
+
+template <_concept::DynMatrix M>
+auto view_row(M&& m, size_t row) {
+    return view(std::forward<M>(m), row, 0, row + 1, m.cols());
+}
+
+template <_concept::DynMatrix M>
+auto view_col(M&& m, size_t col) {
+    return view(std::forward<M>(m), 0, col, m.rows(), col + 1);
+}
+
+/*! Diagonal view
+ * \shortexample view_diag(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynView representing a column vector that gives access to the diagonal of m
+ */
+template <_concept::DynMatrix M>
+auto view_diag(M&& m) {
+    auto v = details::dyn_view_mut(m);
+    using V = decltype(v);
+    return V{v.data(), std::min(v.rows(), v.cols()), 1, v.row_stride() + v.col_stride(), 1, v.resource()};
+}
+
+/*! Diagonal
+ * \shortexample diag(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix as a column vector with the diagonal values of m
+ */
+template <_concept::DynMatrix M>
+auto diag(M const& m) {
+    constexpr auto maxRows = std::min(details::max_rows_v<M>, details::max_cols_v<M>);
+    auto ret = details::dyn_result<details::dyn_value_t<M>, maxRows, 1>(std::min(m.rows(), m.cols()), 1, m.resource());
+    ret = view_diag(m);
+    return ret;
+}
+
+/*! Transposed view
+ * \shortexample view_trans(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynView of the transposed of m
+ */
+template <_concept::DynMatrix M>
+auto view_trans(M&& m) {
+    auto v = details::dyn_view_mut(m);
+    using V = decltype(v);
+    return V{v.data(), v.cols(), v.rows(), v.col_stride(), v.row_stride(), v.resource()};
+}
+
+/*! Transposed
+ * \shortexample trans(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix of the transposed of m
+ */
+template <_concept::DynMatrix M>
+auto trans(M const& m) {
+    auto ret = details::dyn_result<details::dyn_value_t<M>, details::max_cols_v<M>, details::max_rows_v<M>>(m.cols(), m.rows(), m.resource());
+    ret = view_trans(m);
+    return ret;
+}
+
+/*! Joins rows
+ * \shortexample join_rows(l, r)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix with the same number of rows
+ * \return  DynMatrix with the columns of l followed by the columns of r
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto join_rows(L const& l, R const& r) {
+    assert(l.rows() == r.rows());
+    constexpr auto maxCols = details::bound_sum(details::max_cols_v<L>, details::max_cols_v<R>);
+    auto ret = details::dyn_result<details::dyn_value_t<L>, details::max_rows_v<L>, maxCols>(l.rows(), l.cols() + r.cols(), details::dyn_resource(l, r));
+    view(ret, 0, 0, l.rows(), l.cols()) = l;
+    view(ret, 0, l.cols(), r.rows(), l.cols() + r.cols()) = r;
+    return ret;
+}
+
+/*! Joins columns
+ * \shortexample join_cols(l, r)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix
+ * \param r _concept::DynMatrix with the same number of columns
+ * \return  DynMatrix with the rows of l followed by the rows of r
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto join_cols(L const& l, R const& r) {
+    assert(l.cols() == r.cols());
+    constexpr auto maxRows = details::bound_sum(details::max_rows_v<L>, details::max_rows_v<R>);
+    auto ret = details::dyn_result<details::dyn_value_t<L>, maxRows, details::max_cols_v<L>>(l.rows() + r.rows(), l.cols(), details::dyn_resource(l, r));
+    view(ret, 0, 0, l.rows(), l.cols()) = l;
+    view(ret, l.rows(), 0, l.rows() + r.rows(), r.cols()) = r;
+    return ret;
+}
+
+//element wise product
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto element_multi(L const& l, R const& r) {
+    return details::dyn_apply(l, r, [](auto _l, auto _r) { return _l * _r; });
+}
+
+/*! Cross product of two vectors.
+ * \shortexample cross(l, r)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix, a vector of length 3
+ * \param r _concept::DynMatrix, a vector of length 3
+ * \return  DynMatrix of size 3×1 allocated from the resource of l
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto cross(L const& l, R const& r) {
+    assert(details::dyn_length(l) == 3 and details::dyn_length(r) == 3);
+    using U = std::remove_cvref_t<decltype(std::declval<details::dyn_value_t<L>>() * std::declval<details::dyn_value_t<R>>())>;
+    constexpr auto maxRows = details::max_rows_v<L> == std::dynamic_extent ? std::dynamic_extent : 3;
+    auto ret = details::dyn_result<U, maxRows, 1>(3, 1, l.resource());
+    ret(0) = l(1) * r(2) - l(2) * r(1);
+    ret(1) = l(2) * r(0) - l(0) * r(2);
+    ret(2) = l(0) * r(1) - l(1) * r(0);
+    return ret;
+}
+
+/*! Sum of all elements.
+ * \shortexample sum(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  Sum off all elements of m.
+ */
+template <_concept::DynMatrix M>
+auto sum(M const& m) {
+    auto acc = details::dyn_value_t<M>{};
+    for (size_t row{0}; row < m.rows(); ++row) {
+        for (size_t col{0}; col < m.cols(); ++col) {
+            acc += m(row, col);
+        }
+    }
+    return acc;
+}
+
+/*! Sum of each row.
+ * \shortexample sum_rows(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix as column vector with the sums of each row of m
+ */
+template <_concept::DynMatrix M>
+auto sum_rows(M const& m) {
+    auto ret = details::dyn_result<details::dyn_value_t<M>, details::max_rows_v<M>, 1>(m.rows(), 1, m.resource());
+    for (size_t row{0}; row < m.rows(); ++row) {
+        ret(row) = sum(view_row(m, row));
+    }
+    return ret;
+}
+
+/*! Sum of each column.
+ * \shortexample sum_cols(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix as row vector with the sums of each column of m
+ */
+template <_concept::DynMatrix M>
+auto sum_cols(M const& m) {
+    auto ret = details::dyn_result<details::dyn_value_t<M>, 1, details::max_cols_v<M>>(1, m.cols(), m.resource());
+    for (size_t col{0}; col < m.cols(); ++col) {
+        ret(col) = sum(view_col(m, col));
+    }
+    return ret;
+}
+
+/*! Compute determinant
+ * \shortexample det(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix, square
+ * \return  the determinant of m
+ *
+ * m is factorized with partial pivoting, the factorization is allocated from the resource of m.
+ * Integer matrices are factorized in double, the determinant is rounded back.
+ */
+template <_concept::DynMatrix M>
+auto det(M const& m) {
+    assert(m.rows() == m.cols());
+    using T = details::dyn_value_t<M>;
+    using F = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+    auto lu     = details::dyn_convert<F>(m);
+    auto pivots = details::dyn_pivots(m);
+    auto [sign, singular] = details::dyn_lu(lu, {pivots.data(), m.rows()});
+    auto d = singular ? F{0} : sign;
+    for (size_t k{0}; k < lu.rows() and not singular; ++k) {
+        d *= lu(k, k);
+    }
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<T>(d < 0. ? d - 0.5 : d + 0.5);
+    } else {
+        return d;
+    }
+}
+
+/*! Compute inverse
+ * \shortexample inv(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix, square with floating point elements
+ * \return  tuple of determinant and inverse, if the determinant is zero the inverse is invalid
+ *
+ * m is factorized with partial pivoting, the inverse and the factorization are allocated from the resource of m.
+ * The inverse of a BoundedMatrix is a BoundedMatrix and nothing is allocated.
+ */
+template <_concept::DynMatrix M> requires (std::is_floating_point_v<details::dyn_value_t<M>>)
+auto inv(M const& m) {
+    assert(m.rows() == m.cols());
+    using T = details::dyn_value_t<M>;
+    auto lu     = details::dyn_convert<T>(m);
+    auto pivots = details::dyn_pivots(m);
+    auto [sign, singular] = details::dyn_lu(lu, {pivots.data(), m.rows()});
+    if (singular) {
+        return std::tuple{T{0}, details::dyn_convert<T>(m)};
+    }
+    auto d = sign;
+    for (size_t k{0}; k < m.rows(); ++k) {
+        d *= lu(k, k);
+    }
+
+    // solve lu * x = P * I
+    auto ret = details::dyn_result_like<T>(m);
+    view_diag(ret) = T{1};
+    details::dyn_lu_solve(lu, {pivots.data(), m.rows()}, ret);
+    return std::tuple{d, std::move(ret)};
+}
+
+/*! Result of solve() for runtime sized matrices
+ * \shortexample sili::DynSolution<X>
+ * \group Classes
+ *
+ * \param X type of the solution, a DynMatrix or a BoundedMatrix
+ *
+ * x is the solution of ``a * x = b``. singular is true if ``a`` is singular, in this case x is invalid.
+ */
+template <typename X>
+struct DynSolution {
+    X    x;
+    bool singular{false};
+};
+
+/*! Solve a linear system
+ * \shortexample solve(a, b)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param a _concept::DynMatrix, square
+ * \param b _concept::DynMatrix with as many rows as a, a vector or multiple right hand sides
+ * \return  DynSolution with x solving ``a * x = b`` and a singular flag
+ *
+ * a is factorized with partial pivoting, the factorization and x are allocated from the resource of a.
+ * If a and b are BoundedMatrix, nothing is allocated at all.
+ * Integer matrices are solved as double.
+ *
+ * \code
+ *   auto a = sili::BoundedMatrix<4, 4, double>{{{2., 1.},
+ *                                               {1., 3.}}};
+ *   auto [x, singular] = solve(a, sili::BoundedMatrix<4, 1, double>{{3.}, {4.}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <_concept::DynMatrix M, _concept::DynMatrix B>
+auto solve(M const& a, B const& b) {
+    assert(a.rows() == a.cols() and b.rows() == a.rows());
+    using V = details::dyn_value_t<M>;
+    using T = std::conditional_t<std::is_floating_point_v<V>, V, double>;
+    using X = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<details::dyn_value_t<B>>())>;
+    auto lu     = details::dyn_convert<T>(a);
+    auto pivots = details::dyn_pivots(a);
+    auto [sign, singular] = details::dyn_lu(lu, {pivots.data(), a.rows()});
+    auto x = details::dyn_result<X, details::max_rows_v<B>, details::max_cols_v<B>>(b.rows(), b.cols(), a.resource());
+    for (size_t row{0}; row < b.rows(); ++row) {
+        for (size_t col{0}; col < b.cols(); ++col) {
+            x(row, col) = X(b(row, col));
+        }
+    }
+    if (not singular) {
+        details::dyn_lu_solve(lu, {pivots.data(), a.rows()}, x);
+    }
+    return DynSolution<decltype(x)>{std::move(x), singular};
+}
+
+/*! Identity matrix
+ * \shortexample sili::makeI<T>(rows, cols, resource)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param rows     number of rows
+ * \param cols     number of columns (optional, rows if omitted)
+ * \param resource memory resource (optional, the default resource if omitted)
+ * \return         DynMatrix with ones on the diagonal
+ */
+template <typename T>
+auto makeI(size_t rows, size_t cols, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    auto i = DynMatrix<T>{rows, cols, resource};
+    view_diag(i) = T{1};
+    return i;
+}
+template <typename T>
+auto makeI(size_t n, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    return makeI<T>(n, n, resource);
+}
+
+/*! Compute norm
+ * \shortexample norm(v)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param v _concept::DynMatrix, a vector
+ * \return  the norm (also considered as the length).
+ */
+template <_concept::DynMatrix V>
+auto norm(V const& v) {
+    using std::sqrt;
+    return sqrt(dot(v, v));
+}
+
+/*! Compute abs
+ * \shortexample abs(m)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param m _concept::DynMatrix
+ * \return  DynMatrix with the absolute values
+ */
+template <_concept::DynMatrix M>
+auto abs(M const& m) {
+    using std::abs;
+    return details::dyn_apply(m, [](auto e) { return abs(e); });
+}
+
+/*! Dot product of two vectors
+ * \shortexample dot(l, r)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix, a vector
+ * \param r _concept::DynMatrix, a vector of the same length
+ * \return  the dot product of l and r
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto dot(L const& l, R const& r) {
+    assert(details::dyn_length(l) == details::dyn_length(r));
+    using U = std::remove_cvref_t<decltype(std::declval<details::dyn_value_t<L>>() * std::declval<details::dyn_value_t<R>>())>;
+    auto acc = U{};
+    for (size_t i{0}; i < details::dyn_length(l); ++i) {
+        acc += l(i) * r(i);
+    }
+    return acc;
+}
+
+/*! Outer product
+ * \shortexample outerProd(l, r)
+ * \group Free Dynamic Matrix Functions
+ *
+ * \param l _concept::DynMatrix, a vector
+ * \param r _concept::DynMatrix, a vector
+ * \return  DynMatrix with the outer product of l and r
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto outerProd(L const& l, R const& r) {
+    using U = std::remove_cvref_t<decltype(std::declval<details::dyn_value_t<L>>() * std::declval<details::dyn_value_t<R>>())>;
+    constexpr auto maxRows = details::bound_prod(details::max_rows_v<L>, details::max_cols_v<L>);
+    constexpr auto maxCols = details::bound_prod(details::max_rows_v<R>, details::max_cols_v<R>);
+    auto ret = details::dyn_result<U, maxRows, maxCols>(details::dyn_length(l), details::dyn_length(r), l.resource());
+    for (size_t row{0}; row < ret.rows(); ++row) {
+        for (size_t col{0}; col < ret.cols(); ++col) {
+            ret(row, col) = l(row) * r(col);
+        }
+    }
+    return ret;
+}
+
+}
@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace sili {
+
+/*! Result of eig_sym()
+ * \shortexample sili::EigSym<N, T>
+ * \group Classes
+ *
+ * \param N size of the decomposed matrix
+ * \param T type of the elements
+ *
+ * Eigen decomposition ``m = vectors * diag(values) * trans(vectors)`` of a symmetric matrix.
+ * The eigenvalues are sorted in ascending order, column i of vectors is the normalized
+ * eigenvector of ``values(i)``.
+ */
+template <size_t N, typename T>
+struct EigSym {
+    Matrix<N, 1, T> values{};
+    Matrix<N, N, T> vectors{};
+};
+
+namespace details {
+// sorts the eigenvalues in ascending order with a compare and swap network, packs are sorted lane wise
+template <size_t N, typename T>
+constexpr void sortEigSym(EigSym<N, T>& e) {
+    for_constexpr<size_t{0}, N>([&]<size_t i>() {
+        for_constexpr<i + 1, N>([&]<size_t j>() {
+            auto swap = e.values.template at<j, 0>() < e.values.template at<i, 0>();
+            auto vi = e.values.template at<i, 0>();
+            auto vj = e.values.template at<j, 0>();
+            e.values.template at<i, 0>() = select(swap, vj, vi);
+            e.values.template at<j, 0>() = select(swap, vi, vj);
+            for_constexpr<size_t{0}, N>([&]<size_t row>() {
+                auto xi = e.vectors.template at<row, i>();
+                auto xj = e.vectors.template at<row, j>();
+                e.vectors.template at<row, i>() = select(swap, xj, xi);
+                e.vectors.template at<row, j>() = select(swap, xi, xj);
+            });
+        });
+    });
+}
+
+/* Cyclic Jacobi
+ * Each off diagonal element is eliminated by a rotation, sweeps are repeated until the
+ * off diagonal elements are negligible in all lanes. All loops except the sweeps are
+ * unrolled at compile time.
+ */
+template <size_t N, typename T, _concept::Matrix M>
+constexpr auto eig_sym_jacobi(M const& m) -> EigSym<N, T> {
+    using std::abs;
+    using std::sqrt;
+    using S = lane_t<T>;
+    constexpr auto eps = std::numeric_limits<S>::epsilon();
+    constexpr size_t maxSweeps = 64;
+
+    // the lower triangle is mirrored from the upper one
+    auto a = Matrix<N, N, T>{};
+    for_constexpr<size_t{0}, N>([&]<size_t row>() {
+        for_constexpr<row, N>([&]<size_t col>() {
+            a.template at<row, col>() = T(m.template at<row, col>());
+            a.template at<col, row>() = a.template at<row, col>();
+        });
+    });
+    auto ret = EigSym<N, T>{};
+    auto& v  = ret.vectors;
+    for_constexpr<size_t{0}, N>([&]<size_t k>() {
+        v.template at<k, k>() = T{1};
+    });
+
+    for (size_t sweep{0}; sweep < maxSweeps; ++sweep) {
+        auto off  = T{0};
+        auto diag = T{0};
+        for_constexpr<size_t{0}, N>([&]<size_t p>() {
+            diag = diag + a.template at<p, p>() * a.template at<p, p>();
+            for_constexpr<p + 1, N>([&]<size_t q>() {
+                off = off + a.template at<p, q>() * a.template at<p, q>();
+            });
+        });
+        if (all_of(off <= T{eps * eps} * diag)) {
+            break;
+        }
+
+        for_constexpr<size_t{0}, N>([&]<size_t p>() {
+            for_constexpr<p + 1, N>([&]<size_t q>() {
+                auto apq = a.template at<p, q>();
+                auto app = a.template at<p, p>();
+                auto aqq = a.template at<q, q>();
+                // already negligible, continue with the identity rotation
+                auto skip  = abs(apq) <= T{eps} * sqrt(abs(app * aqq));
+                auto theta = (aqq - app) / (T{2} * select(skip, T{1}, apq));
+                auto t     = select(theta < T{0}, T{-1}, T{1}) / (abs(theta) + sqrt(theta * theta + T{1}));
+                auto c     = select(skip, T{1}, T{1} / sqrt(t * t + T{1}));
+                auto s     = select(skip, T{0}, t * c);
+
+                // a = Jᵀ * a * J
+                for_constexpr<size_t{0}, N>([&]<size_t k>() {
+                    auto x = a.template at<k, p>();
+                    auto y = a.template at<k, q>();
+                    a.template at<k, p>() = c * x - s * y;
+                    a.template at<k, q>() = s * x + c * y;
+                });
+                for_constexpr<size_t{0}, N>([&]<size_t k>() {
+                    auto x = a.template at<p, k>();
+                    auto y = a.template at<q, k>();
+                    a.template at<p, k>() = c * x - s * y;
+                    a.template at<q, k>() = s * x + c * y;
+                });
+                for_constexpr<size_t{0}, N>([&]<size_t k>() {
+                    auto x = v.template at<k, p>();
+                    auto y = v.template at<k, q>();
+                    v.template at<k, p>() = c * x - s * y;
+                    v.template at<k, q>() = s * x + c * y;
+                });
+            });
+        });
+    }
+    for_constexpr<size_t{0}, N>([&]<size_t k>() {
+        ret.values.template at<k, 0>() = a.template at<k, k>();
+    });
+    sortEigSym(ret);
+    return ret;
+}
+
+template <typename T>
+constexpr auto cross3(std::array<T, 3> const& a, std::array<T, 3> const& b) -> std::array<T, 3> {
+    return {a[1] * b[2] - a[2] * b[1],
+            a[2] * b[0] - a[0] * b[2],
+            a[0] * b[1] - a[1] * b[0]};
+}
+
+template <typename T>
+constexpr auto dot3(std::array<T, 3> const& a, std::array<T, 3> const& b) -> T {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/* Analytic solution for 3x3 matrices
+ * The eigenvalues are the roots of the characteristic polynomial, computed with the
+ * trigonometric solution. The eigenvector of the eigenvalue that is best separated from
+ * the others is the largest cross product of two rows of ``m - λ * I``, the second
+ * eigenvector is computed in its orthogonal complement and the third is their cross product.
+ * This stays accurate for repeated eigenvalues (D. Eberly, "A Robust Eigensolver for
+ * 3 × 3 Symmetric Matrices"). Diagonal matrices are handled separately.
+ * All steps are branch free, so packs can take different paths in each lane.
+ */
+template <typename T, _concept::Matrix M>
+constexpr auto eig_sym_3x3(M const& m) -> EigSym<3, T> {
+    using std::abs;
+    using std::acos;
+    using std::cos;
+    using std::max;
+    using std::min;
+    using std::sqrt;
+    using S = lane_t<T>;
+    constexpr auto eps = std::numeric_limits<S>::epsilon();
+
+    auto a00 = T(m.template at<0, 0>());
+    auto a01 = T(m.template at<0, 1>());
+    auto a02 = T(m.template at<0, 2>());
+    auto a11 = T(m.template at<1, 1>());
+    auto a12 = T(m.template at<1, 2>());
+    auto a22 = T(m.template at<2, 2>());
+
+    // scale the matrix to avoid over- and underflow
+    auto scale = max(max(max(abs(a00), abs(a01)), max(abs(a02), abs(a11))), max(abs(a12), abs(a22)));
+    auto invScale = T{1} / select(scale <= T{0}, T{1}, scale);
+    a00 = a00 * invScale;
+    a01 = a01 * invScale;
+    a02 = a02 * invScale;
+    a11 = a11 * invScale;
+    a12 = a12 * invScale;
+    a22 = a22 * invScale;
+
+    auto p1 = a01 * a01 + a02 * a02 + a12 * a12;
+    auto q  = (a00 + a11 + a22) / T{3};
+    auto b00 = a00 - q;
+    auto b11 = a11 - q;
+    auto b22 = a22 - q;
+    auto p2  = b00 * b00 + b11 * b11 + b22 * b22 + T{2} * p1;
+
+    // (numerically) diagonal, this includes all matrices with a triple eigenvalue
+    auto diagonal = p1 <= T{eps * eps} * p2 or p2 <= T{0};
+    if constexpr (not is_pack_v<T>) {
+        if (diagonal) {
+            auto ret = EigSym<3, T>{};
+            ret.values  = Matrix<3, 1, T>{{{a00 * scale}, {a11 * scale}, {a22 * scale}}};
+            ret.vectors = Matrix<3, 3, T>{{{T{1}, T{0}, T{0}}, {T{0}, T{1}, T{0}}, {T{0}, T{0}, T{1}}}};
+            sortEigSym(ret);
+            return ret;
+        }
+    }
+    p2 = select(diagonal, T{6}, p2);
+
+    // eigenvalues l0 <= l1 <= l2 with the trigonometric solution
+    auto p    = sqrt(p2 / T{6});
+    auto invP = T{1} / p;
+    auto c00  = b00 * invP;
+    auto c11  = b11 * invP;
+    auto c22  = b22 * invP;
+    auto c01  = a01 * invP;
+    auto c02  = a02 * invP;
+    auto c12  = a12 * invP;
+    auto r    = (c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) + c02 * (c01 * c12 - c11 * c02)) / T{2};
+    r = min(max(r, T{-1}), T{1});
+    auto phi = acos(r) / T{3};
+    auto l2  = q + T{2} * p * cos(phi);
+    auto l0  = q + T{2} * p * cos(phi + T{S{2} * std::numbers::pi_v<S> / S{3}});
+    auto l1  = T{3} * q - l0 - l2;
+
+    // eigenvector of the eigenvalue that is best separated from the others
+    auto maxFirst = (l1 - l0) <= (l2 - l1);
+    auto la  = select(maxFirst, l2, l0);
+    auto r0  = std::array<T, 3>{a00 - la, a01, a02};
+    auto r1  = std::array<T, 3>{a01, a11 - la, a12};
+    auto r2  = std::array<T, 3>{a02, a12, a22 - la};
+    auto x01 = cross3(r0, r1);
+    auto x02 = cross3(r0, r2);
+    auto x12 = cross3(r1, r2);
+    auto d01 = dot3(x01, x01);
+    auto d02 = dot3(x02, x02);
+    auto d12 = dot3(x12, x12);
+    auto use02 = d01 < d02 and d12 <= d02;
+    auto use12 = d01 < d12 and d02 < d12;
+    auto dMax  = select(use12, d12, select(use02, d02, d01));
+    auto invD  = T{1} / sqrt(select(dMax <= T{0}, T{1}, dMax));
+    auto va = std::array<T, 3>{};
+    for (size_t i{0}; i < 3; ++i) {
+        va[i] = select(use12, x12[i], select(use02, x02[i], x01[i])) * invD;
+    }
+
+    // orthonormal basis u, w of the orthogonal complement of va
+    auto x0Larger = abs(va[1]) < abs(va[0]);
+    auto n02   = va[0] * va[0] + va[2] * va[2];
+    auto n12   = va[1] * va[1] + va[2] * va[2];
+    auto invN  = T{1} / sqrt(select(x0Larger, n02, n12) + select(dMax <= T{0}, T{1}, T{0}));
+    auto u = std::array<T, 3>{select(x0Larger, -va[2] * invN, T{0}),
+                              select(x0Larger, T{0}, va[2] * invN),
+                              select(x0Larger, va[0] * invN, -va[1] * invN)};
+    auto w = cross3(va, u);
+
+    // eigenvector of l1 in the plane spanned by u and w
+    auto au = std::array<T, 3>{a00 * u[0] + a01 * u[1] + a02 * u[2],
+                               a01 * u[0] + a11 * u[1] + a12 * u[2],
+                               a02 * u[0] + a12 * u[1] + a22 * u[2]};
+    auto aw = std::array<T, 3>{a00 * w[0] + a01 * w[1] + a02 * w[2],
+                               a01 * w[0] + a11 * w[1] + a12 * w[2],
+                               a02 * w[0] + a12 * w[1] + a22 * w[2]};
+    auto m00 = dot3(u, au) - l1;
+    auto m01 = dot3(u, aw);
+    auto m11 = dot3(w, aw) - l1;
+    auto first = abs(m11) <= abs(m00);
+    auto x = select(first, m01, m11);
+    auto y = select(first, m00, m01);
+    auto n = x * x + y * y;
+    // every vector of the plane is an eigenvector
+    auto plane = n <= T{0};
+    auto invXY = T{1} / sqrt(select(plane, T{1}, n));
+    x = select(plane, T{1}, x * invXY);
+    y = select(plane, T{0}, y * invXY);
+    auto vb = std::array<T, 3>{};
+    for (size_t i{0}; i < 3; ++i) {
+        vb[i] = x * u[i] - y * w[i];
+    }
+    auto vc = cross3(va, vb);
+
+    auto ret = EigSym<3, T>{};
+    ret.values = Matrix<3, 1, T>{{{select(diagonal, a00, l0) * scale},
+                                  {select(diagonal, a11, l1) * scale},
+                                  {select(diagonal, a22, l2) * scale}}};
+    for (size_t i{0}; i < 3; ++i) {
+        auto e = T(i == 0 ? 1 : 0);
+        auto f = T(i == 1 ? 1 : 0);
+        auto g = T(i == 2 ? 1 : 0);
+        ret.vectors(i, 0) = select(diagonal, e, select(maxFirst, vc[i], va[i]));
+        ret.vectors(i, 1) = select(diagonal, f, vb[i]);
+        ret.vectors(i, 2) = select(diagonal, g, select(maxFirst, va[i], vc[i]));
+    }
+    sortEigSym(ret);
+    return ret;
+}
+}
+
+/*! Eigen decomposition of a symmetric matrix
+ * \shortexample eig_sym(m)
+ * \group Free Matrix Functions
+ *
+ * \param m _concept::Matrix, symmetric. Only the upper triangle is read.
+ * \return  EigSym with the eigenvalues in ascending order and the eigenvectors as columns
+ *
+ * 3x3 matrices are solved analytically, other sizes with cyclic Jacobi rotations.
+ * For a MatrixBatch (elements of type Pack) every lane is decomposed on its own.
+ * Integer matrices are decomposed as double.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{2., 1.},
+ *                          {1., 2.}}};
+ *   auto [values, vectors] = eig_sym(a);
+ *   std::cout << values << "\n"; // prints {{1.}, {3.}}
+ * \endcode
+ */
+template <_concept::Matrix M> requires (rows_v<M> == cols_v<M>)
+constexpr auto eig_sym(M const& m) {
+    using V = std::remove_cvref_t<value_t<M>>;
+    using T = std::conditional_t<std::is_floating_point_v<lane_t<V>>, V, double>;
+    constexpr auto N = rows_v<M>;
+    if constexpr (N == 3) {
+        return details::eig_sym_3x3<T>(m);
+    } else {
+        return details::eig_sym_jacobi<N, T>(m);
+    }
+}
+
+}
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+#include "Triangular.h"
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+namespace sili {
+
+/*! LU factorization with partial pivoting
+ * \shortexample sili::LU{m}
+ * \group Classes
+ *
+ * \param N size of the factorized matrix
+ * \param T type of the elements
+ *
+ * Factorizes a square matrix as ``P * m = L * U``. L is unit lower triangular,
+ * U is upper triangular, both are stored in place in a single matrix.
+ * The rows are swapped so that the pivot has the largest absolute value of its column.
+ * Once factorized, det(), solve() and inverse() reuse the factorization, so many
+ * right hand sides can be solved without factorizing again.
+ *
+ * If ``m`` is singular, det() is zero and the results of solve() and inverse() are invalid.
+ * For a MatrixBatch (T is a Pack) each lane is pivoted on its own and singular() is a mask.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{2., 1., 1.},
+ *                          {4., 3., 3.},
+ *                          {8., 7., 9.}}};
+ *   auto lu = sili::LU{a};
+ *   std::cout << lu.det() << "\n"; // prints 4
+ *
+ *   auto b = sili::Matrix{{{ 4.}, {10.}, {24.}}};
+ *   auto x = lu.solve(b);
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}, {1.}}
+ * \endcode
+ */
+template <size_t N, typename T>
+class LU {
+    using mask_t = std::remove_cvref_t<decltype(std::declval<T>() < std::declval<T>())>;
+
+    // row swaps of the factorization:
+    // scalars store the pivot row of each column,
+    // packs store for each column k and row r the lanes in which r was swapped with k
+    using pivots_t = std::conditional_t<is_pack_v<T>, std::array<std::array<mask_t, N>, N>, std::array<size_t, N>>;
+
+    Matrix<N, N, T> lu{};
+    pivots_t        pivots{};
+    T               sign{1};
+    mask_t          isSingular{false};
+
+    template <typename M>
+    static constexpr void swap_rows(M& m, size_t k, size_t r, mask_t const& mask) {
+        for (size_t col{0}; col < cols_v<M>; ++col) {
+            auto tmp = m(k, col);
+            m(k, col) = select(mask, m(r, col), tmp);
+            m(r, col) = select(mask, tmp, m(r, col));
+        }
+    }
+
+    // applies the row swaps of the factorization to m
+    template <typename M>
+    constexpr void permute(M& m) const {
+        for (size_t k{0}; k < N; ++k) {
+            if constexpr (is_pack_v<T>) {
+                for (size_t r{k + 1}; r < N; ++r) {
+                    swap_rows(m, k, r, pivots[k][r]);
+                }
+            } else if (pivots[k] != k) {
+                for (size_t col{0}; col < cols_v<M>; ++col) {
+                    auto tmp = m(k, col);
+                    m(k, col) = m(pivots[k], col);
+                    m(pivots[k], col) = tmp;
+                }
+            }
+        }
+    }
+
+public:
+    using value_t = T;
+
+    template <_concept::Matrix M> requires (rows_v<M> == N and cols_v<M> == N)
+    constexpr explicit LU(M const& m)
+        : lu{m}
+    {
+        using std::abs;
+        for (size_t k{0}; k < N; ++k) {
+            // partial pivoting, move the row with the largest absolute value into row k
+            if constexpr (is_pack_v<T>) {
+                // each lane may have a different pivot row, rows are swapped whenever a larger one is found
+                for (size_t r{k + 1}; r < N; ++r) {
+                    auto larger = abs(lu(k, k)) < abs(lu(r, k));
+                    pivots[k][r] = larger;
+                    swap_rows(lu, k, r, larger);
+                    sign = select(larger, -sign, sign);
+                }
+            } else {
+                auto p = k;
+                for (size_t r{k + 1}; r < N; ++r) {
+                    if (abs(lu(p, k)) < abs(lu(r, k))) {
+                        p = r;
+                    }
+                }
+                pivots[k] = p;
+                if (p != k) {
+                    swap_rows(lu, k, p, true);
+                    sign = -sign;
+                }
+            }
+
+            // a zero pivot means the column below is zero as well, there is nothing to eliminate
+            auto zero = abs(lu(k, k)) <= T{0};
+            isSingular = isSingular || zero;
+            auto invPivot = T{1} / select(zero, T{1}, lu(k, k));
+            for (size_t r{k + 1}; r < N; ++r) {
+                lu(r, k) = lu(r, k) * invPivot;
+                for (size_t c{k + 1}; c < N; ++c) {
+                    lu(r, c) = lu(r, c) - lu(r, k) * lu(k, c);
+                }
+            }
+        }
+    }
+
+    // true (or a mask for packs) if the matrix is singular
+    constexpr auto singular() const -> mask_t {
+        return isSingular;
+    }
+
+    // determinant of the factorized matrix
+    constexpr auto det() const -> T {
+        auto d = sign;
+        for (size_t k{0}; k < N; ++k) {
+            d = d * lu(k, k);
+        }
+        return d;
+    }
+
+    // solves ``m * x = b`` for x, b can be a vector or a matrix with multiple right hand sides
+    template <_concept::Matrix B> requires (rows_v<B> == N)
+    constexpr auto solve(B const& b) const {
+        using R = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<sili::value_t<B>>())>;
+        constexpr auto C = cols_v<B>;
+        auto x = Matrix<N, C, R>{b};
+        permute(x);
+        // forward substitution with the unit lower triangular L, back substitution with U
+        trsm_into(x, view_lower_tri<tri::Unit>(lu));
+        trsm_into(x, view_upper_tri(lu));
+        return x;
+    }
+
+    // inverse of the factorized matrix
+    constexpr auto inverse() const -> Matrix<N, N, T> {
+        auto id = Matrix<N, N, T>{};
+        for (size_t k{0}; k < N; ++k) {
+            id(k, k) = T{1};
+        }
+        return solve(id);
+    }
+
+    // unit lower triangular matrix L
+    constexpr auto L() const -> Matrix<N, N, T> {
+        auto l = Matrix<N, N, T>{};
+        for (size_t row{0}; row < N; ++row) {
+            for (size_t col{0}; col < row; ++col) {
+                l(row, col) = lu(row, col);
+            }
+            l(row, row) = T{1};
+        }
+        return l;
+    }
+
+    // upper triangular matrix U
+    constexpr auto U() const -> Matrix<N, N, T> {
+        auto u = Matrix<N, N, T>{};
+        for (size_t row{0}; row < N; ++row) {
+            for (size_t col{row}; col < N; ++col) {
+                u(row, col) = lu(row, col);
+            }
+        }
+        return u;
+    }
+
+    // permutation matrix P with ``P * m = L * U``
+    constexpr auto P() const -> Matrix<N, N, T> {
+        auto p = Matrix<N, N, T>{};
+        for (size_t k{0}; k < N; ++k) {
+            p(k, k) = T{1};
+        }
+        permute(p);
+        return p;
+    }
+};
+
+template <_concept::Matrix M> requires (rows_v<M> == cols_v<M>)
+LU(M const&) -> LU<rows_v<M>, std::remove_cvref_t<value_t<M>>>;
+
+}
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "concepts.h"
+#include "storage.h"
 
+#include <algorithm>
 #include <array>
 
 namespace sili {
@@ -19,41 +21,85 @@ namespace sili {
  * \param _rows number of rows of the matrix, must be larger or equal to zero
  * \param _cols number of columns of the matrix, must be larger or equal to zero
  * \param T     type of the elements
+ * \param Storage optional storage policy, e.g. Aligned<> (see AlignedMatrix) or Affine (see Affine3)
  *
  * \caption Methods
  * \param data() returns pointer to the underlying data structure
  * \param m(row,col) access element at ``row`` and ``col``
  */
-template<size_t _rows, size_t _cols, typename T> requires (_rows >= 0 and _cols >= 0)
-class Matrix<_rows, _cols, T> {
-    std::array<T, _cols*_rows> vals;
+template<size_t _rows, size_t _cols, typename T, typename... Storage> requires (_rows >= 0 and _cols >= 0 and sizeof...(Storage) <= 1)
+class Matrix<_rows, _cols, T, Storage...> {
+    using Layout = details::storage_layout<_cols, T, Storage...>;
+
+    alignas(Layout::alignment) std::array<T, Layout::stride*_rows> vals;
+
+    // homogeneous layouts (see Affine) keep their last row at [0 … 0 1]
+    constexpr void set_homogeneous_row() {
+        if constexpr (details::homogeneous_layout_v<Layout>) {
+            for (size_t col{0}; col < _cols; ++col) {
+                vals[(_rows - 1) * Layout::stride + col] = T(col + 1 == _cols ? 1 : 0);
+            }
+        }
+    }
 
 public:
     using value_t = T;
 
     static constexpr size_t  Rows       = _rows;
     static constexpr size_t  Cols       = _cols;
-    static constexpr size_t  Stride     = _cols;
+    static constexpr size_t  Stride     = Layout::stride;
     static constexpr bool Transposed = false;
 
-    constexpr Matrix() : vals{} {}
+    // homogeneous layouts start as identity
+    constexpr Matrix() : vals{} {
+        if constexpr (details::homogeneous_layout_v<Layout>) {
+            for (size_t k{0}; k < std::min(_rows, _cols); ++k) {
+                vals[k * Layout::stride + k] = T(1);
+            }
+        }
+    }
 
     template <typename ...S>
-    constexpr Matrix(S... _values)
+    constexpr Matrix(S... _values) requires (Stride == Cols)
         : vals{std::forward<S>(_values)...}
-    {}
+    {
+        set_homogeneous_row();
+    }
 
-    constexpr Matrix(T const (&values)[Rows][Cols]) {
+    // padded rows, values are given row by row without padding
+    template <typename ...S>
+    constexpr Matrix(S... _values) requires (Stride != Cols and sizeof...(S) <= Rows * Cols)
+        : vals{}
+    {
+        T const values[] = {std::forward<S>(_values)...};
+        for (size_t i{0}; i < sizeof...(S); ++i) {
+            vals[(i / Cols) * Stride + i % Cols] = values[i];
+        }
+        set_homogeneous_row();
+    }
+
+    constexpr Matrix(T const (&values)[Rows][Cols])
+        : vals{}
+    {
         for (size_t row{0}; row < Rows; ++row) {
             for (size_t col{0}; col < Cols; ++col) {
                 this->operator()(row, col) = values[row][col];
             }
         }
+        set_homogeneous_row();
     }
     template <_concept::Matrix V>
-    constexpr Matrix(V const& view) requires (V::Rows == Rows and V::Cols == Cols) {
+    constexpr Matrix(V const& view) requires (V::Rows == Rows and V::Cols == Cols)
+        : vals{}
+    {
         *this = view;
     }
+    template <_concept::Expression E>
+    constexpr Matrix(E const& expr) requires (E::Rows == Rows and E::Cols == Cols)
+        : vals{}
+    {
+        *this = expr;
+    }
 
     constexpr auto data() -> T* {
         return vals.data();
@@ -112,24 +158,36 @@ public:
 
 
     constexpr auto view() {
-        return View<_rows, _cols, _cols, T, false>{data()};
+        return View<_rows, _cols, Stride, T, false>{data()};
     }
     constexpr auto view() const {
-        return View<_rows, _cols, _cols, T const, false>{data()};
+        return View<_rows, _cols, Stride, T const, false>{data()};
     }
 
     constexpr auto operator=(T const& s) -> Matrix& {
-        for_each_constexpr<Matrix>([&]<size_t row, size_t col>() constexpr {
-            at<row, col>() = s;
+        for_each_index<Matrix>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = s;
         });
+        set_homogeneous_row();
         return *this;
     }
 
     template <_concept::Matrix V>
     constexpr auto operator=(V const& v) -> Matrix& requires (Rows == V::Rows and Cols == V::Cols) {
-        for_each_constexpr<Matrix>([&]<size_t row, size_t col>() constexpr {
-            at<row, col>() = v.template at<row, col>();
+        for_each_index<Matrix>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = v(row, col);
+        });
+        set_homogeneous_row();
+        return *this;
+    }
+
+    // evaluates all elements of the expression in a single pass
+    template <_concept::Expression E>
+    constexpr auto operator=(E const& e) -> Matrix& requires (Rows == E::Rows and Cols == E::Cols) {
+        for_each_index<Matrix>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = e(row, col);
         });
+        set_homogeneous_row();
         return *this;
     }
 };
@@ -140,7 +198,30 @@ Matrix(T const (&)[rows][cols]) -> Matrix<rows, cols, T>;
 template <size_t rows, size_t cols, size_t stride, typename T, bool _transposed>
 Matrix(View<rows, cols, stride, T, _transposed> const&) -> Matrix<rows, cols, std::remove_const_t<T>>;
 
+template <_concept::Expression E>
+Matrix(E const&) -> Matrix<E::Rows, E::Cols, typename E::value_t>;
+
 template<size_t rows, typename T>
 using Vector = Matrix<rows, 1, T>;
 
+/*! Matrix with aligned and padded storage
+ * \shortexample sili::AlignedMatrix<3, 3, float>
+ * \group Classes
+ *
+ * Matrix whose storage is aligned to ``Alignment`` bytes and whose rows are
+ * padded to a multiple of ``Alignment`` bytes, Stride is larger than Cols if needed.
+ * Every row can be processed with full width aligned vector loads.
+ * It fulfills the _concept::Matrix concept and can be used like any other Matrix.
+ *
+ * \code
+ *   auto m = sili::AlignedMatrix<3, 3, float, 16>{1.f, 2.f, 3.f,
+ *                                                 4.f, 5.f, 6.f,
+ *                                                 7.f, 8.f, 9.f};
+ *   std::cout << m.Stride << "\n"; // prints 4
+ *   std::cout << m(1, 0) << "\n";  // prints 4
+ * \endcode
+ */
+template<size_t rows, size_t cols, typename T, size_t Alignment = details::simd_register_bytes>
+using AlignedMatrix = Matrix<rows, cols, T, Aligned<Alignment>>;
+
 }
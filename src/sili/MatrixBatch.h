@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+#include "operations.h"
+
+namespace sili {
+
+/*! Batch of matrices in structure of arrays layout
+ * \shortexample sili::MatrixBatch<3, 3, float>
+ * \group Classes
+ *
+ * \param R     number of rows of each matrix
+ * \param C     number of columns of each matrix
+ * \param T     type of the elements
+ * \param Lanes number of matrices, defaults to the number of T fitting into one vector register
+ *
+ * A Matrix whose elements are Pack<T, Lanes>: element (row, col) of all ``Lanes``
+ * matrices is stored contiguously, so each operation processes all matrices at once.
+ * It fulfills the _concept::Matrix concept and supports the same operations as
+ * a Matrix, e.g. ``+``, ``-``, ``*``, det(), inv(), trans(), norm(), dot() and cross().
+ * Scalars and matrices with elements of type T are broadcast to all lanes.
+ *
+ * \code
+ *   auto a = sili::MatrixBatch<2, 2, double, 4>{};
+ *   for (size_t i{0}; i < 4; ++i) {
+ *       set_lane(a, i, sili::Matrix{{{1., double(i)},
+ *                                    {0., 2.}}});
+ *   }
+ *   auto d = det(a * a);
+ *   std::cout << d[3] << "\n"; // prints 4
+ * \endcode
+ */
+template <size_t R, size_t C, typename T, size_t Lanes = details::simd_lanes<T>>
+using MatrixBatch = Matrix<R, C, Pack<T, Lanes>>;
+
+/*! Single matrix of a batch
+ * \shortexample lane(b, i)
+ * \group Free Matrix Functions
+ *
+ * \param b _concept::Matrix with Pack elements (e.g. MatrixBatch)
+ * \param i index of the lane
+ * \return  Matrix with the elements of lane i
+ */
+template <_concept::Matrix B> requires (is_pack_v<value_t<B>>)
+constexpr auto lane(B const& b, size_t i) {
+    using T = typename std::remove_cvref_t<value_t<B>>::value_t;
+    auto ret = Matrix<rows_v<B>, cols_v<B>, T>{};
+    for_each_index<B>([&](size_t row, size_t col) {
+        ret(row, col) = b(row, col)[i];
+    });
+    return ret;
+}
+
+/*! Overwrite a single matrix of a batch
+ * \shortexample set_lane(b, i, m)
+ * \group Free Matrix Functions
+ *
+ * \param b _concept::Matrix with Pack elements (e.g. MatrixBatch)
+ * \param i index of the lane
+ * \param m _concept::Matrix with the same dimensions as b
+ */
+template <_concept::Matrix B, _concept::Matrix M> requires (is_pack_v<value_t<B>> and rows_v<B> == rows_v<M> and cols_v<B> == cols_v<M>)
+constexpr void set_lane(B&& b, size_t i, M const& m) {
+    for_each_index<M>([&](size_t row, size_t col) {
+        b(row, col)[i] = m(row, col);
+    });
+}
+
+/*! Load a batch from an array of matrices
+ * \shortexample sili::load_batch<Lanes>(ptr)
+ * \group Free Matrix Functions
+ *
+ * \param Lanes number of matrices to load
+ * \param ptr   pointer to ``Lanes`` consecutive matrices
+ * \return      MatrixBatch with matrix ``ptr[i]`` in lane i
+ *
+ * \code
+ *   auto ms = std::vector<sili::Matrix<3, 3, float>>(1024);
+ *   for (size_t i{0}; i < ms.size(); i += 8) {
+ *       auto b = sili::load_batch<8>(&ms[i]);
+ *       store_batch(trans(b), &ms[i]);
+ *   }
+ * \endcode
+ */
+template <size_t Lanes, _concept::Matrix M>
+constexpr auto load_batch(M const* ptr) {
+    auto ret = MatrixBatch<rows_v<M>, cols_v<M>, std::remove_cvref_t<value_t<M>>, Lanes>{};
+    for (size_t i{0}; i < Lanes; ++i) {
+        set_lane(ret, i, ptr[i]);
+    }
+    return ret;
+}
+
+/*! Store a batch into an array of matrices
+ * \shortexample store_batch(b, ptr)
+ * \group Free Matrix Functions
+ *
+ * \param b   _concept::Matrix with Pack elements (e.g. MatrixBatch)
+ * \param ptr pointer to as many consecutive matrices as b has lanes
+ */
+template <_concept::Matrix B, _concept::Matrix M> requires (is_pack_v<value_t<B>> and rows_v<B> == rows_v<M> and cols_v<B> == cols_v<M>)
+constexpr void store_batch(B const& b, M* ptr) {
+    for (size_t i{0}; i < std::remove_cvref_t<value_t<B>>::Lanes; ++i) {
+        ptr[i] = lane(b, i);
+    }
+}
+
+}
@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "gemm.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace sili {
+
+template <typename T, size_t N>
+class Pack;
+
+namespace details {
+// alignment of a pack, full vector registers are aligned to their width
+template <typename T, size_t N>
+constexpr size_t pack_alignment = [] {
+    auto bytes = sizeof(T) * N;
+    if ((bytes & (bytes - 1)) != 0) {
+        return alignof(T);
+    }
+    return std::max(alignof(T), std::min(bytes, simd_register_bytes));
+}();
+
+template <typename T>
+struct is_pack : std::false_type {};
+template <typename T, size_t N>
+struct is_pack<Pack<T, N>> : std::true_type {};
+
+template <typename T>
+struct lane_type { using type = T; };
+template <typename T, size_t N>
+struct lane_type<Pack<T, N>> { using type = T; };
+}
+
+template <typename T>
+constexpr bool is_pack_v = details::is_pack<std::remove_cvref_t<T>>::value;
+
+// type of a single lane, T itself if T is not a pack
+template <typename T>
+using lane_t = typename details::lane_type<std::remove_cvref_t<T>>::type;
+
+/*! SIMD lane bundle
+ * \shortexample sili::Pack<float, 8>
+ * \group Classes
+ *
+ * \param T type of each lane
+ * \param N number of lanes
+ *
+ * Holds ``N`` independent values of type ``T``, every operation is applied to
+ * all lanes at once. The lane loops have a compile time trip count and are
+ * vectorized by the compiler.
+ * A Pack can be used as element type of a Matrix (see MatrixBatch), which stores
+ * ``N`` matrices as structure of arrays.
+ *
+ * Arithmetic operations work lane by lane, scalars are broadcast to all lanes.
+ * ``==`` and ``!=`` compare all lanes and return a single bool, the ordering
+ * comparisons ``<``, ``<=``, ``>`` and ``>=`` return a mask (``Pack<bool, N>``),
+ * which can be used with select(), any_of() and all_of().
+ *
+ * \code
+ *   auto p = sili::Pack<double, 4>{1., 2., 3., 4.};
+ *   auto q = p * 2. + 1.;
+ *   std::cout << q[2] << "\n"; // prints 7
+ *   auto r = select(p < 2.5, p, -p);
+ *   std::cout << r[3] << "\n"; // prints -4
+ * \endcode
+ */
+template <typename T, size_t N>
+class Pack {
+    static_assert(N > 0, "a pack needs at least one lane");
+
+    alignas(details::pack_alignment<T, N>) std::array<T, N> lanes;
+
+    // lane loops are unrolled at compile time, so packs can stay in registers
+    template <typename Op>
+    static constexpr auto map(Op op, Pack const& a) {
+        auto r = Pack<std::remove_cvref_t<decltype(op(a[0]))>, N>{};
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            r[i] = op(a[i]);
+        });
+        return r;
+    }
+    template <typename Op>
+    static constexpr auto map(Op op, Pack const& a, Pack const& b) {
+        auto r = Pack<std::remove_cvref_t<decltype(op(a[0], b[0]))>, N>{};
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            r[i] = op(a[i], b[i]);
+        });
+        return r;
+    }
+
+    // arithmetic of two packs, full vector registers are processed with vector extensions
+    template <typename Op>
+    static constexpr auto zip(Op op, Pack const& a, Pack const& b) -> Pack {
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+        constexpr auto L = details::simd_lanes<T>;
+        if constexpr (details::has_simd_register_v<T> and N % L == 0) {
+            if (not std::is_constant_evaluated()) {
+                constexpr auto B = details::simd_register_bytes;
+                auto r = Pack{};
+                for_constexpr<size_t{0}, N / L>([&]<size_t i>() {
+                    details::simd_store<T, B>(r.data() + i * L, op(details::simd_load<T, B>(a.data() + i * L),
+                                                                   details::simd_load<T, B>(b.data() + i * L)));
+                });
+                return r;
+            }
+        }
+#endif
+        return map([&](T x, T y) { return T(op(x, y)); }, a, b);
+    }
+
+public:
+    using value_t = T;
+    using mask_t  = Pack<bool, N>;
+
+    static constexpr size_t Lanes = N;
+
+    constexpr Pack() : lanes{} {}
+
+    // broadcast s to all lanes
+    constexpr Pack(T const& s) : lanes{} {
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            lanes[i] = s;
+        });
+    }
+
+    // one value per lane
+    template <typename ...S>
+    constexpr Pack(S const&... s) requires (sizeof...(S) == N and N > 1 and (std::is_convertible_v<S, T> and ...))
+        : lanes{static_cast<T>(s)...}
+    {}
+
+    constexpr auto operator[](size_t i) -> T& {
+        return lanes[i];
+    }
+    constexpr auto operator[](size_t i) const -> T const& {
+        return lanes[i];
+    }
+
+    constexpr auto data() -> T* {
+        return lanes.data();
+    }
+    constexpr auto data() const -> T const* {
+        return lanes.data();
+    }
+
+    friend constexpr auto operator+(Pack const& a) -> Pack { return a; }
+    friend constexpr auto operator-(Pack const& a) -> Pack { return map([](T x) { return T(-x); }, a); }
+
+    friend constexpr auto operator+(Pack const& a, Pack const& b) -> Pack { return zip([](auto x, auto y) { return x + y; }, a, b); }
+    friend constexpr auto operator-(Pack const& a, Pack const& b) -> Pack { return zip([](auto x, auto y) { return x - y; }, a, b); }
+    friend constexpr auto operator*(Pack const& a, Pack const& b) -> Pack { return zip([](auto x, auto y) { return x * y; }, a, b); }
+    friend constexpr auto operator/(Pack const& a, Pack const& b) -> Pack { return zip([](auto x, auto y) { return x / y; }, a, b); }
+
+    friend constexpr auto operator+=(Pack& a, Pack const& b) -> Pack& { return a = a + b; }
+    friend constexpr auto operator-=(Pack& a, Pack const& b) -> Pack& { return a = a - b; }
+    friend constexpr auto operator*=(Pack& a, Pack const& b) -> Pack& { return a = a * b; }
+    friend constexpr auto operator/=(Pack& a, Pack const& b) -> Pack& { return a = a / b; }
+
+    // equality of all lanes
+    friend constexpr auto operator==(Pack const& a, Pack const& b) -> bool {
+        for (size_t i{0}; i < N; ++i) {
+            if (not (a[i] == b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // lane wise comparisons
+    friend constexpr auto operator<(Pack const& a, Pack const& b) -> mask_t  { return map([](T x, T y) { return x < y; }, a, b); }
+    friend constexpr auto operator<=(Pack const& a, Pack const& b) -> mask_t { return map([](T x, T y) { return x <= y; }, a, b); }
+    friend constexpr auto operator>(Pack const& a, Pack const& b) -> mask_t  { return map([](T x, T y) { return x > y; }, a, b); }
+    friend constexpr auto operator>=(Pack const& a, Pack const& b) -> mask_t { return map([](T x, T y) { return x >= y; }, a, b); }
+
+    // lane wise logic, used on masks
+    friend constexpr auto operator!(Pack const& a) -> mask_t { return map([](T x) { return not x; }, a); }
+    friend constexpr auto operator&&(Pack const& a, Pack const& b) -> mask_t { return map([](T x, T y) { return x and y; }, a, b); }
+    friend constexpr auto operator||(Pack const& a, Pack const& b) -> mask_t { return map([](T x, T y) { return x or y; }, a, b); }
+
+    // lane wise math functions, found by argument dependent lookup
+    friend constexpr auto abs(Pack const& a) -> Pack {
+        return map([](T x) { using std::abs; return T(abs(x)); }, a);
+    }
+    friend constexpr auto sqrt(Pack const& a) -> Pack {
+        return map([](T x) { using std::sqrt; return T(sqrt(x)); }, a);
+    }
+    friend constexpr auto log(Pack const& a) -> Pack {
+        return map([](T x) { using std::log; return T(log(x)); }, a);
+    }
+    friend constexpr auto sin(Pack const& a) -> Pack {
+        return map([](T x) { using std::sin; return T(sin(x)); }, a);
+    }
+    friend constexpr auto cos(Pack const& a) -> Pack {
+        return map([](T x) { using std::cos; return T(cos(x)); }, a);
+    }
+    friend constexpr auto acos(Pack const& a) -> Pack {
+        return map([](T x) { using std::acos; return T(acos(x)); }, a);
+    }
+    friend constexpr auto isfinite(Pack const& a) -> mask_t {
+        return map([](T x) { using std::isfinite; return bool(isfinite(x)); }, a);
+    }
+    friend constexpr auto min(Pack const& a, Pack const& b) -> Pack {
+        return map([](T x, T y) { return y < x ? y : x; }, a, b);
+    }
+    friend constexpr auto max(Pack const& a, Pack const& b) -> Pack {
+        return map([](T x, T y) { return x < y ? y : x; }, a, b);
+    }
+};
+
+template <typename T, typename... S>
+Pack(T, S...) -> Pack<T, 1 + sizeof...(S)>;
+
+/*! Lane wise selection
+ * \shortexample select(mask, a, b)
+ * \group Pack Functions
+ *
+ * \param mask Pack<bool, N> or bool
+ * \param a    value used where mask is true
+ * \param b    value used where mask is false
+ * \return     Pack with the lanes of a where mask is set, otherwise the lanes of b.
+ *
+ * For a bool mask this is ``mask ? a : b``, so algorithms can be written once for scalars and packs.
+ *
+ * \code
+ *   auto a = sili::Pack{1., 2., 3., 4.};
+ *   auto b = select(a > 2., a, 0.);
+ *   std::cout << b[0] << " " << b[3] << "\n"; // prints 0 4
+ * \endcode
+ */
+template <typename T, size_t N>
+constexpr auto select(Pack<bool, N> const& mask, Pack<T, N> const& a, std::type_identity_t<Pack<T, N>> const& b) -> Pack<T, N> {
+    auto r = Pack<T, N>{};
+    for (size_t i{0}; i < N; ++i) {
+        r[i] = mask[i] ? a[i] : b[i];
+    }
+    return r;
+}
+
+template <typename T>
+constexpr auto select(bool mask, T const& a, T const& b) -> T {
+    return mask ? a : b;
+}
+
+/*! Any lane set
+ * \shortexample any_of(mask)
+ * \group Pack Functions
+ *
+ * \param mask Pack<bool, N> or bool
+ * \return     true if at least one lane of mask is true
+ */
+template <size_t N>
+constexpr auto any_of(Pack<bool, N> const& mask) -> bool {
+    for (size_t i{0}; i < N; ++i) {
+        if (mask[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr auto any_of(bool mask) -> bool {
+    return mask;
+}
+
+/*! All lanes set
+ * \shortexample all_of(mask)
+ * \group Pack Functions
+ *
+ * \param mask Pack<bool, N> or bool
+ * \return     true if every lane of mask is true
+ */
+template <size_t N>
+constexpr auto all_of(Pack<bool, N> const& mask) -> bool {
+    for (size_t i{0}; i < N; ++i) {
+        if (not mask[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr auto all_of(bool mask) -> bool {
+    return mask;
+}
+
+}
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace sili {
+
+/*! QR decomposition with Householder reflections
+ * \shortexample sili::QR{m}
+ * \group Classes
+ *
+ * \param Rows number of rows of the decomposed matrix
+ * \param Cols number of columns of the decomposed matrix, at most Rows
+ * \param T    type of the elements
+ *
+ * Decomposes a matrix as ``m = Q * R`` with an orthogonal Rows x Rows matrix Q and an upper
+ * triangular matrix R. Q is not formed, it is stored in compact form as Cols Householder
+ * reflectors below the diagonal, applyQ() and applyQt() multiply with Q or Qᵀ directly.
+ * All loops are unrolled at compile time.
+ *
+ * solve() computes the least squares solution of ``m * x = b``, this does not square the
+ * condition number like ``inv(trans(m) * m) * trans(m) * b``.
+ * singular() is true if m does not have full column rank (up to rounding errors), in this
+ * case the results of solve() are invalid. For a MatrixBatch (T is a Pack) singular() is a mask.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1., 0.},
+ *                          {1., 1.},
+ *                          {1., 2.}}};
+ *   auto qr = sili::QR{a};
+ *   auto x = qr.solve(sili::Matrix{{{1.}, {2.}, {3.}}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <size_t Rows, size_t Cols, typename T>
+class QR {
+    static_assert(Cols <= Rows, "QR needs at least as many rows as columns");
+
+    using mask_t = std::remove_cvref_t<decltype(std::declval<T>() < std::declval<T>())>;
+
+    // R on and above the diagonal, the reflectors below (with an implicit 1 on the diagonal)
+    Matrix<Rows, Cols, T> qr{};
+    Matrix<Cols, 1, T>    tau{};
+    mask_t                isSingular{false};
+
+    // applies reflector ``H_k = I - tau_k * v_k * v_kᵀ`` to the columns of x starting at FirstCol
+    template <size_t k, size_t FirstCol = 0, typename X>
+    constexpr void reflect(X& x) const {
+        for_constexpr<FirstCol, cols_v<X>>([&]<size_t col>() {
+            auto w = x.template at<k, col>();
+            for_constexpr<k + 1, Rows>([&]<size_t i>() {
+                w = w + qr.template at<i, k>() * x.template at<i, col>();
+            });
+            w = w * tau.template at<k, 0>();
+            x.template at<k, col>() = x.template at<k, col>() - w;
+            for_constexpr<k + 1, Rows>([&]<size_t i>() {
+                x.template at<i, col>() = x.template at<i, col>() - w * qr.template at<i, k>();
+            });
+        });
+    }
+
+public:
+    using value_t = T;
+
+    template <_concept::Matrix M> requires (rows_v<M> == Rows and cols_v<M> == Cols)
+    constexpr explicit QR(M const& m)
+        : qr{m}
+    {
+        using std::abs;
+        using std::sqrt;
+        for_constexpr<size_t{0}, Cols>([&]<size_t k>() {
+            auto alpha = qr.template at<k, k>();
+            auto sigma = T{0};
+            for_constexpr<k + 1, Rows>([&]<size_t i>() {
+                sigma = sigma + qr.template at<i, k>() * qr.template at<i, k>();
+            });
+            // reflections keep the norm, this is the norm of the original column
+            auto colNorm2 = alpha * alpha + sigma;
+            for_constexpr<size_t{0}, k>([&]<size_t i>() {
+                colNorm2 = colNorm2 + qr.template at<i, k>() * qr.template at<i, k>();
+            });
+            // nothing below the diagonal, no reflection needed
+            auto identity = sigma <= T{0};
+            auto norm     = sqrt(alpha * alpha + sigma);
+            auto beta     = select(identity, alpha, select(alpha < T{0}, norm, -norm));
+            auto scale    = T{1} / select(identity, T{1}, alpha - beta);
+            tau.template at<k, 0>() = select(identity, T{0}, (beta - alpha) / select(identity, T{1}, beta));
+            for_constexpr<k + 1, Rows>([&]<size_t i>() {
+                qr.template at<i, k>() = qr.template at<i, k>() * scale;
+            });
+            qr.template at<k, k>() = beta;
+            // column is (numerically) a linear combination of the previous ones
+            constexpr auto tolerance = lane_t<T>(Rows) * std::numeric_limits<lane_t<T>>::epsilon();
+            isSingular = isSingular || abs(beta) <= sqrt(colNorm2) * T{tolerance};
+
+            // apply the reflection to the remaining columns
+            reflect<k, k + 1>(qr);
+        });
+    }
+
+    // true (or a mask for packs) if the matrix does not have full column rank
+    constexpr auto singular() const -> mask_t {
+        return isSingular;
+    }
+
+    // computes ``Qᵀ * b`` without forming Q
+    template <_concept::Matrix B> requires (rows_v<B> == Rows)
+    constexpr auto applyQt(B const& b) const {
+        using V = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<sili::value_t<B>>())>;
+        auto x = Matrix<Rows, cols_v<B>, V>{b};
+        for_constexpr<size_t{0}, Cols>([&]<size_t k>() {
+            reflect<k>(x);
+        });
+        return x;
+    }
+
+    // computes ``Q * b`` without forming Q
+    template <_concept::Matrix B> requires (rows_v<B> == Rows)
+    constexpr auto applyQ(B const& b) const {
+        using V = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<sili::value_t<B>>())>;
+        auto x = Matrix<Rows, cols_v<B>, V>{b};
+        for_constexpr<size_t{0}, Cols>([&]<size_t i>() {
+            reflect<Cols - 1 - i>(x);
+        });
+        return x;
+    }
+
+    // least squares solution of ``m * x = b``, b can be a vector or a matrix with multiple right hand sides
+    template <_concept::Matrix B> requires (rows_v<B> == Rows)
+    constexpr auto solve(B const& b) const {
+        auto y = applyQt(b);
+        using V = sili::value_t<decltype(y)>;
+        constexpr auto K = cols_v<B>;
+        auto x = Matrix<Cols, K, V>{};
+        // back substitution with R
+        for_constexpr<size_t{0}, Cols>([&]<size_t i>() {
+            constexpr auto row = Cols - 1 - i;
+            auto invDiag = V{1} / qr.template at<row, row>();
+            for_constexpr<size_t{0}, K>([&]<size_t col>() {
+                auto s = y.template at<row, col>();
+                for_constexpr<row + 1, Cols>([&]<size_t k>() {
+                    s = s - qr.template at<row, k>() * x.template at<k, col>();
+                });
+                x.template at<row, col>() = s * invDiag;
+            });
+        });
+        return x;
+    }
+
+    // orthogonal matrix Q
+    constexpr auto Q() const -> Matrix<Rows, Rows, T> {
+        auto id = Matrix<Rows, Rows, T>{};
+        for_constexpr<size_t{0}, Rows>([&]<size_t k>() {
+            id.template at<k, k>() = T{1};
+        });
+        return applyQ(id);
+    }
+
+    // upper triangular matrix R
+    constexpr auto R() const -> Matrix<Cols, Cols, T> {
+        auto r = Matrix<Cols, Cols, T>{};
+        for_constexpr<size_t{0}, Cols>([&]<size_t row>() {
+            for_constexpr<row, Cols>([&]<size_t col>() {
+                r.template at<row, col>() = qr.template at<row, col>();
+            });
+        });
+        return r;
+    }
+};
+
+template <_concept::Matrix M> requires (rows_v<M> >= cols_v<M>)
+QR(M const&) -> QR<rows_v<M>, cols_v<M>, std::remove_cvref_t<value_t<M>>>;
+
+/*! QR decomposition
+ * \shortexample qr(m)
+ * \group Free Matrix Functions
+ *
+ * \param m _concept::Matrix with at least as many rows as columns
+ * \return  QR decomposition of m
+ */
+template <_concept::Matrix M> requires (rows_v<M> >= cols_v<M>)
+constexpr auto qr(M const& m) {
+    return QR{m};
+}
+
+/*! Least squares solution
+ * \shortexample lstsq(a, b)
+ * \group Free Matrix Functions
+ *
+ * \param a _concept::Matrix with at least as many rows as columns and full column rank
+ * \param b _concept::Matrix with as many rows as a
+ * \return  x minimizing ``norm(a * x - b)``, computed with a QR decomposition
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1., 0.},
+ *                          {1., 1.},
+ *                          {1., 2.}}};
+ *   auto x = lstsq(a, sili::Matrix{{{1.}, {2.}, {3.}}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <_concept::Matrix M, _concept::Matrix B> requires (rows_v<M> >= cols_v<M> and rows_v<B> == rows_v<M>)
+constexpr auto lstsq(M const& a, B const& b) {
+    return QR{a}.solve(b);
+}
+
+}
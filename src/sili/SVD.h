@@ -0,0 +1,467 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "operations.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace sili {
+
+/*! Result of svd()
+ * \shortexample sili::SVD<R, C, T>
+ * \group Classes
+ *
+ * \param R number of rows of the decomposed matrix
+ * \param C number of columns of the decomposed matrix
+ * \param T type of the elements
+ *
+ * Thin singular value decomposition ``m = U * diag(S) * Vᵀ`` with ``K = min(R, C)``.
+ * U is R x K and V is C x K, both have orthonormal columns. S holds the K singular
+ * values in descending order. converged is false if the iteration limit was reached.
+ */
+template <size_t R, size_t C, typename T>
+struct SVD {
+    static constexpr size_t K = std::min(R, C);
+
+    Matrix<R, K, T> U{};
+    Matrix<K, 1, T> S{};
+    Matrix<C, K, T> V{};
+    bool converged{true};
+};
+
+namespace details {
+// sorts the singular values in descending order, U and V are permuted accordingly
+template <size_t R, size_t C, typename T>
+constexpr void sortSVD(SVD<R, C, T>& svd) {
+    constexpr auto K = SVD<R, C, T>::K;
+    for (size_t i{0}; i < K; ++i) {
+        auto largest = i;
+        for (size_t j{i + 1}; j < K; ++j) {
+            if (svd.S(largest, 0) < svd.S(j, 0)) {
+                largest = j;
+            }
+        }
+        if (largest == i) {
+            continue;
+        }
+        std::swap(svd.S(i, 0), svd.S(largest, 0));
+        for (size_t row{0}; row < R; ++row) {
+            std::swap(svd.U(row, i), svd.U(row, largest));
+        }
+        for (size_t row{0}; row < C; ++row) {
+            std::swap(svd.V(row, i), svd.V(row, largest));
+        }
+    }
+}
+
+/* One sided Jacobi (Hestenes) for R >= C
+ * Pairs of columns are rotated until all columns are orthogonal, the column norms are
+ * the singular values. All loops except the sweeps are unrolled at compile time.
+ */
+template <size_t R, size_t C, typename T>
+constexpr auto svd_jacobi(Matrix<R, C, T> a) -> SVD<R, C, T> {
+    using std::abs;
+    using std::sqrt;
+    constexpr auto tolerance = T(R) * std::numeric_limits<T>::epsilon();
+    constexpr size_t maxSweeps = 64;
+
+    auto ret = SVD<R, C, T>{};
+    auto& v  = ret.V;
+    for_constexpr<size_t{0}, C>([&]<size_t k>() {
+        v.template at<k, k>() = T{1};
+    });
+
+    // squared column norms, recomputed each sweep and updated by the rotations
+    auto norms  = Matrix<C, 1, T>{};
+    auto update = [&]() {
+        auto total = T{0};
+        for_constexpr<size_t{0}, C>([&]<size_t k>() {
+            auto n = T{0};
+            for_constexpr<size_t{0}, R>([&]<size_t i>() {
+                n += a.template at<i, k>() * a.template at<i, k>();
+            });
+            norms.template at<k, 0>() = n;
+            total += n;
+        });
+        return total;
+    };
+    // pairs of (numerically) zero columns are orthogonal as well
+    auto const negligible = std::numeric_limits<T>::epsilon() * update();
+
+    auto rotated = true;
+    for (size_t sweep{0}; sweep < maxSweeps and rotated; ++sweep) {
+        rotated = false;
+        if (sweep > 0) {
+            update();
+        }
+        for_constexpr<size_t{0}, C>([&]<size_t p>() {
+            for_constexpr<p + 1, C>([&]<size_t q>() {
+                auto& alpha = norms.template at<p, 0>();
+                auto& beta  = norms.template at<q, 0>();
+                auto gamma  = T{0};
+                for_constexpr<size_t{0}, R>([&]<size_t i>() {
+                    gamma += a.template at<i, p>() * a.template at<i, q>();
+                });
+                // columns p and q are already orthogonal
+                if (gamma * gamma <= tolerance * tolerance * alpha * beta + negligible * negligible) {
+                    return;
+                }
+                rotated = true;
+                auto zeta = (beta - alpha) / (T{2} * gamma);
+                auto t    = (zeta < T{0} ? T{-1} : T{1}) / (abs(zeta) + sqrt(T{1} + zeta * zeta));
+                auto c    = T{1} / sqrt(T{1} + t * t);
+                auto s    = c * t;
+                alpha -= t * gamma;
+                beta  += t * gamma;
+                auto rotate = [&]<typename M>(M& m) {
+                    for_constexpr<size_t{0}, rows_v<M>>([&]<size_t i>() {
+                        auto x = m.template at<i, p>();
+                        auto y = m.template at<i, q>();
+                        m.template at<i, p>() = c * x - s * y;
+                        m.template at<i, q>() = s * x + c * y;
+                    });
+                };
+                rotate(a);
+                rotate(v);
+            });
+        });
+    }
+    ret.converged = not rotated;
+
+    for_constexpr<size_t{0}, C>([&]<size_t k>() {
+        auto n = T{0};
+        for_constexpr<size_t{0}, R>([&]<size_t i>() {
+            n += a.template at<i, k>() * a.template at<i, k>();
+        });
+        n = sqrt(n);
+        ret.S.template at<k, 0>() = n;
+        // columns of zero singular values stay zero
+        auto invN = n > T{0} ? T{1} / n : T{0};
+        for_constexpr<size_t{0}, R>([&]<size_t i>() {
+            ret.U.template at<i, k>() = a.template at<i, k>() * invN;
+        });
+    });
+    sortSVD(ret);
+    return ret;
+}
+
+template <typename T>
+constexpr auto signCopy(T const& a, T const& b) -> T {
+    using std::abs;
+    return (b >= T{0}) ? abs(a) : -abs(a);
+}
+
+// computes (a² + b²)^1/2 without destructive underflow or overflow
+template <typename T>
+constexpr auto pythag(T a, T b) -> T {
+    using std::abs;
+    using std::sqrt;
+    a = abs(a);
+    b = abs(b);
+    if (a > b) {
+        return a * sqrt(T{1} + (b / a) * (b / a));
+    } else if (b == T{0}) {
+        return T{0};
+    }
+    return b * sqrt(T{1} + (a / b) * (a / b));
+}
+
+/* Golub-Reinsch for R >= C
+ * Householder reduction to bidiagonal form followed by implicitly shifted QR steps.
+ */
+template <size_t R, size_t C, typename T>
+constexpr auto svd_golub_reinsch(Matrix<R, C, T> const& m) -> SVD<R, C, T> {
+    using std::abs;
+    using std::sqrt;
+    constexpr size_t maxIterations = 30;
+
+    auto ret  = SVD<R, C, T>{};
+    auto& u   = ret.U;
+    auto& w   = ret.S;
+    auto& v   = ret.V;
+    auto rv1  = Matrix<C, 1, T>{};
+    auto anorm = T{0};
+    u = m;
+
+    // Householder reduction to bidiagonal form
+    for (size_t i{0}; i < C; ++i) {
+        auto scale = T{0};
+        for (size_t k{i}; k < R; ++k) {
+            scale += abs(u(k, i));
+        }
+        if (scale != T{0}) {
+            auto s = T{0};
+            for (size_t k{i}; k < R; ++k) {
+                u(k, i) /= scale;
+                s += u(k, i) * u(k, i);
+            }
+            auto f = u(i, i);
+            auto g = -signCopy(sqrt(s), f);
+            auto h = f * g - s;
+            u(i, i) = f - g;
+            for (size_t j{i + 1}; j < C; ++j) {
+                auto s2 = T{0};
+                for (size_t k{i}; k < R; ++k) {
+                    s2 += u(k, i) * u(k, j);
+                }
+                auto f2 = s2 / h;
+                for (size_t k{i}; k < R; ++k) {
+                    u(k, j) += f2 * u(k, i);
+                }
+            }
+            for (size_t k{i}; k < R; ++k) {
+                u(k, i) *= scale;
+            }
+            w(i, 0) = scale * g;
+        }
+
+        auto l = i + 1;
+        if (l < C) {
+            scale = T{0};
+            for (size_t k{l}; k < C; ++k) {
+                scale += abs(u(i, k));
+            }
+            if (scale != T{0}) {
+                auto s = T{0};
+                for (size_t k{l}; k < C; ++k) {
+                    u(i, k) /= scale;
+                    s += u(i, k) * u(i, k);
+                }
+                auto f = u(i, l);
+                auto g = -signCopy(sqrt(s), f);
+                auto h = f * g - s;
+                u(i, l) = f - g;
+                for (size_t k{l}; k < C; ++k) {
+                    rv1(k, 0) = u(i, k) / h;
+                }
+                for (size_t j{l}; j < R; ++j) {
+                    auto s2 = T{0};
+                    for (size_t k{l}; k < C; ++k) {
+                        s2 += u(j, k) * u(i, k);
+                    }
+                    for (size_t k{l}; k < C; ++k) {
+                        u(j, k) += s2 * rv1(k, 0);
+                    }
+                }
+                for (size_t k{l}; k < C; ++k) {
+                    u(i, k) *= scale;
+                }
+                rv1(l, 0) = scale * g;
+            } else {
+                rv1(l, 0) = T{0};
+            }
+        }
+        anorm = std::max(anorm, abs(w(i, 0)) + abs(rv1(i, 0)));
+    }
+
+    // accumulation of right hand transformations
+    for (size_t i{C}; i-- > 0;) {
+        auto l = i + 1;
+        if (l < C) {
+            if (rv1(l, 0) != T{0}) {
+                // double division to avoid possible underflow
+                for (size_t j{l}; j < C; ++j) {
+                    v(j, i) = (u(i, j) / u(i, l)) / rv1(l, 0);
+                }
+                for (size_t j{l}; j < C; ++j) {
+                    auto s = T{0};
+                    for (size_t k{l}; k < C; ++k) {
+                        s += u(i, k) * v(k, j);
+                    }
+                    for (size_t k{l}; k < C; ++k) {
+                        v(k, j) += s * v(k, i);
+                    }
+                }
+            }
+            for (size_t j{l}; j < C; ++j) {
+                v(i, j) = T{0};
+                v(j, i) = T{0};
+            }
+        }
+        v(i, i) = T{1};
+    }
+
+    // accumulation of left hand transformations
+    for (size_t i{C}; i-- > 0;) {
+        auto l = i + 1;
+        for (size_t j{l}; j < C; ++j) {
+            u(i, j) = T{0};
+        }
+        if (w(i, 0) != T{0}) {
+            auto invW = T{1} / w(i, 0);
+            for (size_t j{l}; j < C; ++j) {
+                auto s = T{0};
+                for (size_t k{l}; k < R; ++k) {
+                    s += u(k, i) * u(k, j);
+                }
+                auto f = (s / u(i, i)) * invW;
+                for (size_t k{i}; k < R; ++k) {
+                    u(k, j) += f * u(k, i);
+                }
+            }
+            for (size_t k{i}; k < R; ++k) {
+                u(k, i) *= invW;
+            }
+        } else {
+            for (size_t k{i}; k < R; ++k) {
+                u(k, i) = T{0};
+            }
+        }
+        u(i, i) += T{1};
+    }
+
+    // diagonalization of the bidiagonal form
+    for (size_t k{C}; k-- > 0;) {
+        for (size_t its{1}; its <= maxIterations; ++its) {
+            // test for splitting, rv1(0) is always zero
+            auto flag = true;
+            auto l    = k;
+            for (;; --l) {
+                if (l == 0 or abs(rv1(l, 0)) + anorm == anorm) {
+                    flag = false;
+                    break;
+                }
+                if (abs(w(l - 1, 0)) + anorm == anorm) {
+                    break;
+                }
+            }
+            if (flag) {
+                // cancellation of rv1(l)
+                auto c = T{0};
+                auto s = T{1};
+                for (size_t i{l}; i <= k; ++i) {
+                    auto f = s * rv1(i, 0);
+                    rv1(i, 0) = c * rv1(i, 0);
+                    if (abs(f) + anorm == anorm) {
+                        break;
+                    }
+                    auto g = w(i, 0);
+                    auto h = pythag(f, g);
+                    w(i, 0) = h;
+                    h = T{1} / h;
+                    c = g * h;
+                    s = -f * h;
+                    for (size_t j{0}; j < R; ++j) {
+                        auto y = u(j, l - 1);
+                        auto z = u(j, i);
+                        u(j, l - 1) = y * c + z * s;
+                        u(j, i)     = z * c - y * s;
+                    }
+                }
+            }
+            auto z = w(k, 0);
+            if (l == k) {
+                // convergence, singular value is made non negative
+                if (z < T{0}) {
+                    w(k, 0) = -z;
+                    for (size_t j{0}; j < C; ++j) {
+                        v(j, k) = -v(j, k);
+                    }
+                }
+                break;
+            }
+            if (its == maxIterations) {
+                ret.converged = false;
+                break;
+            }
+            // shift from bottom 2x2 minor
+            auto x = w(l, 0);
+            auto y = w(k - 1, 0);
+            auto g = rv1(k - 1, 0);
+            auto h = rv1(k, 0);
+            auto f = ((y - z) * (y + z) + (g - h) * (g + h)) / (T{2} * h * y);
+            g = pythag(f, T{1});
+            f = ((x - z) * (x + z) + h * ((y / (f + signCopy(g, f))) - h)) / x;
+
+            // next QR transformation
+            auto c = T{1};
+            auto s = T{1};
+            for (size_t j{l}; j < k; ++j) {
+                auto i = j + 1;
+                g = rv1(i, 0);
+                y = w(i, 0);
+                h = s * g;
+                g = c * g;
+                z = pythag(f, h);
+                rv1(j, 0) = z;
+                c = f / z;
+                s = h / z;
+                f = x * c + g * s;
+                g = g * c - x * s;
+                h = y * s;
+                y *= c;
+                for (size_t jj{0}; jj < C; ++jj) {
+                    auto vx = v(jj, j);
+                    auto vz = v(jj, i);
+                    v(jj, j) = vx * c + vz * s;
+                    v(jj, i) = vz * c - vx * s;
+                }
+                z = pythag(f, h);
+                // rotation can be arbitrary if z is zero
+                w(j, 0) = z;
+                if (z != T{0}) {
+                    z = T{1} / z;
+                    c = f * z;
+                    s = h * z;
+                }
+                f = c * g + s * y;
+                x = c * y - s * g;
+                for (size_t jj{0}; jj < R; ++jj) {
+                    auto uy = u(jj, j);
+                    auto uz = u(jj, i);
+                    u(jj, j) = uy * c + uz * s;
+                    u(jj, i) = uz * c - uy * s;
+                }
+            }
+            rv1(l, 0) = T{0};
+            rv1(k, 0) = f;
+            w(k, 0)   = x;
+        }
+    }
+    sortSVD(ret);
+    return ret;
+}
+}
+
+/*! Singular value decomposition
+ * \shortexample svd(m)
+ * \group Free Matrix Functions
+ *
+ * \param m _concept::Matrix
+ * \return  SVD with ``m = U * diag(S) * Vᵀ``, singular values sorted in descending order
+ *
+ * Matrices with ``min(rows, cols) <= 6`` are decomposed with a one sided Jacobi method
+ * that is unrolled at compile time, larger matrices with the Golub-Reinsch algorithm.
+ * Nothing is allocated. Integer matrices are decomposed as double.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{3., 0.},
+ *                          {0., -4.}}};
+ *   auto [U, S, V, converged] = svd(a);
+ *   std::cout << S << "\n"; // prints {{4.}, {3.}}
+ * \endcode
+ */
+template <_concept::Matrix M>
+constexpr auto svd(M const& m) {
+    using V = std::remove_cvref_t<value_t<M>>;
+    using T = std::conditional_t<std::is_floating_point_v<V>, V, double>;
+    constexpr auto R = rows_v<M>;
+    constexpr auto C = cols_v<M>;
+    if constexpr (R < C) {
+        // decompose the transposed matrix, U and V swap their roles
+        auto t = svd(Matrix<C, R, T>{view_trans(m)});
+        return SVD<R, C, T>{t.V, t.S, t.U, t.converged};
+    } else if constexpr (C <= 6) {
+        return details::svd_jacobi(Matrix<R, C, T>{m});
+    } else {
+        return details::svd_golub_reinsch(Matrix<R, C, T>{m});
+    }
+}
+
+}
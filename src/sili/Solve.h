@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "LU.h"
+#include "Matrix.h"
+#include "Pack.h"
+#include "operations.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace sili {
+
+/*! Result of solve()
+ * \shortexample sili::Solution<N, C, T>
+ * \group Classes
+ *
+ * \param N number of unknowns
+ * \param C number of right hand sides
+ * \param T type of the elements
+ *
+ * x is the solution of ``a * x = b``. singular is true if ``a`` is singular, in this case x is invalid.
+ * For a MatrixBatch (T is a Pack) singular is a mask.
+ */
+template <size_t N, size_t C, typename T>
+struct Solution {
+    using mask_t = std::remove_cvref_t<decltype(std::declval<T>() < std::declval<T>())>;
+
+    Matrix<N, C, T> x{};
+    mask_t          singular{false};
+};
+
+namespace details {
+// closed forms for up to 3x3, x is the adjugate of a times b divided by the determinant
+template <typename T, _concept::Matrix M, _concept::Matrix B>
+constexpr auto solve_closed(M const& a, B const& b) {
+    using std::abs;
+    using X = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<value_t<B>>())>;
+    constexpr auto N = rows_v<M>;
+    constexpr auto C = cols_v<B>;
+
+    auto ret = Solution<N, C, X>{};
+    auto d   = T(det(a));
+    ret.singular = abs(d) <= T{0};
+    // singular lanes continue with 1, so the other lanes stay valid
+    auto invD = T{1} / select(ret.singular, T{1}, d);
+
+    if constexpr (N == 1) {
+        for_constexpr<size_t{0}, C>([&]<size_t col>() {
+            ret.x.template at<0, col>() = at<0, col>(b) * invD;
+        });
+    } else if constexpr (N == 2) {
+        for_constexpr<size_t{0}, C>([&]<size_t col>() {
+            auto b0 = at<0, col>(b);
+            auto b1 = at<1, col>(b);
+            ret.x.template at<0, col>() = (T(at<1, 1>(a)) * b0 - T(at<0, 1>(a)) * b1) * invD;
+            ret.x.template at<1, col>() = (T(at<0, 0>(a)) * b1 - T(at<1, 0>(a)) * b0) * invD;
+        });
+    } else {
+        auto adj = Matrix<3, 3, T>{};
+        for_each_constexpr<decltype(adj)>([&]<auto row, auto col>() {
+            auto tl = T(at<(row+1)%3, (col+1)%3>(a));
+            auto br = T(at<(row+2)%3, (col+2)%3>(a));
+            auto tr = T(at<(row+1)%3, (col+2)%3>(a));
+            auto bl = T(at<(row+2)%3, (col+1)%3>(a));
+            adj.template at<col, row>() = (tl*br - tr*bl) * invD;
+        });
+        for_constexpr<size_t{0}, C>([&]<size_t col>() {
+            for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+                ret.x.template at<row, col>() = adj.template at<row, 0>() * at<0, col>(b)
+                                              + adj.template at<row, 1>() * at<1, col>(b)
+                                              + adj.template at<row, 2>() * at<2, col>(b);
+            });
+        });
+    }
+    return ret;
+}
+}
+
+/*! Solve a linear system
+ * \shortexample solve(a, b)
+ * \group Free Matrix Functions
+ *
+ * \param a _concept::Matrix, square
+ * \param b _concept::Matrix with as many rows as a, a vector or multiple right hand sides
+ * \return  Solution with x solving ``a * x = b`` and a singular flag
+ *
+ * The inverse of a is never formed. Matrices up to 3x3 are solved with closed formulas,
+ * larger matrices with an LU factorization with partial pivoting (see LU).
+ * a is singular if its determinant (or a pivot) is exactly zero, there is no threshold.
+ * For a MatrixBatch every lane is solved on its own and singular is a mask.
+ * Integer matrices are solved as double.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{2., 1.},
+ *                          {1., 3.}}};
+ *   auto [x, singular] = solve(a, sili::Matrix{{{3.}, {4.}}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <_concept::Matrix M, _concept::Matrix B> requires (rows_v<M> == cols_v<M> and rows_v<B> == rows_v<M>)
+constexpr auto solve(M const& a, B const& b) {
+    using V = std::remove_cvref_t<value_t<M>>;
+    using T = std::conditional_t<std::is_floating_point_v<lane_t<V>>, V, double>;
+    constexpr auto N = rows_v<M>;
+    if constexpr (N <= 3) {
+        return details::solve_closed<T>(a, b);
+    } else {
+        auto lu = LU<N, T>{a};
+        auto x  = lu.solve(b);
+        return Solution<N, cols_v<B>, value_t<decltype(x)>>{x, lu.singular()};
+    }
+}
+
+}
@@ -0,0 +1,370 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "expression.h"
+#include "operations.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sili {
+
+/*! Symmetric matrix with packed storage
+ * \shortexample sili::SymMatrix<N, double>
+ * \group Classes
+ *
+ * Fulfills the _concept::SymMatrix concept.
+ *
+ * \param N size of the matrix
+ * \param T type of the elements
+ *
+ * Only the lower triangle is stored, N(N+1)/2 elements row by row: element (row, col) with
+ * col ≤ row is at ``row * (row + 1) / 2 + col``, m(row, col) and m(col, row) are the same element.
+ * ``+``, ``-``, scalar ``*`` and ``/`` work on the packed elements and return a SymMatrix,
+ * ``m * x`` and ``x * m`` read every stored element once and return a Matrix.
+ * sandwich(j, m) computes ``j * m * jᵀ`` as SymMatrix, LLT and LDLT factorize a SymMatrix directly.
+ * lazy(m) is a _concept::Expression of all N × N elements that can be assigned to or combined
+ * with a Matrix, full(m) evaluates it.
+ *
+ * \code
+ *   auto p = sili::SymMatrix{{{4., 2.},
+ *                             {2., 5.}}};
+ *   std::cout << p(0, 1) << "\n"; // prints 2
+ *   auto y = p * sili::Matrix{{{1.}, {1.}}};
+ *   std::cout << y << "\n"; // prints {{6.}, {7.}}
+ *   auto x = cholesky(p).solve(y);
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ *
+ * \caption Methods
+ * \param data() returns pointer to the packed elements
+ * \param m(row,col) access element at ``row`` and ``col``
+ */
+template <size_t N, typename T>
+class SymMatrix {
+    std::array<T, N * (N + 1) / 2> vals{};
+
+    static constexpr auto index(size_t row, size_t col) -> size_t {
+        return row >= col ? row * (row + 1) / 2 + col : col * (col + 1) / 2 + row;
+    }
+
+public:
+    using value_t = T;
+
+    static constexpr size_t Rows = N;
+    static constexpr size_t Cols = N;
+    // number of stored elements
+    static constexpr size_t Size = N * (N + 1) / 2;
+
+    constexpr SymMatrix() = default;
+
+    // only the lower triangle is read
+    constexpr SymMatrix(T const (&values)[N][N]) {
+        for (size_t row{0}; row < N; ++row) {
+            for (size_t col{0}; col <= row; ++col) {
+                vals[index(row, col)] = values[row][col];
+            }
+        }
+    }
+
+    // only the lower triangle is read
+    template <typename M> requires ((_concept::Matrix<M> or _concept::Expression<M>) and rows_v<M> == N and cols_v<M> == N)
+    constexpr explicit SymMatrix(M const& m) {
+        for (size_t row{0}; row < N; ++row) {
+            for (size_t col{0}; col <= row; ++col) {
+                vals[index(row, col)] = m(row, col);
+            }
+        }
+    }
+
+    constexpr auto operator=(T const& s) -> SymMatrix& {
+        vals.fill(s);
+        return *this;
+    }
+
+    constexpr auto data() -> T* {
+        return vals.data();
+    }
+    constexpr auto data() const -> T const* {
+        return vals.data();
+    }
+
+    constexpr auto operator()(size_t row, size_t col) -> T& {
+        return vals[index(row, col)];
+    }
+    constexpr auto operator()(size_t row, size_t col) const -> T const& {
+        return vals[index(row, col)];
+    }
+
+    template <size_t row, size_t col>
+    constexpr auto at() -> T& {
+        static_assert(row < N and col < N);
+        return std::get<index(row, col)>(vals);
+    }
+    template <size_t row, size_t col>
+    constexpr auto at() const -> T const& {
+        static_assert(row < N and col < N);
+        return std::get<index(row, col)>(vals);
+    }
+
+    constexpr auto operator==(SymMatrix const&) const -> bool = default;
+};
+
+template <size_t N, typename T>
+SymMatrix(T const (&)[N][N]) -> SymMatrix<N, T>;
+
+template <_concept::Matrix M>
+SymMatrix(M const&) -> SymMatrix<rows_v<M>, std::remove_cvref_t<value_t<M>>>;
+
+namespace details {
+// read only access to all elements of a SymMatrix
+template <size_t N, typename T>
+struct SymOperand {
+    SymMatrix<N, T> const* m;
+
+    template <size_t row, size_t col>
+    constexpr auto at() const -> T const& {
+        return m->template at<row, col>();
+    }
+    constexpr auto operator()(size_t row, size_t col) const -> T const& {
+        return (*m)(row, col);
+    }
+};
+
+template <size_t N, typename T>
+struct expression_element<SymOperand<N, T>> : std::type_identity<T> {};
+template <size_t N, typename T>
+constexpr size_t expression_rows<SymOperand<N, T>> = N;
+template <size_t N, typename T>
+constexpr size_t expression_cols<SymOperand<N, T>> = N;
+
+// y = a * x for a single column, x(k) reads and y(k) writes the elements.
+// Every stored element is read once: left of the diagonal it is part of the dot product
+// of its row with x, its mirror above the diagonal is added to y.
+template <size_t N, typename T, typename X, typename Y>
+constexpr void symv(SymMatrix<N, T> const& a, X const& x, Y const& y) {
+    auto p = a.data();
+    for (size_t row{0}; row < N; ++row) {
+        auto xr  = x(row);
+        auto acc = p[row] * xr;
+        for (size_t col{0}; col < row; ++col) {
+            acc    = acc + p[col] * x(col);
+            y(col) = y(col) + p[col] * xr;
+        }
+        y(row) = acc;
+        p += row + 1;
+    }
+}
+}
+
+/*! Lazy expression of a symmetric matrix
+ * \shortexample lazy(m)
+ * \group Matrix Operations
+ *
+ * \param m SymMatrix
+ * \return  _concept::Expression of all N × N elements of m, m is referenced and must outlive it
+ *
+ * \code
+ *   auto p = sili::SymMatrix{{{4., 2.},
+ *                             {2., 5.}}};
+ *   auto m = sili::Matrix{{{1., 0.},
+ *                          {0., 1.}}};
+ *   m += lazy(p);
+ *   std::cout << m << "\n"; // prints {{5., 2.},
+ *                                      {2., 6.}}
+ * \endcode
+ */
+template <size_t N, typename T>
+constexpr auto lazy(SymMatrix<N, T> const& m) {
+    return details::make_expression([](auto e) constexpr { return e; }, details::SymOperand<N, T>{&m});
+}
+template <size_t N, typename T>
+void lazy(SymMatrix<N, T>&& m) = delete;
+
+/*! Full matrix of a symmetric matrix
+ * \shortexample full(m)
+ * \group Free Matrix Functions
+ *
+ * \param m SymMatrix
+ * \return  Matrix with all N × N elements of m
+ */
+template <size_t N, typename T>
+constexpr auto full(SymMatrix<N, T> const& m) -> Matrix<N, N, T> {
+    auto ret = Matrix<N, N, T>{};
+    auto p   = m.data();
+    for (size_t row{0}; row < N; ++row) {
+        for (size_t col{0}; col <= row; ++col) {
+            ret(row, col) = p[col];
+            ret(col, row) = p[col];
+        }
+        p += row + 1;
+    }
+    return ret;
+}
+
+template <size_t N, typename T>
+constexpr auto operator+(SymMatrix<N, T> const& m) {
+    return m;
+}
+
+template <size_t N, typename T>
+constexpr auto operator-(SymMatrix<N, T> m) {
+    for (size_t i{0}; i < m.Size; ++i) {
+        m.data()[i] = -m.data()[i];
+    }
+    return m;
+}
+
+template <size_t N, typename T>
+constexpr auto operator+=(SymMatrix<N, T>& l, SymMatrix<N, T> const& r) -> auto& {
+    for (size_t i{0}; i < l.Size; ++i) {
+        l.data()[i] += r.data()[i];
+    }
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator-=(SymMatrix<N, T>& l, SymMatrix<N, T> const& r) -> auto& {
+    for (size_t i{0}; i < l.Size; ++i) {
+        l.data()[i] -= r.data()[i];
+    }
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator+(SymMatrix<N, T> l, SymMatrix<N, T> const& r) {
+    l += r;
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator-(SymMatrix<N, T> l, SymMatrix<N, T> const& r) {
+    l -= r;
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator*=(SymMatrix<N, T>& l, T const& s) -> auto& {
+    for (size_t i{0}; i < l.Size; ++i) {
+        l.data()[i] *= s;
+    }
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator/=(SymMatrix<N, T>& l, T const& s) -> auto& {
+    for (size_t i{0}; i < l.Size; ++i) {
+        l.data()[i] /= s;
+    }
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator*(SymMatrix<N, T> l, T const& s) {
+    l *= s;
+    return l;
+}
+
+template <size_t N, typename T>
+constexpr auto operator*(T const& s, SymMatrix<N, T> r) {
+    for (size_t i{0}; i < r.Size; ++i) {
+        r.data()[i] = s * r.data()[i];
+    }
+    return r;
+}
+
+template <size_t N, typename T>
+constexpr auto operator/(SymMatrix<N, T> l, T const& s) {
+    l /= s;
+    return l;
+}
+
+// symmetric times a matrix, ``a * x`` column by column
+template <size_t N, typename T, _concept::Matrix X> requires (rows_v<X> == N)
+constexpr auto operator*(SymMatrix<N, T> const& a, X const& x) {
+    using R = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<value_t<X>>())>;
+    auto ret = Matrix<N, cols_v<X>, R>{};
+    for (size_t col{0}; col < cols_v<X>; ++col) {
+        details::symv(a, [&](size_t k) { return x(k, col); },
+                         [&](size_t k) -> R& { return ret(k, col); });
+    }
+    return ret;
+}
+
+// a matrix times symmetric, ``x * a`` row by row
+template <_concept::Matrix X, size_t N, typename T> requires (cols_v<X> == N)
+constexpr auto operator*(X const& x, SymMatrix<N, T> const& a) {
+    using R = std::remove_cvref_t<decltype(std::declval<value_t<X>>() * std::declval<T>())>;
+    auto ret = Matrix<rows_v<X>, N, R>{};
+    for (size_t row{0}; row < rows_v<X>; ++row) {
+        details::symv(a, [&](size_t k) { return x(row, k); },
+                         [&](size_t k) -> R& { return ret(row, k); });
+    }
+    return ret;
+}
+
+/*! Sandwich product
+ * \shortexample sandwich(j, p)
+ * \group Free Matrix Functions
+ *
+ * \param j _concept::Matrix of size M × N
+ * \param p SymMatrix of size N × N
+ * \return  SymMatrix<M> of ``j * p * jᵀ``
+ *
+ * Only the lower triangle of ``(j * p) * jᵀ`` is computed, e.g. the covariance prediction
+ * ``F * P * Fᵀ + Q`` of a filter:
+ *
+ * \code
+ *   auto f = sili::Matrix{{{1., 0.1},
+ *                          {0., 1. }}};
+ *   auto p = sili::SymMatrix{{{4., 0.},
+ *                             {0., 1.}}};
+ *   auto q = sili::SymMatrix{{{0.01, 0.  },
+ *                             {0.,   0.01}}};
+ *   p = sandwich(f, p) + q;
+ *   std::cout << full(p) << "\n"; // prints {{4.02, 0.1 },
+ *                                            {0.1,  1.01}}
+ * \endcode
+ */
+template <_concept::Matrix J, size_t N, typename T> requires (cols_v<J> == N)
+constexpr auto sandwich(J const& j, SymMatrix<N, T> const& p) {
+    constexpr auto M  = rows_v<J>;
+    constexpr auto MR = details::gemm_mr;
+
+    // j * p with the register blocked kernel of operator*
+    auto jp = j * full(p);
+    using R = value_t<decltype(jp)>;
+
+    // jᵀ as row major operand, written row by row
+    auto jt = Matrix<N, M, R>{};
+    for (size_t k{0}; k < N; ++k) {
+        for (size_t row{0}; row < M; ++row) {
+            jt(k, row) = j(row, k);
+        }
+    }
+
+    // (j * p) * jᵀ in row blocks, each block only up to the diagonal
+    auto ret = SymMatrix<M, R>{};
+    for_constexpr<size_t{0}, (M + MR - 1) / MR>([&]<size_t I>() {
+        constexpr auto first = I * MR;
+        constexpr auto rows  = std::min(MR, M - first);
+        auto block = Matrix<rows, first + rows, R>{};
+        details::gemm_fixed<rows, first + rows, N>(jp.data() + first * jp.Stride, jp.Stride,
+                                                   jt.data(), jt.Stride,
+                                                   block.data(), block.Stride);
+        for (size_t row{0}; row < rows; ++row) {
+            for (size_t col{0}; col <= first + row; ++col) {
+                ret(first + row, col) = block(row, col);
+            }
+        }
+    });
+    return ret;
+}
+
+}
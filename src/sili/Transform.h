@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Solve.h"
+#include "operations.h"
+
+#include <tuple>
+#include <type_traits>
+
+namespace sili {
+
+/*! Affine transformation in 3d
+ * \shortexample sili::Affine3<double>
+ * \group Classes
+ *
+ * \param T type of the elements
+ *
+ * A 4x4 Matrix ``[L t; 0 0 0 1]`` with the storage policy Affine, L is the linear part
+ * and t the translation (see linear() and translation()). It fulfills the _concept::Matrix
+ * concept and can be used like any other Matrix.
+ * The last row is set by every constructor and assignment, it must not be written through
+ * element access. A default constructed transformation is the identity.
+ *
+ * The product of two transformations is composed as 3x4 and is again a transformation,
+ * points (3x1) and homogeneous vectors (4x1) are transformed without the constant row.
+ * inv() inverts only the linear part.
+ *
+ * \code
+ *   auto a = sili::affine(sili::Matrix{{{2., 0., 0.},
+ *                                       {0., 2., 0.},
+ *                                       {0., 0., 2.}}},
+ *                         sili::Matrix{{{1.}, {2.}, {3.}}});
+ *   auto p = a * sili::Matrix{{{1.}, {1.}, {1.}}};
+ *   std::cout << p << "\n"; // prints {{3.}, {4.}, {5.}}
+ * \endcode
+ */
+template <typename T>
+using Affine3 = Matrix<4, 4, T, Affine>;
+
+/*! Rigid transformation in 3d
+ * \shortexample sili::Rigid3<double>
+ * \group Classes
+ *
+ * \param T type of the elements
+ *
+ * An Affine3 whose linear part is a rotation R (orthonormal with determinant 1), it is not checked.
+ * inv() is ``[Rᵀ -Rᵀt; 0 0 0 1]`` and the product of two rigid transformations is rigid.
+ *
+ * \code
+ *   auto r = sili::rigid(sili::Matrix{{{0., -1., 0.},
+ *                                      {1.,  0., 0.},
+ *                                      {0.,  0., 1.}}},
+ *                        sili::Matrix{{{1.}, {0.}, {0.}}});
+ *   auto [d, ri] = inv(r);
+ *   std::cout << translation(ri) << "\n"; // prints {{0.}, {1.}, {0.}}
+ * \endcode
+ */
+template <typename T>
+using Rigid3 = Matrix<4, 4, T, Rigid>;
+
+namespace details {
+template <typename Storage>
+constexpr bool is_transform_storage_v = std::is_same_v<Storage, Affine> or std::is_same_v<Storage, Rigid>;
+
+// rigid if both are rigid, otherwise affine
+template <typename L, typename R>
+using compose_storage_t = std::conditional_t<std::is_same_v<L, Rigid> and std::is_same_v<R, Rigid>, Rigid, Affine>;
+}
+
+/*! Linear part of a transformation
+ * \shortexample linear(m)
+ * \group Free Matrix Functions
+ *
+ * \param m Affine3 or Rigid3
+ * \return  View of the upper left 3x3 block
+ */
+template <typename M> requires (_concept::Matrix<M> and rows_v<M> == 4 and cols_v<M> == 4)
+constexpr auto linear(M&& m) {
+    return view<0, 0, 3, 3>(std::forward<M>(m));
+}
+
+/*! Translation of a transformation
+ * \shortexample translation(m)
+ * \group Free Matrix Functions
+ *
+ * \param m Affine3 or Rigid3
+ * \return  View of the upper right 3x1 block
+ */
+template <typename M> requires (_concept::Matrix<M> and rows_v<M> == 4 and cols_v<M> == 4)
+constexpr auto translation(M&& m) {
+    return view<0, 3, 3, 4>(std::forward<M>(m));
+}
+
+/*! Create an affine transformation
+ * \shortexample affine(l, t)
+ * \group Free Matrix Functions
+ *
+ * \param l _concept::Matrix of size 3x3, the linear part
+ * \param t _concept::Vector of size 3x1, the translation
+ * \return  Affine3
+ */
+template <_concept::Matrix L, _concept::Matrix V> requires (rows_v<L> == 3 and cols_v<L> == 3 and rows_v<V> == 3 and cols_v<V> == 1)
+constexpr auto affine(L const& l, V const& t) {
+    auto ret = Affine3<std::remove_cvref_t<value_t<L>>>{};
+    for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+        for_constexpr<size_t{0}, 3>([&]<size_t col>() {
+            ret.template at<row, col>() = l.template at<row, col>();
+        });
+        ret.template at<row, 3>() = t.template at<row, 0>();
+    });
+    return ret;
+}
+
+/*! Create a rigid transformation
+ * \shortexample rigid(r, t)
+ * \group Free Matrix Functions
+ *
+ * \param r _concept::Matrix of size 3x3, a rotation
+ * \param t _concept::Vector of size 3x1, the translation
+ * \return  Rigid3
+ */
+template <_concept::Matrix L, _concept::Matrix V> requires (rows_v<L> == 3 and cols_v<L> == 3 and rows_v<V> == 3 and cols_v<V> == 1)
+constexpr auto rigid(L const& r, V const& t) {
+    auto ret = Rigid3<std::remove_cvref_t<value_t<L>>>{};
+    for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+        for_constexpr<size_t{0}, 3>([&]<size_t col>() {
+            ret.template at<row, col>() = r.template at<row, col>();
+        });
+        ret.template at<row, 3>() = t.template at<row, 0>();
+    });
+    return ret;
+}
+
+// composition of two transformations, ``[L₁L₂ L₁t₂+t₁]`` as 3x4
+template <typename T, typename SL, typename SR> requires (details::is_transform_storage_v<SL> and details::is_transform_storage_v<SR>)
+constexpr auto operator*(Matrix<4, 4, T, SL> const& l, Matrix<4, 4, T, SR> const& r) {
+    auto ret = Matrix<4, 4, T, details::compose_storage_t<SL, SR>>{};
+    for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+        for_constexpr<size_t{0}, 4>([&]<size_t col>() {
+            auto acc = T{};
+            if constexpr (col == 3) {
+                acc = l.template at<row, 3>();
+            }
+            for_constexpr<size_t{0}, 3>([&]<size_t k>() {
+                acc += l.template at<row, k>() * r.template at<k, col>();
+            });
+            ret.template at<row, col>() = acc;
+        });
+    });
+    return ret;
+}
+
+// transforms points, each column of p is a point (3xN) or a homogeneous vector (4xN)
+template <typename T, typename S, _concept::Matrix P> requires (details::is_transform_storage_v<S> and (rows_v<P> == 3 or rows_v<P> == 4))
+constexpr auto operator*(Matrix<4, 4, T, S> const& l, P const& p) {
+    using U = std::remove_cvref_t<decltype(std::declval<T>() * std::declval<value_t<P>>())>;
+    constexpr auto N = cols_v<P>;
+    auto ret = Matrix<rows_v<P>, N, U>{};
+    for_constexpr<size_t{0}, N>([&]<size_t col>() {
+        // points have an implicit w of 1
+        auto w = U{1};
+        if constexpr (rows_v<P> == 4) {
+            w = p.template at<3, col>();
+            ret.template at<3, col>() = w;
+        }
+        for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+            auto acc = l.template at<row, 3>() * w;
+            for_constexpr<size_t{0}, 3>([&]<size_t k>() {
+                acc += l.template at<row, k>() * p.template at<k, col>();
+            });
+            ret.template at<row, col>() = acc;
+        });
+    });
+    return ret;
+}
+
+/*! Inverse of an affine transformation
+ * \shortexample inv(m)
+ * \group Free Matrix Functions
+ *
+ * \param m Affine3
+ * \return  tuple of the determinant and ``[L⁻¹ -L⁻¹t; 0 0 0 1]``, if the determinant is zero the inverse is invalid
+ */
+template <typename T>
+constexpr auto inv(Affine3<T> const& m) -> std::tuple<T, Affine3<T>> {
+    auto [li, singular] = solve(linear(m), makeI<3, T>());
+    if (all_of(singular)) {
+        return {T{0}, m};
+    }
+    auto ret = Affine3<T>{};
+    linear(ret)      = li;
+    translation(ret) = -(li * translation(m));
+    return {det(linear(m)), ret};
+}
+
+/*! Inverse of a rigid transformation
+ * \shortexample inv(m)
+ * \group Free Matrix Functions
+ *
+ * \param m Rigid3
+ * \return  tuple of 1 and ``[Rᵀ -Rᵀt; 0 0 0 1]``
+ */
+template <typename T>
+constexpr auto inv(Rigid3<T> const& m) -> std::tuple<T, Rigid3<T>> {
+    auto ret = Rigid3<T>{};
+    for_constexpr<size_t{0}, 3>([&]<size_t row>() {
+        auto acc = T{};
+        for_constexpr<size_t{0}, 3>([&]<size_t col>() {
+            ret.template at<row, col>() = m.template at<col, row>();
+            acc -= m.template at<col, row>() * m.template at<col, 3>();
+        });
+        ret.template at<row, 3>() = acc;
+    });
+    return {T{1}, ret};
+}
+
+}
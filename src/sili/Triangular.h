@@ -0,0 +1,297 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "Pack.h"
+#include "View.h"
+#include "concepts.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace sili {
+
+/*! Diagonal of a triangular view
+ * \shortexample sili::tri::Unit
+ *
+ * - NonUnit: the diagonal is part of the triangle
+ * - Unit: the diagonal is one, it is neither read nor written
+ */
+namespace tri {
+struct NonUnit {};
+struct Unit {};
+}
+
+/*! Triangular view onto a matrix
+ * \shortexample sili::TriView<V, Lower, Diag>
+ * \group Classes
+ *
+ * Fulfills the _concept::Expression concept.
+ *
+ * \param V     View type of the whole matrix
+ * \param Lower true for the lower, false for the upper triangle
+ * \param Diag  tri::NonUnit or tri::Unit
+ *
+ * Reads the elements of the triangle from the matrix, the other triangle reads as zero
+ * and a unit diagonal as one. Assignments only write the elements of the triangle.
+ * Created by view_lower_tri() and view_upper_tri(), trsm() solves triangular systems with it.
+ *
+ * \caption Methods
+ * \param matrix() returns the View of the whole matrix
+ * \param t(row,col) value of the element at ``row`` and ``col``
+ */
+template <typename V, bool Lower, typename Diag>
+class TriView {
+    typename V::value_t* mData;
+
+    static constexpr bool unit = std::is_same_v<Diag, tri::Unit>;
+
+    // first and last (exclusive) column of the triangle in a row
+    static constexpr auto begin(size_t row) -> size_t {
+        return Lower ? 0 : std::min(row + (unit ? 1 : 0), V::Cols);
+    }
+    static constexpr auto end(size_t row) -> size_t {
+        return Lower ? std::min(row + (unit ? 0 : 1), V::Cols) : V::Cols;
+    }
+
+    template <typename M>
+    constexpr auto assign(M const& m) -> TriView& {
+        auto v = matrix();
+        for (size_t row{0}; row < Rows; ++row) {
+            for (size_t col{begin(row)}; col < end(row); ++col) {
+                v(row, col) = m(row, col);
+            }
+        }
+        return *this;
+    }
+
+public:
+    using value_t = std::remove_const_t<typename V::value_t>;
+
+    static constexpr size_t Rows         = V::Rows;
+    static constexpr size_t Cols         = V::Cols;
+    static constexpr bool   LowerTri     = Lower;
+    static constexpr bool   UnitDiagonal = unit;
+
+    constexpr TriView(typename V::value_t* _data)
+        : mData{_data}
+    {}
+    constexpr TriView(TriView const&) = default;
+
+    constexpr auto matrix() const {
+        return V{mData};
+    }
+
+    // true if the element is part of the triangle
+    static constexpr bool stored(size_t row, size_t col) {
+        return begin(row) <= col and col < end(row);
+    }
+
+    constexpr auto operator()(size_t row, size_t col) const -> value_t {
+        if (stored(row, col)) {
+            return matrix()(row, col);
+        }
+        return value_t(unit and row == col ? 1 : 0);
+    }
+
+    template <size_t row, size_t col>
+    constexpr auto at() const -> value_t {
+        if constexpr (stored(row, col)) {
+            return matrix().template at<row, col>();
+        } else {
+            return value_t(unit and row == col ? 1 : 0);
+        }
+    }
+
+    constexpr auto operator=(TriView const& t) -> TriView& {
+        return assign(t);
+    }
+    template <typename M> requires ((_concept::Matrix<M> or _concept::Expression<M>) and rows_v<M> == Rows and cols_v<M> == Cols)
+    constexpr auto operator=(M const& m) -> TriView& {
+        return assign(m);
+    }
+    constexpr auto operator=(value_t const& s) -> TriView& {
+        auto v = matrix();
+        for (size_t row{0}; row < Rows; ++row) {
+            for (size_t col{begin(row)}; col < end(row); ++col) {
+                v(row, col) = s;
+            }
+        }
+        return *this;
+    }
+};
+
+template <typename V, bool Lower, typename Diag>
+struct is_expression<TriView<V, Lower, Diag>> : std::true_type {};
+
+namespace details {
+template <typename T>
+constexpr bool is_tri_view_v = false;
+template <typename V, bool Lower, typename Diag>
+constexpr bool is_tri_view_v<TriView<V, Lower, Diag>> = true;
+
+template <typename Diag, bool Lower, _concept::Matrix M>
+constexpr auto view_tri(M&& m) {
+    using V = View<rows_v<M>, cols_v<M>, stride_v<M>, value_t<M>, transposed_v<M>>;
+    return TriView<V, Lower, Diag>{m.data()};
+}
+}
+
+/*! Lower triangular view
+ * \shortexample view_lower_tri(m)
+ * \group Free Matrix Functions
+ *
+ * \param Diag tri::NonUnit (default) or tri::Unit
+ * \param m    _concept::Matrix
+ * \return     TriView of the lower triangle including the diagonal, with a unit diagonal for tri::Unit
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1, 2, 3},
+ *                          {4, 5, 6},
+ *                          {7, 8, 9}}};
+ *   std::cout << sili::Matrix{view_lower_tri(a)} << "\n"; // prints {{1, 0, 0},
+ *                                                                     {4, 5, 0},
+ *                                                                     {7, 8, 9}}
+ *   view_lower_tri<sili::tri::Unit>(a) = 0;
+ *   std::cout << a << "\n"; // prints {{1, 2, 3},
+ *                                      {0, 5, 6},
+ *                                      {0, 0, 9}}
+ * \endcode
+ */
+template <typename Diag = tri::NonUnit, _concept::Matrix M>
+constexpr auto view_lower_tri(M&& m) {
+    return details::view_tri<Diag, true>(m);
+}
+
+/*! Upper triangular view
+ * \shortexample view_upper_tri(m)
+ * \group Free Matrix Functions
+ *
+ * \param Diag tri::NonUnit (default) or tri::Unit
+ * \param m    _concept::Matrix
+ * \return     TriView of the upper triangle including the diagonal, with a unit diagonal for tri::Unit
+ *
+ * The upper triangle of a transposed view is the transposed lower triangle,
+ * ``view_upper_tri(view_trans(l))`` is ``Lᵀ`` without a copy.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1, 2, 3},
+ *                          {4, 5, 6},
+ *                          {7, 8, 9}}};
+ *   std::cout << sili::Matrix{view_upper_tri<sili::tri::Unit>(a)} << "\n"; // prints {{1, 2, 3},
+ *                                                                                     {0, 1, 6},
+ *                                                                                     {0, 0, 1}}
+ * \endcode
+ */
+template <typename Diag = tri::NonUnit, _concept::Matrix M>
+constexpr auto view_upper_tri(M&& m) {
+    return details::view_tri<Diag, false>(m);
+}
+
+/*! Triangular solve in place
+ * \shortexample trsm_into(x, t)
+ * \group Matrix Operations
+ *
+ * \param Policy unroll::Auto (default), unroll::Always or unroll::Never
+ * \param x      _concept::Matrix, holds b and is overwritten by the solution, e.g. a Matrix or a View
+ * \param t      TriView of a square matrix, see view_lower_tri() and view_upper_tri()
+ *
+ * Solves ``t * x = b`` by forward (lower) or back (upper) substitution, the zero triangle is never
+ * read. Each row of x is divided by the diagonal of t with a single division, a zero diagonal
+ * gives inf or nan, it is not checked. x must not overlap with the matrix of t.
+ * The substitution is unrolled at compile time according to Policy, Auto unrolls systems with up to
+ * SILI_UNROLL_LIMIT multiply-adds.
+ *
+ * \code
+ *   auto l = sili::Matrix{{{2., 0.},
+ *                          {1., 4.}}};
+ *   auto x = sili::Matrix{{{2.}, {5.}}};
+ *   sili::trsm_into(x, view_lower_tri(l));
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <typename Policy = unroll::Auto, _concept::Matrix X, typename T>
+    requires (details::is_tri_view_v<T> and rows_v<T> == cols_v<T> and rows_v<X> == rows_v<T>)
+constexpr void trsm_into(X&& x, T const& t) {
+    using R = std::remove_cvref_t<value_t<X>>;
+    constexpr auto N     = rows_v<T>;
+    constexpr auto C     = cols_v<X>;
+    constexpr auto lower = T::LowerTri;
+    constexpr auto unit  = T::UnitDiagonal;
+    auto a = t.matrix();
+
+    if constexpr (details::unrolled_v<Policy, N * (N - 1) / 2 * C>) {
+        for_constexpr<size_t{0}, N>([&]<size_t i>() {
+            constexpr auto row = lower ? i : N - 1 - i;
+            for_constexpr<lower ? size_t{0} : row + 1, lower ? row : N>([&]<size_t k>() {
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() - a.template at<row, k>() * x.template at<k, col>();
+                });
+            });
+            if constexpr (not unit) {
+                auto invDiag = R{1} / a.template at<row, row>();
+                for_constexpr<size_t{0}, C>([&]<size_t col>() {
+                    x.template at<row, col>() = x.template at<row, col>() * invDiag;
+                });
+            }
+        });
+    } else {
+        for (size_t i{0}; i < N; ++i) {
+            auto row = lower ? i : N - 1 - i;
+            for (size_t k{lower ? 0 : row + 1}; k < (lower ? row : N); ++k) {
+                for (size_t col{0}; col < C; ++col) {
+                    x(row, col) = x(row, col) - a(row, k) * x(k, col);
+                }
+            }
+            if constexpr (not unit) {
+                auto invDiag = R{1} / a(row, row);
+                for (size_t col{0}; col < C; ++col) {
+                    x(row, col) = x(row, col) * invDiag;
+                }
+            }
+        }
+    }
+}
+
+/*! Triangular solve
+ * \shortexample trsm(t, b)
+ * \group Matrix Operations
+ *
+ * \param Policy unroll::Auto (default), unroll::Always or unroll::Never
+ * \param t      TriView of a square matrix, see view_lower_tri() and view_upper_tri()
+ * \param b      _concept::Matrix with as many rows as t, a vector or multiple right hand sides
+ * \return       Matrix x solving ``t * x = b``, see trsm_into()
+ *
+ * Integer matrices are solved as double.
+ *
+ * \code
+ *   auto u = sili::Matrix{{{2., 1.},
+ *                          {0., 4.}}};
+ *   auto x = trsm(view_upper_tri(u), sili::Matrix{{{3.}, {4.}}});
+ *   std::cout << x << "\n"; // prints {{1.}, {1.}}
+ *
+ *   // Lᵀ * x = b with the lower triangular L of a Cholesky factorization
+ *   auto l = sili::Matrix{{{2., 0.},
+ *                          {1., 4.}}};
+ *   auto y = trsm(view_upper_tri(view_trans(l)), sili::Matrix{{{3.}, {4.}}});
+ *   std::cout << y << "\n"; // prints {{1.}, {1.}}
+ * \endcode
+ */
+template <typename Policy = unroll::Auto, typename T, _concept::Matrix B>
+    requires (details::is_tri_view_v<T> and rows_v<T> == cols_v<T> and rows_v<B> == rows_v<T>)
+constexpr auto trsm(T const& t, B const& b) {
+    using V = std::remove_cvref_t<decltype(std::declval<typename T::value_t>() * std::declval<value_t<B>>())>;
+    using R = std::conditional_t<std::is_floating_point_v<lane_t<V>>, V, double>;
+    auto x = Matrix<rows_v<B>, cols_v<B>, R>{};
+    for (size_t row{0}; row < rows_v<B>; ++row) {
+        for (size_t col{0}; col < cols_v<B>; ++col) {
+            x(row, col) = R(b(row, col));
+        }
+    }
+    trsm_into<Policy>(x, t);
+    return x;
+}
+
+}
@@ -97,15 +97,24 @@ public:
 
 
     constexpr auto operator=(T const& s) -> View& {
-        for_each_constexpr<View>([&]<size_t row, size_t col>() constexpr {
-            at<row, col>() = s;
+        for_each_index<View>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = s;
         });
         return *this;
     }
     template <_concept::Matrix V>
     constexpr auto operator=(V const& v) -> View& requires (Rows == V::Rows and Cols == V::Cols) {
-        for_each_constexpr<View>([&]<size_t row, size_t col>() constexpr {
-            at<row, col>() = v.template at<row, col>();
+        for_each_index<View>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = v(row, col);
+        });
+        return *this;
+    }
+
+    // evaluates all elements of the expression in a single pass
+    template <_concept::Expression E>
+    constexpr auto operator=(E const& e) -> View& requires (Rows == E::Rows and Cols == E::Cols) {
+        for_each_index<View>([&](size_t row, size_t col) constexpr {
+            (*this)(row, col) = e(row, col);
         });
         return *this;
     }
@@ -119,4 +128,10 @@ View(Matrix<_rows, _cols, T>&) -> View<_rows, _cols, _cols, T, false>;
 template <size_t _rows, size_t _cols, typename T>
 View(Matrix<_rows, _cols, T> const&) -> View<_rows, _cols, _cols, T const, false>;
 
+template <size_t _rows, size_t _cols, typename T, typename Storage>
+View(Matrix<_rows, _cols, T, Storage>&) -> View<_rows, _cols, Matrix<_rows, _cols, T, Storage>::Stride, T, false>;
+
+template <size_t _rows, size_t _cols, typename T, typename Storage>
+View(Matrix<_rows, _cols, T, Storage> const&) -> View<_rows, _cols, Matrix<_rows, _cols, T, Storage>::Stride, T const, false>;
+
 }
@@ -19,14 +19,14 @@ class View;
 template <typename T>
 struct is_matrix : std::false_type {};
 
-template<size_t _rows, size_t _cols, typename T>
-struct is_matrix<Matrix<_rows, _cols, T>> : std::true_type {};
-template<size_t _rows, size_t _cols, typename T>
-struct is_matrix<Matrix<_rows, _cols, T>&> : std::true_type {};
-template<size_t _rows, size_t _cols, typename T>
-struct is_matrix<Matrix<_rows, _cols, T>&&> : std::true_type {};
-template<size_t _rows, size_t _cols, typename T>
-struct is_matrix<Matrix<_rows, _cols, T> const&> : std::true_type {};
+template<size_t _rows, size_t _cols, typename T, typename... Storage>
+struct is_matrix<Matrix<_rows, _cols, T, Storage...>> : std::true_type {};
+template<size_t _rows, size_t _cols, typename T, typename... Storage>
+struct is_matrix<Matrix<_rows, _cols, T, Storage...>&> : std::true_type {};
+template<size_t _rows, size_t _cols, typename T, typename... Storage>
+struct is_matrix<Matrix<_rows, _cols, T, Storage...>&&> : std::true_type {};
+template<size_t _rows, size_t _cols, typename T, typename... Storage>
+struct is_matrix<Matrix<_rows, _cols, T, Storage...> const&> : std::true_type {};
 
 template <typename T>
 constexpr bool is_matrix_v = is_matrix<T>::value;
@@ -47,6 +47,44 @@ struct is_view<View<_rows, _cols, _stride, T, _transposed> const&> : std::true_t
 template <typename T>
 constexpr bool is_view_v = is_view<T>::value;
 
+template <typename T>
+class DynMatrix;
+
+template <typename T>
+class DynView;
+
+template <size_t MaxRows, size_t MaxCols, typename T>
+class BoundedMatrix;
+
+template <typename T>
+struct is_dyn_matrix : std::false_type {};
+template <typename T>
+struct is_dyn_matrix<DynMatrix<T>> : std::true_type {};
+template <typename T>
+struct is_dyn_matrix<DynView<T>> : std::true_type {};
+template <size_t MaxRows, size_t MaxCols, typename T>
+struct is_dyn_matrix<BoundedMatrix<MaxRows, MaxCols, T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_dyn_matrix_v = is_dyn_matrix<std::remove_cvref_t<T>>::value;
+
+template <size_t N, typename T>
+class SymMatrix;
+
+template <typename T>
+struct is_sym_matrix : std::false_type {};
+template <size_t N, typename T>
+struct is_sym_matrix<SymMatrix<N, T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_sym_matrix_v = is_sym_matrix<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+struct is_expression : std::false_type {};
+
+template <typename T>
+constexpr bool is_expression_v = is_expression<std::remove_cvref_t<T>>::value;
+
 namespace _concept {
 /*! Concept of a _concept::Matrix.
  * \shortexample _concept::Matrix
@@ -58,6 +96,33 @@ namespace _concept {
 template <typename T>
 concept Matrix = is_matrix_v<T> or is_view_v<T>;
 
+/*! Concept of a _concept::Expression.
+ * \shortexample _concept::Expression
+ *
+ * Abstract concept of a lazy elementwise expression, as created by lazy().
+ * It has the dimensions of a matrix and gives read access to its elements.
+ * Evaluating it happens when assigning it to a _concept::Matrix.
+ */
+template <typename T>
+concept Expression = is_expression_v<T>;
+
+/*! Concept of a _concept::DynMatrix.
+ * \shortexample _concept::DynMatrix
+ *
+ * Abstract concept of a matrix whose size is only known at runtime. This can be a DynMatrix, a DynView or a BoundedMatrix.
+ */
+template <typename T>
+concept DynMatrix = is_dyn_matrix_v<T>;
+
+/*! Concept of a _concept::SymMatrix.
+ * \shortexample _concept::SymMatrix
+ *
+ * A symmetric matrix with packed storage, a SymMatrix. It has the dimensions of a matrix and
+ * element access, but no strided data like a _concept::Matrix.
+ */
+template <typename T>
+concept SymMatrix = is_sym_matrix_v<T>;
+
 }
 // value_t for finding the underlying value
 namespace detail {
@@ -72,6 +137,8 @@ template <_concept::Matrix V>
 struct value_t<V&&> : std::type_identity<typename V::value_t> {};
 template <_concept::Matrix V>
 struct value_t<V const&> : std::type_identity<const typename V::value_t> {};
+template <_concept::SymMatrix S>
+struct value_t<S> : std::type_identity<typename std::remove_cvref_t<S>::value_t> {};
 }
 
 template <typename T>
@@ -85,11 +152,16 @@ template <_concept::Matrix V> struct rows<V&> : std::integral_constant<size_t, V
 template <_concept::Matrix V> struct rows<V&&> : std::integral_constant<size_t, V::Rows> {};
 template <_concept::Matrix V> struct rows<V const&> : std::integral_constant<size_t, V::Rows> {};
 
+template <_concept::Expression E> struct rows<E> : std::integral_constant<size_t, std::remove_cvref_t<E>::Rows> {};
+template <_concept::SymMatrix S> struct rows<S> : std::integral_constant<size_t, std::remove_cvref_t<S>::Rows> {};
+
 template <typename T> struct cols;
 template <_concept::Matrix V> struct cols<V> : std::integral_constant<size_t, V::Cols> {};
 template <_concept::Matrix V> struct cols<V&> : std::integral_constant<size_t, V::Cols> {};
 template <_concept::Matrix V> struct cols<V&&> : std::integral_constant<size_t, V::Cols> {};
 template <_concept::Matrix V> struct cols<V const&> : std::integral_constant<size_t, V::Cols> {};
+template <_concept::Expression E> struct cols<E> : std::integral_constant<size_t, std::remove_cvref_t<E>::Cols> {};
+template <_concept::SymMatrix S> struct cols<S> : std::integral_constant<size_t, std::remove_cvref_t<S>::Cols> {};
 
 template <typename T> struct stride;
 template <_concept::Matrix V> struct stride<V> : std::integral_constant<size_t, V::Stride> {};
@@ -127,71 +199,121 @@ constexpr size_t length_v = ((detail::rows<T>::value==1)?detail::cols<T>::value:
 
 
 namespace details {
-// !TODO for_constexpr, is there a standard solution?
-template <auto Iter, auto End, typename L>
-constexpr bool for_constexpr_impl(L const& lambda) {
-    if constexpr(Iter != End) {
-        auto r = lambda.template operator()<Iter>();
-        if (not r) {
-            return false;
-        }
-        return for_constexpr_impl<Iter+1, End>(lambda);
+// calls lambda.operator()<Begin + I>() for all I, && evaluates from left to right and stops at the first false
+template <auto Begin, typename L, size_t... I>
+constexpr bool for_constexpr_seq(L& lambda, std::index_sequence<I...>) {
+    using R = decltype(lambda.template operator()<Begin>());
+    if constexpr (std::is_same_v<R, void>) {
+        (lambda.template operator()<Begin + static_cast<decltype(Begin)>(I)>(), ...);
+        return true;
+    } else {
+        return (static_cast<bool>(lambda.template operator()<Begin + static_cast<decltype(Begin)>(I)>()) && ...);
     }
-    return true;
 }
 }
 
+/* Calls lambda.operator()<Iter>() for each Iter in [Begin, End)
+ *
+ * Unrolled at compile time by a single fold expression, the number of nested
+ * template instantiations does not grow with End - Begin.
+ * If lambda returns a bool, the iteration stops at the first false and false is returned.
+ */
 template <auto Begin, auto End, typename L>
 constexpr bool for_constexpr(L&& lambda) {
     if constexpr (Begin == End) {
         return true;
     } else {
-        using R = decltype(std::declval<L>().template operator()<Begin>());
-        if constexpr (std::is_same_v<R, void>) {
-            return details::for_constexpr_impl<Begin, End>([&]<auto Iter>() {
-                lambda.template operator()<Iter>();
-                return std::true_type{};
-            });
-        } else {
-            return details::for_constexpr_impl<Begin, End>(lambda);
-        }
+        return details::for_constexpr_seq<Begin>(lambda, std::make_index_sequence<End - Begin>{});
     }
 }
 
-
-
 namespace details {
-// !TODO for_each_constexpr, is there a standard solution?
-template <_concept::Matrix V, typename L>
-constexpr void for_each_constexpr_void(L&& lambda) {
-    for_constexpr<0, rows_v<V>>([&]<auto row>() constexpr {
-        for_constexpr<0, cols_v<V>>([&]<auto col>() constexpr {
-            lambda.template operator()<row, col>();
-        });
-    });
-}
-template <_concept::Matrix V, typename L>
-constexpr bool for_each_constexpr_bool(L&& lambda) {
-    return for_constexpr<0, rows_v<V>>([&]<auto row>() constexpr {
-        return for_constexpr<0, cols_v<V>>([&]<auto col>() constexpr {
-            return lambda.template operator()<row, col>();
-        });
-    });
+// one fold over the columns of row Row
+template <size_t Row, typename L, size_t... Col>
+constexpr bool for_each_constexpr_row(L& lambda, std::index_sequence<Col...>) {
+    using R = decltype(lambda.template operator()<size_t{0}, size_t{0}>());
+    if constexpr (std::is_same_v<R, void>) {
+        (lambda.template operator()<Row, Col>(), ...);
+        return true;
+    } else {
+        return (static_cast<bool>(lambda.template operator()<Row, Col>()) && ...);
+    }
 }
 
+// one fold over the rows, each fold has at most max(rows, cols) terms,
+// which stays below the nesting limits of compilers
+template <_concept::Matrix V, typename L, size_t... Row>
+constexpr bool for_each_constexpr_rows(L& lambda, std::index_sequence<Row...>) {
+    return (for_each_constexpr_row<Row>(lambda, std::make_index_sequence<cols_v<V>>{}) && ...);
+}
 }
+
+/* Calls lambda.operator()<row, col>() for each element of V, row by row
+ *
+ * If lambda returns a bool, the iteration stops at the first false and false is returned.
+ */
 template <_concept::Matrix V, typename L>
 constexpr bool for_each_constexpr(L&& lambda) {
     if constexpr (rows_v<V> == 0 or cols_v<V> == 0) {
         return true;
     } else {
-        using R = decltype(std::declval<L>().template operator()<0, 0>());
-        if constexpr (std::is_same_v<R, void>) {
-            details::for_each_constexpr_void<V>(std::forward<L>(lambda));
-            return true;
-        } else {
-            return details::for_each_constexpr_bool<V>(std::forward<L>(lambda));
+        return details::for_each_constexpr_rows<V>(lambda, std::make_index_sequence<rows_v<V>>{});
+    }
+}
+
+// element wise loops over matrices with more elements than SILI_UNROLL_LIMIT are not unrolled
+#ifndef SILI_UNROLL_LIMIT
+#define SILI_UNROLL_LIMIT 16
+#endif
+
+/*! Unroll policies of for_each_index()
+ * \shortexample sili::unroll::Auto
+ *
+ * - Auto: unrolled at compile time up to SILI_UNROLL_LIMIT elements, a rolled loop above
+ * - Always: always unrolled at compile time
+ * - Never: always a rolled loop, the compiler is free to vectorize it
+ */
+namespace unroll {
+struct Auto {};
+struct Always {};
+struct Never {};
+}
+
+namespace details {
+template <typename Policy, size_t Elements>
+constexpr bool unrolled_v = std::is_same_v<Policy, unroll::Always>
+                            or (std::is_same_v<Policy, unroll::Auto> and Elements <= SILI_UNROLL_LIMIT);
+}
+
+/* Calls lambda(row, col) for each element of V
+ *
+ * Unrolled at compile time or as a rolled loop, depending on Policy.
+ * Transposed views are traversed column by column, so the inner loop runs over contiguous elements.
+ * If lambda returns a bool, the iteration stops at the first false and false is returned.
+ */
+template <_concept::Matrix V, typename Policy = unroll::Auto, typename L>
+constexpr bool for_each_index(L&& lambda) {
+    using R = decltype(lambda(size_t{}, size_t{}));
+    if constexpr (details::unrolled_v<Policy, rows_v<V> * cols_v<V>>) {
+        return for_each_constexpr<V>([&]<size_t row, size_t col>() constexpr {
+            return lambda(row, col);
+        });
+    } else {
+        constexpr auto transposed = transposed_v<V>;
+        constexpr auto outer      = transposed ? cols_v<V> : rows_v<V>;
+        constexpr auto inner      = transposed ? rows_v<V> : cols_v<V>;
+        for (size_t i{0}; i < outer; ++i) {
+            for (size_t j{0}; j < inner; ++j) {
+                auto row = transposed ? j : i;
+                auto col = transposed ? i : j;
+                if constexpr (std::is_same_v<R, void>) {
+                    lambda(row, col);
+                } else if (not lambda(row, col)) {
+                    return false;
+                }
+            }
         }
+        return true;
     }
 }
 
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Matrix.h"
+#include "View.h"
+#include "operations.h"
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+namespace sili {
+namespace details {
+
+// read only access to the data of a view, views can not be copied from const
+template <_concept::Matrix V>
+struct ViewOperand {
+    using view_t = View<rows_v<V>, cols_v<V>, stride_v<V>, std::remove_const_t<value_t<V>> const, transposed_v<V>>;
+    typename view_t::value_t* data;
+
+    template <size_t row, size_t col>
+    constexpr auto at() const -> auto const& {
+        return view_t{data}.template at<row, col>();
+    }
+    constexpr auto operator()(size_t row, size_t col) const -> auto const& {
+        return get(view_t{data}, row, col);
+    }
+};
+
+// operands of an expression:
+// - lvalue matrices are referenced
+// - rvalue matrices, expressions and scalars are stored by value
+// - views are stored as read only pointer to their data
+template <typename T>
+struct expression_operand : std::type_identity<std::remove_cvref_t<T>> {};
+
+template <_concept::Matrix M> requires (is_matrix_v<M> and std::is_lvalue_reference_v<M>)
+struct expression_operand<M> : std::type_identity<std::remove_reference_t<M> const&> {};
+
+template <_concept::Matrix V> requires (is_view_v<V>)
+struct expression_operand<V> : std::type_identity<ViewOperand<std::remove_cvref_t<V>>> {};
+
+template <typename T>
+using expression_operand_t = typename expression_operand<T>::type;
+
+template <typename T>
+constexpr auto make_expression_operand(T&& t) -> expression_operand_t<T&&> {
+    if constexpr (is_view_v<T>) {
+        return {t.data()};
+    } else {
+        return std::forward<T>(t);
+    }
+}
+
+template <typename T>
+constexpr bool is_elementwise_v = _concept::Matrix<T> or _concept::Expression<T>;
+
+// element type of an operand when evaluated
+template <typename T>
+struct expression_element : std::type_identity<T> {};
+template <_concept::Matrix M>
+struct expression_element<M> : std::type_identity<std::remove_cvref_t<value_t<M>>> {};
+template <typename T> requires (_concept::Expression<T>)
+struct expression_element<T> : std::type_identity<typename std::remove_cvref_t<T>::value_t> {};
+template <typename V>
+struct expression_element<ViewOperand<V>> : std::type_identity<std::remove_cvref_t<value_t<V>>> {};
+
+template <typename T>
+constexpr size_t expression_rows = 0;
+template <typename T> requires (is_elementwise_v<T>)
+constexpr size_t expression_rows<T> = rows_v<T>;
+template <typename V>
+constexpr size_t expression_rows<ViewOperand<V>> = rows_v<V>;
+
+template <typename T>
+constexpr size_t expression_cols = 0;
+template <typename T> requires (is_elementwise_v<T>)
+constexpr size_t expression_cols<T> = cols_v<T>;
+template <typename V>
+constexpr size_t expression_cols<ViewOperand<V>> = cols_v<V>;
+
+/* Lazy elementwise expression
+ *
+ * Stores an operator and its operands, elements are only computed on access.
+ * Operands are _concept::Matrix, nested expressions or scalars.
+ */
+template <typename Operator, typename... Operands>
+class Expression {
+    Operator                 op;
+    std::tuple<Operands...>  operands;
+
+    // element of an operand, scalars are the same for all elements
+    template <size_t row, size_t col, typename O>
+    static constexpr auto element(O const& o) -> decltype(auto) {
+        if constexpr (not requires { o.template at<row, col>(); }) {
+            return o;
+        } else {
+            return o.template at<row, col>();
+        }
+    }
+
+    template <typename O>
+    static constexpr auto element(O const& o, size_t row, size_t col) -> decltype(auto) {
+        if constexpr (not requires { o(row, col); }) {
+            return o;
+        } else {
+            return o(row, col);
+        }
+    }
+
+public:
+    using value_t = std::remove_cvref_t<std::invoke_result_t<Operator const&, typename expression_element<std::remove_cvref_t<Operands>>::type...>>;
+
+    static constexpr size_t Rows = std::max({expression_rows<std::remove_cvref_t<Operands>>...});
+    static constexpr size_t Cols = std::max({expression_cols<std::remove_cvref_t<Operands>>...});
+
+    template <typename... Args>
+    constexpr Expression(Operator _op, Args&&... _operands)
+        : op{_op}
+        , operands{std::forward<Args>(_operands)...}
+    {}
+
+    template <size_t row, size_t col>
+    constexpr auto at() const -> value_t {
+        return std::apply([&](auto const&... o) constexpr {
+            return op(element<row, col>(o)...);
+        }, operands);
+    }
+
+    constexpr auto operator()(size_t row, size_t col) const -> value_t {
+        return std::apply([&](auto const&... o) constexpr {
+            return op(element(o, row, col)...);
+        }, operands);
+    }
+};
+
+template <typename Operator, typename... Args>
+constexpr auto make_expression(Operator op, Args&&... args) {
+    return Expression<Operator, expression_operand_t<Args&&>...>{op, make_expression_operand(std::forward<Args>(args))...};
+}
+
+// two operands that can be combined elementwise, at least one must be an expression
+template <typename L, typename R>
+concept ExpressionOperands = (_concept::Expression<L> or _concept::Expression<R>)
+                             and is_elementwise_v<L> and is_elementwise_v<R>
+                             and rows_v<L> == rows_v<R> and cols_v<L> == cols_v<R>;
+}
+
+template <typename Operator, typename... Operands>
+struct is_expression<details::Expression<Operator, Operands...>> : std::true_type {};
+
+/*! Lazy expression
+ * \shortexample lazy(m)
+ * \group Matrix Operations
+ *
+ * \param m _concept::Matrix or _concept::Expression
+ * \return  _concept::Expression referring to m
+ *
+ * Elementwise operations (``+``, ``-``, scalar ``*`` and ``/``) on a lazy expression
+ * do not compute anything, they create a new expression.
+ * The whole expression is evaluated in a single pass when it is assigned to a
+ * Matrix or View, no temporary matrices are created.
+ * lvalue matrices are referenced and must outlive the expression.
+ * The destination must not be a transposed or shifted view of an operand.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1., 2.},
+ *                          {3., 4.}}};
+ *   auto b = sili::Matrix{{{5., 6.},
+ *                          {7., 8.}}};
+ *   auto c = sili::Matrix<2, 2, double>{};
+ *   c = lazy(a) + b - lazy(a) * 2.;
+ *   std::cout << c << "\n"; // prints {{4., 4.},
+ *                                      {4., 4.}}
+ * \endcode
+ */
+template <typename M> requires (details::is_elementwise_v<M>)
+constexpr auto lazy(M&& m) {
+    return details::make_expression([](auto e) constexpr { return e; }, std::forward<M>(m));
+}
+
+/*! Evaluate expression
+ * \shortexample eval(e)
+ * \group Matrix Operations
+ *
+ * \param e _concept::Expression
+ * \return  Matrix with all elements of e
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1., 2.},
+ *                          {3., 4.}}};
+ *   auto c = eval(lazy(a) * 2. + a);
+ *   std::cout << c << "\n"; // prints {{3.,  6.},
+ *                                      {9., 12.}}
+ * \endcode
+ */
+template <_concept::Expression E>
+constexpr auto eval(E const& e) {
+    return Matrix{e};
+}
+
+template <_concept::Expression E>
+constexpr auto operator+(E&& e) {
+    return details::make_expression([](auto _e) constexpr { return +_e; }, std::forward<E>(e));
+}
+
+template <_concept::Expression E>
+constexpr auto operator-(E&& e) {
+    return details::make_expression([](auto _e) constexpr { return -_e; }, std::forward<E>(e));
+}
+
+template <typename L, typename R> requires details::ExpressionOperands<L, R>
+constexpr auto operator+(L&& l, R&& r) {
+    return details::make_expression([](auto _l, auto _r) constexpr { return _l + _r; }, std::forward<L>(l), std::forward<R>(r));
+}
+
+template <typename L, typename R> requires details::ExpressionOperands<L, R>
+constexpr auto operator-(L&& l, R&& r) {
+    return details::make_expression([](auto _l, auto _r) constexpr { return _l - _r; }, std::forward<L>(l), std::forward<R>(r));
+}
+
+template <_concept::Expression E>
+constexpr auto operator*(E&& e, typename std::remove_cvref_t<E>::value_t const& s) {
+    return details::make_expression([](auto _e, auto _s) constexpr { return _e * _s; }, std::forward<E>(e), s);
+}
+
+template <_concept::Expression E>
+constexpr auto operator*(typename std::remove_cvref_t<E>::value_t const& s, E&& e) {
+    return details::make_expression([](auto _s, auto _e) constexpr { return _s * _e; }, s, std::forward<E>(e));
+}
+
+template <_concept::Expression E>
+constexpr auto operator/(E&& e, typename std::remove_cvref_t<E>::value_t const& s) {
+    return details::make_expression([](auto _e, auto _s) constexpr { return _e / _s; }, std::forward<E>(e), s);
+}
+
+template <_concept::Matrix L, _concept::Expression E> requires (rows_v<L> == rows_v<E> and cols_v<L> == cols_v<E>)
+constexpr auto operator+=(L&& l, E const& e) -> auto& {
+    details::self_assign_apply(l, e, [](auto& _l, auto _r) constexpr { _l += _r; });
+    return l;
+}
+
+template <_concept::Matrix L, _concept::Expression E> requires (rows_v<L> == rows_v<E> and cols_v<L> == cols_v<E>)
+constexpr auto operator-=(L&& l, E const& e) -> auto& {
+    details::self_assign_apply(l, e, [](auto& _l, auto _r) constexpr { _l -= _r; });
+    return l;
+}
+
+}
@@ -0,0 +1,406 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.h"
+#include "storage.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace sili {
+namespace details {
+
+// vector register type of a given width, only available for compilers with vector extensions
+#if defined(__GNUC__) || defined(__clang__)
+#define SILI_HAS_VECTOR_EXTENSIONS 1
+template <typename T, size_t Bytes = simd_register_bytes>
+struct simd_register {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+template <typename T, size_t Bytes = simd_register_bytes>
+using simd_register_t = typename simd_register<T, Bytes>::type;
+
+// unaligned vector register type, used to load and store from arrays of T
+template <typename T, size_t Bytes = simd_register_bytes>
+struct simd_unaligned {
+    typedef T type __attribute__((vector_size(Bytes), aligned(alignof(T)), may_alias));
+};
+
+template <typename T, size_t Bytes>
+inline auto simd_load(T const* p) -> simd_register_t<T, Bytes> {
+    return *reinterpret_cast<typename simd_unaligned<T, Bytes>::type const*>(p);
+}
+template <typename T, size_t Bytes>
+inline void simd_store(T* p, simd_register_t<T, Bytes> v) {
+    *reinterpret_cast<typename simd_unaligned<T, Bytes>::type*>(p) = v;
+}
+
+// sum of all lanes, the register is folded in halves
+template <typename T, size_t Bytes>
+inline auto simd_reduce_add(simd_register_t<T, Bytes> v) -> T {
+    if constexpr (Bytes == sizeof(T)) {
+        return v[0];
+    } else {
+        using H = simd_register_t<T, Bytes / 2>;
+        auto lo = H{};
+        auto hi = H{};
+        std::memcpy(&lo, &v, Bytes / 2);
+        std::memcpy(&hi, reinterpret_cast<char const*>(&v) + Bytes / 2, Bytes / 2);
+        return simd_reduce_add<T, Bytes / 2>(lo + hi);
+    }
+}
+
+template <typename T>
+inline constexpr bool has_simd_register_v = std::is_arithmetic_v<T>
+                                            and not std::is_same_v<T, bool>
+                                            and simd_lanes<T> > 1;
+#else
+template <typename T>
+inline constexpr bool has_simd_register_v = false;
+#endif
+
+// register block of the gemm micro kernel:
+// gemm_mr rows of C times gemm_nv vector registers of columns are accumulated in registers.
+// 4 rows times 3 vector registers keeps 12 accumulators alive, which fits
+// into the 16 vector registers of SSE/AVX/NEON
+inline constexpr size_t gemm_mr = 4;
+inline constexpr size_t gemm_nv = 3;
+
+/* Scalar micro kernel
+ *
+ * Computes C[MR×NR] = alpha * A[MR×K] * B[K×NR] + beta * C[MR×NR], C is not read if beta is zero.
+ * B and C are row major with the row strides ldb and ldc, element A[i][p] is ``a[i * lda + p * csa]``.
+ * Used during constant evaluation and for types without vector registers.
+ */
+template <size_t MR, size_t NR, size_t K, typename TC, typename TA, typename TB>
+constexpr void gemm_micro_kernel_scalar(TA const* a, size_t lda, TB const* b, size_t ldb, TC* c, size_t ldc,
+                                        size_t csa = 1, TC alpha = TC{1}, TC beta = TC{0}) {
+    for (size_t i{0}; i < MR; ++i) {
+        for (size_t j{0}; j < NR; ++j) {
+            auto acc = TC{};
+            for (size_t p{0}; p < K; ++p) {
+                acc += a[i * lda + p * csa] * b[p * ldb + j];
+            }
+            c[i * ldc + j] = beta == TC{0} ? alpha * acc : alpha * acc + beta * c[i * ldc + j];
+        }
+    }
+}
+
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+/* Register blocked SIMD micro kernel
+ *
+ * Computes C[MR×NV*lanes] = alpha * A[MR×K] * B[K×NV*lanes] + beta * C using vector registers of Bytes width,
+ * C is not read if beta is zero.
+ * Each row of C is kept in NV vector registers, every element of A is
+ * broadcast once and multiplied with NV vector registers loaded from a row of B.
+ * Element A[i][p] is ``a[i * lda + p * csa]``, so A can be a transposed view, only B and C are read as vectors.
+ */
+template <size_t MR, size_t NV, size_t K, size_t Bytes, typename T>
+inline void gemm_micro_kernel_simd(T const* a, size_t lda, T const* b, size_t ldb, T* c, size_t ldc,
+                                   size_t csa = 1, T alpha = T{1}, T beta = T{0}) {
+    using V = simd_register_t<T, Bytes>;
+    constexpr auto L = Bytes / sizeof(T);
+
+    V acc[MR][NV] {};
+    for (size_t p{0}; p < K; ++p) {
+        V bv[NV];
+        for (size_t v{0}; v < NV; ++v) {
+            bv[v] = simd_load<T, Bytes>(b + p * ldb + v * L);
+        }
+        for (size_t i{0}; i < MR; ++i) {
+            auto ai = a[i * lda + p * csa];
+            for (size_t v{0}; v < NV; ++v) {
+                acc[i][v] += ai * bv[v];
+            }
+        }
+    }
+    for (size_t i{0}; i < MR; ++i) {
+        for (size_t v{0}; v < NV; ++v) {
+            auto ci = c + i * ldc + v * L;
+            if (beta == T{0}) {
+                simd_store<T, Bytes>(ci, alpha * acc[i][v]);
+            } else {
+                simd_store<T, Bytes>(ci, alpha * acc[i][v] + beta * simd_load<T, Bytes>(ci));
+            }
+        }
+    }
+}
+
+/* Computes a row block C[MR×N] = alpha * A[MR×K] * B[K×N] + beta * C[MR×N]
+ *
+ * Columns are covered by micro kernels with vector registers of Bytes width,
+ * the remaining columns are handled by narrower registers and finally by scalar code.
+ */
+template <size_t MR, size_t N, size_t K, size_t Bytes, typename T>
+inline void gemm_row_block(T const* a, size_t lda, T const* b, size_t ldb, T* c, size_t ldc, size_t csa, T alpha, T beta) {
+    constexpr auto L = Bytes / sizeof(T);
+    if constexpr (N == 0) {
+        return;
+    } else if constexpr (L < 2) {
+        gemm_micro_kernel_scalar<MR, N, K>(a, lda, b, ldb, c, ldc, csa, alpha, beta);
+    } else if constexpr (N < L) {
+        gemm_row_block<MR, N, K, Bytes / 2>(a, lda, b, ldb, c, ldc, csa, alpha, beta);
+    } else {
+        constexpr auto NV = std::min(N / L, gemm_nv); // vector registers per row
+        constexpr auto NR = NV * L;                   // columns per register block
+        for_constexpr<0, N / NR>([&]<size_t J>() {
+            gemm_micro_kernel_simd<MR, NV, K, Bytes>(a, lda, b + J * NR, ldb, c + J * NR, ldc, csa, alpha, beta);
+        });
+        constexpr auto tail = N - N % NR;
+        gemm_row_block<MR, N % NR, K, Bytes>(a, lda, b + tail, ldb, c + tail, ldc, csa, alpha, beta);
+    }
+}
+
+/* SIMD matrix vector micro kernel
+ *
+ * Computes y[MR] = alpha * A[MR×K] * x[K] + beta * y[MR] for a row major A and a contiguous x,
+ * y is not read if beta is zero.
+ * The rows are reduced in vector registers of Bytes width, the MR rows share each load of x.
+ */
+template <size_t MR, size_t K, size_t Bytes, typename T>
+inline void gemv_micro_kernel_simd(T const* a, size_t lda, T const* x, T* y, size_t incy, T alpha, T beta) {
+    using V = simd_register_t<T, Bytes>;
+    constexpr auto L  = Bytes / sizeof(T);
+    constexpr auto KV = K - K % L;
+
+    V acc[MR] {};
+    for (size_t p{0}; p < KV; p += L) {
+        auto xv = simd_load<T, Bytes>(x + p);
+        for (size_t i{0}; i < MR; ++i) {
+            acc[i] += simd_load<T, Bytes>(a + i * lda + p) * xv;
+        }
+    }
+    for (size_t i{0}; i < MR; ++i) {
+        auto s = simd_reduce_add<T, Bytes>(acc[i]);
+        for (size_t p{KV}; p < K; ++p) {
+            s += a[i * lda + p] * x[p];
+        }
+        y[i * incy] = beta == T{0} ? alpha * s : alpha * s + beta * y[i * incy];
+    }
+}
+
+// row block of gemv_fixed, registers are narrowed until K fills at least one of them
+template <size_t MR, size_t K, size_t Bytes, typename T>
+inline void gemv_row_block(T const* a, size_t lda, T const* x, T* y, size_t incy, T alpha, T beta) {
+    constexpr auto L = Bytes / sizeof(T);
+    if constexpr (L < 2) {
+        gemm_micro_kernel_scalar<MR, 1, K>(a, lda, x, 1, y, incy, 1, alpha, beta);
+    } else if constexpr (K < L) {
+        gemv_row_block<MR, K, Bytes / 2>(a, lda, x, y, incy, alpha, beta);
+    } else {
+        gemv_micro_kernel_simd<MR, K, Bytes>(a, lda, x, y, incy, alpha, beta);
+    }
+}
+
+// cache blocking of the packed gemm for runtime sized matrices, in elements:
+// a packed kc×NR panel of B stays in L1, the packed mc×kc block of A in L2
+// and the packed kc×nc block of B in L3
+inline constexpr size_t gemm_kc = 256;
+inline constexpr size_t gemm_mc = 24 * gemm_mr;
+inline constexpr size_t gemm_nc = 2048;
+
+// runtime sized products with fewer multiply-adds (m*n*k) are not worth packing
+inline constexpr size_t gemm_packed_min = 48 * 48 * 48;
+
+// read only operand of the packed gemm, element (row, col) is at data[row * rowStride + col * colStride]
+template <typename T>
+struct gemm_operand {
+    T const* data;
+    size_t   rowStride;
+    size_t   colStride;
+
+    auto operator()(size_t row, size_t col) const -> T const& {
+        return data[row * rowStride + col * colStride];
+    }
+    auto block(size_t row, size_t col) const -> gemm_operand {
+        return {&(*this)(row, col), rowStride, colStride};
+    }
+};
+
+/* Packed SIMD micro kernel
+ *
+ * Computes C[mr×nr] += A[MR×kc] * B[kc×NV*lanes] with the register block of gemm_micro_kernel_simd.
+ * a and b are packed panels, each step of the depth holds MR elements of a and NV*lanes elements of b.
+ * Only the first mr rows and nr columns of the register block are written to C.
+ */
+template <size_t MR, size_t NV, size_t Bytes, typename T>
+inline void gemm_micro_kernel_packed(size_t kc, T const* a, T const* b, T* c, size_t ldc, size_t mr, size_t nr) {
+    using V = simd_register_t<T, Bytes>;
+    constexpr auto L  = Bytes / sizeof(T);
+    constexpr auto NR = NV * L;
+
+    V acc[MR][NV] {};
+    for (size_t p{0}; p < kc; ++p) {
+        V bv[NV];
+        for (size_t v{0}; v < NV; ++v) {
+            bv[v] = simd_load<T, Bytes>(b + p * NR + v * L);
+        }
+        for (size_t i{0}; i < MR; ++i) {
+            auto ai = a[p * MR + i];
+            for (size_t v{0}; v < NV; ++v) {
+                acc[i][v] += ai * bv[v];
+            }
+        }
+    }
+    if (mr == MR and nr == NR) {
+        for (size_t i{0}; i < MR; ++i) {
+            for (size_t v{0}; v < NV; ++v) {
+                auto ci = c + i * ldc + v * L;
+                simd_store<T, Bytes>(ci, simd_load<T, Bytes>(ci) + acc[i][v]);
+            }
+        }
+    } else {
+        for (size_t i{0}; i < mr; ++i) {
+            for (size_t j{0}; j < nr; ++j) {
+                c[i * ldc + j] += acc[i][j / L][j % L];
+            }
+        }
+    }
+}
+
+// packs A[mc×kc] into panels of MR rows, rows beyond mc are zero
+template <size_t MR, typename T>
+void gemm_pack_a(gemm_operand<T> a, size_t mc, size_t kc, T* pack) {
+    for (size_t ir{0}; ir < mc; ir += MR) {
+        auto mr = std::min(MR, mc - ir);
+        for (size_t p{0}; p < kc; ++p) {
+            for (size_t i{0}; i < MR; ++i) {
+                *pack++ = i < mr ? a(ir + i, p) : T{};
+            }
+        }
+    }
+}
+
+// packs B[kc×nc] into panels of NR columns, columns beyond nc are zero
+template <size_t NR, typename T>
+void gemm_pack_b(gemm_operand<T> b, size_t kc, size_t nc, T* pack) {
+    for (size_t jr{0}; jr < nc; jr += NR) {
+        auto nr = std::min(NR, nc - jr);
+        for (size_t p{0}; p < kc; ++p) {
+            if (nr == NR and b.colStride == 1) {
+                std::copy_n(&b(p, jr), NR, pack);
+            } else {
+                for (size_t j{0}; j < NR; ++j) {
+                    pack[j] = j < nr ? b(p, jr + j) : T{};
+                }
+            }
+            pack += NR;
+        }
+    }
+}
+
+template <typename T>
+inline constexpr size_t gemm_nr = gemm_nv * (simd_register_bytes / sizeof(T));
+
+// elements of the packing buffers of gemm_packed
+inline auto gemm_pack_a_size(size_t m, size_t k) -> size_t {
+    return std::min(gemm_mc, (m + gemm_mr - 1) / gemm_mr * gemm_mr) * std::min(gemm_kc, k);
+}
+template <typename T>
+auto gemm_pack_b_size(size_t n, size_t k) -> size_t {
+    constexpr auto NR = gemm_nr<T>;
+    return (std::min(gemm_nc, n) + NR - 1) / NR * NR * std::min(gemm_kc, k);
+}
+
+/* Packed and cache blocked matrix multiplication
+ *
+ * Computes C[m×n] += A[m×k] * B[k×n], C is row major with the row stride ldc.
+ * Blocks of A and B are copied into packA and packB (see gemm_pack_a_size() and gemm_pack_b_size()),
+ * so the micro kernel reads both operands contiguously, independent of their strides.
+ * C must not alias A or B.
+ */
+template <typename T>
+void gemm_packed(size_t m, size_t n, size_t k, gemm_operand<T> a, gemm_operand<T> b, T* c, size_t ldc, T* packA, T* packB) {
+    constexpr auto MR = gemm_mr;
+    constexpr auto NR = gemm_nr<T>;
+    for (size_t jc{0}; jc < n; jc += gemm_nc) {
+        auto nc = std::min(gemm_nc, n - jc);
+        for (size_t pc{0}; pc < k; pc += gemm_kc) {
+            auto kc = std::min(gemm_kc, k - pc);
+            gemm_pack_b<NR>(b.block(pc, jc), kc, nc, packB);
+            for (size_t ic{0}; ic < m; ic += gemm_mc) {
+                auto mc = std::min(gemm_mc, m - ic);
+                gemm_pack_a<MR>(a.block(ic, pc), mc, kc, packA);
+                for (size_t jr{0}; jr < nc; jr += NR) {
+                    for (size_t ir{0}; ir < mc; ir += MR) {
+                        gemm_micro_kernel_packed<MR, gemm_nv, simd_register_bytes>(kc, packA + ir * kc, packB + jr * kc,
+                                                                                   c + (ic + ir) * ldc + jc + jr, ldc,
+                                                                                   std::min(MR, mc - ir), std::min(NR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+#endif
+
+/* Fixed size matrix multiplication
+ *
+ * Computes C[M×N] = alpha * A[M×K] * B[K×N] + beta * C[M×N] with row major B and C,
+ * element A[i][p] is ``a[i * lda + p * csa]``. C is not read if beta is zero.
+ * A is row major for csa == 1 and a transposed view for lda == 1.
+ * C is tiled into register blocks, all tile sizes (including the tails) are known at compile time.
+ * C must not alias A or B.
+ */
+template <size_t M, size_t N, size_t K, typename TC, typename TA, typename TB>
+constexpr void gemm_fixed(TA const* a, size_t lda, TB const* b, size_t ldb, TC* c, size_t ldc,
+                          size_t csa = 1, TC alpha = TC{1}, TC beta = TC{0}) {
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    if constexpr (std::is_same_v<TA, TC> and std::is_same_v<TB, TC> and has_simd_register_v<TC>) {
+        if (not std::is_constant_evaluated()) {
+            for_constexpr<0, (M + gemm_mr - 1) / gemm_mr>([&]<size_t I>() {
+                constexpr auto mr = std::min(gemm_mr, M - I * gemm_mr);
+                gemm_row_block<mr, N, K, simd_register_bytes>(a + I * gemm_mr * lda, lda, b, ldb, c + I * gemm_mr * ldc, ldc,
+                                                              csa, alpha, beta);
+            });
+            return;
+        }
+    }
+#endif
+    gemm_micro_kernel_scalar<M, N, K>(a, lda, b, ldb, c, ldc, csa, alpha, beta);
+}
+
+// matrix vector products with fewer elements (M*K) are computed by scalar code if x is strided
+inline constexpr size_t gemv_gather_min = 128;
+
+/* Fixed size matrix vector multiplication
+ *
+ * Computes y[M] = alpha * A[M×K] * x[K] + beta * y[M] for a row major A with the row stride lda.
+ * Consecutive elements of x and y are incx and incy apart.
+ * y is not read if beta is zero.
+ * A transposed A is better served by gemm_fixed<1, M, K>, which computes yᵀ = xᵀ * Aᵀ with row major Aᵀ.
+ * y must not alias A or x.
+ */
+template <size_t M, size_t K, typename TY, typename TA, typename TX>
+constexpr void gemv_fixed(TA const* a, size_t lda, TX const* x, size_t incx, TY* y, size_t incy,
+                          TY alpha = TY{1}, TY beta = TY{0}) {
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    if constexpr (std::is_same_v<TA, TY> and std::is_same_v<TX, TY> and has_simd_register_v<TY>) {
+        // a strided x is gathered once and every row block loads it as vectors,
+        // which only pays off for larger matrices
+        if (not std::is_constant_evaluated() and (incx == 1 or M * K >= gemv_gather_min)) {
+            auto xc = std::array<TY, K>{};
+            if (incx != 1) {
+                for (size_t p{0}; p < K; ++p) {
+                    xc[p] = x[p * incx];
+                }
+                x = xc.data();
+            }
+            for_constexpr<0, (M + gemm_mr - 1) / gemm_mr>([&]<size_t I>() {
+                constexpr auto mr = std::min(gemm_mr, M - I * gemm_mr);
+                gemv_row_block<mr, K, simd_register_bytes>(a + I * gemm_mr * lda, lda, x, y + I * gemm_mr * incy, incy,
+                                                           alpha, beta);
+            });
+            return;
+        }
+    }
+#endif
+    gemm_micro_kernel_scalar<M, 1, K>(a, lda, x, incx, y, incy, 1, alpha, beta);
+}
+
+}
+}
@@ -4,9 +4,14 @@
 #pragma once
 
 #include "concepts.h"
+#include "gemm.h"
+#include "LU.h"
+#include "Pack.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <tuple>
 
 namespace sili {
@@ -114,12 +119,27 @@ constexpr auto cols(M const&) {
 }
 
 namespace details {
+// same matrix type with other dimensions and same storage policy
+template <typename M, size_t Rows, size_t Cols>
+struct rebind_matrix;
+template <size_t R, size_t C, typename T, typename... Storage, size_t Rows, size_t Cols>
+struct rebind_matrix<Matrix<R, C, T, Storage...>, Rows, Cols> : std::type_identity<Matrix<Rows, Cols, T, Storage...>> {};
+
+template <typename M, size_t Rows, size_t Cols>
+using rebind_matrix_t = typename rebind_matrix<std::remove_cvref_t<M>, Rows, Cols>::type;
+
+// true if both are matrices with the same element type and the same padded storage policy
+template <typename L, typename R>
+constexpr bool same_padded_storage_v = false;
+template <size_t R1, size_t C1, size_t R2, size_t C2, typename T, typename Storage>
+constexpr bool same_padded_storage_v<Matrix<R1, C1, T, Storage>, Matrix<R2, C2, T, Storage>> = is_padded_storage_v<Storage>;
+
 template <_concept::Matrix V, typename Operator>
 constexpr auto apply(V const& v, Operator op) {
     using U = decltype(op(value<V>()));
     auto ret = Matrix<rows_v<V>, cols_v<V>, U>{};
-    for_each_constexpr<V>([&]<auto row, auto col>() {
-        at<row, col>(ret) = op(at<row, col>(v));
+    for_each_index<V>([&](size_t row, size_t col) {
+        ret(row, col) = op(v(row, col));
     });
     return ret;
 }
@@ -128,25 +148,24 @@ template <_concept::Matrix L, _concept::Matrix R, typename Operator> requires (r
 constexpr auto apply(L const& l, R const& r, Operator op) {
     using U = decltype(op(value<L>(), value_t<R>()));
     auto ret = Matrix<rows_v<L>, cols_v<L>, U>{};
-    for (size_t iy{0}; iy < rows_v<L>; ++iy) {
-        for (size_t ix{0}; ix < cols_v<L>; ++ix) {
-            ret(iy, ix) = op(l(iy, ix), r(iy, ix));
-        }
-    }
+    for_each_index<L>([&](size_t row, size_t col) {
+        ret(row, col) = op(l(row, col), r(row, col));
+    });
     return ret;
 }
 
 template <_concept::Matrix V, typename Operator>
 constexpr void self_assign_apply(V&& v, Operator op) {
-    for_each_constexpr<V>([&]<auto row, auto col>() {
-        op(at<row, col>(v));
+    for_each_index<V>([&](size_t row, size_t col) {
+        op(v(row, col));
     });
 }
 
-template <_concept::Matrix L, _concept::Matrix R, typename Operator> requires (rows_v<L> == rows_v<R> and cols_v<L> == cols_v<R>)
+template <_concept::Matrix L, typename R, typename Operator>
+    requires ((_concept::Matrix<R> or _concept::Expression<R>) and rows_v<L> == rows_v<R> and cols_v<L> == cols_v<R>)
 constexpr void self_assign_apply(L&& l, R const& r, Operator op) {
-    for_each_constexpr<L>([&]<auto row, auto col>() {
-        op(at<row, col>(l), at<row, col>(r));
+    for_each_index<L>([&](size_t row, size_t col) {
+        op(l(row, col), r(row, col));
     });
 }
 }
@@ -203,6 +222,14 @@ constexpr auto operator+(Matrix<_rows, _cols, T> l, Matrix<_rows, _cols, T> cons
     }
     return l;
 }
+// padded storage, the padding is zero and can be added as well
+template<size_t _rows, size_t _cols, typename T, typename Storage> requires (details::is_padded_storage_v<Storage>)
+constexpr auto operator+(Matrix<_rows, _cols, T, Storage> l, Matrix<_rows, _cols, T, Storage> const& r) {
+    for (size_t i{0}; i < _rows*l.Stride; ++i) {
+        l.data()[i] += r.data()[i];
+    }
+    return l;
+}
 template<size_t _rows, size_t _cols, typename T1, typename T2>
 constexpr auto operator+(Matrix<_rows, _cols, T1> l, Matrix<_rows, _cols, T2> const& r) {
     auto res = Matrix<_rows, _cols, decltype(std::declval<T1>() + std::declval<T2>())>{};
@@ -321,6 +348,8 @@ constexpr auto operator-=(L& l, R const& r) -> auto& {
  * \return Matrix with result of l and r multiplication
  *
  * l must have the same number of columns as r has rows.
+ * Transposed views (view_trans()) select a loop order with contiguous vector loads,
+ * e.g. ``view_trans(a) * a`` does not walk the columns of a.
  *
  * \code
  *   auto a = sili::Matrix{{{3, 4, 7},
@@ -343,7 +372,48 @@ constexpr auto operator*(L const& l, R const& r) {
             ret += l(i) * r(i);
         }
         return Matrix{{{ret}}};
+    } else if constexpr (details::same_padded_storage_v<L, R> and std::is_same_v<U, typename L::value_t>) {
+        // padded rows, the kernel runs over the full stride without any tail handling
+        // (the padding of r is zero and so is the computed padding of ret)
+        auto ret = details::rebind_matrix_t<R, L::Rows, R::Cols>{};
+        details::gemm_fixed<L::Rows, R::Stride, L::Cols>(l.data(), L::Stride,
+                                                         r.data(), R::Stride,
+                                                         ret.data(), ret.Stride);
+        return ret;
+    } else if constexpr (not transposed_v<L> and not transposed_v<R>) {
+        // row major operands, use the register blocked kernel
+        auto ret = Matrix<L::Rows, R::Cols, U>{};
+        details::gemm_fixed<L::Rows, R::Cols, L::Cols>(l.data(), stride_v<L>,
+                                                       r.data(), stride_v<R>,
+                                                       ret.data(), stride_v<decltype(ret)>);
+        return ret;
+    } else if constexpr (transposed_v<L> and not transposed_v<R> and R::Cols >= details::simd_lanes<U>) {
+        // Aᵀ * B: the kernel broadcasts the elements of l with swapped strides,
+        // the rows of r and of the result stay contiguous
+        auto ret = Matrix<L::Rows, R::Cols, U>{};
+        details::gemm_fixed<L::Rows, R::Cols, L::Cols>(l.data(), 1,
+                                                       r.data(), stride_v<R>,
+                                                       ret.data(), stride_v<decltype(ret)>,
+                                                       stride_v<L>);
+        return ret;
+    } else if constexpr (not transposed_v<L> and transposed_v<R> and L::Rows >= 8 and R::Cols >= details::simd_lanes<U>) {
+        // A * Bᵀ: the kernel loads rows of r as vectors, r is copied to row major once,
+        // the copy only pays off if it is used for enough rows
+        auto rr  = Matrix<R::Rows, R::Cols, std::remove_cvref_t<typename R::value_t>>{r};
+        auto ret = Matrix<L::Rows, R::Cols, U>{};
+        details::gemm_fixed<L::Rows, R::Cols, L::Cols>(l.data(), stride_v<L>,
+                                                       rr.data(), stride_v<decltype(rr)>,
+                                                       ret.data(), stride_v<decltype(ret)>);
+        return ret;
+    } else if constexpr (transposed_v<L> and transposed_v<R> and R::Cols >= 8 and L::Rows >= details::simd_lanes<U>) {
+        // Aᵀ * Bᵀ = (B * A)ᵀ, the matrices viewed by r and l are both row major
+        auto d = Matrix<R::Cols, L::Rows, U>{};
+        details::gemm_fixed<R::Cols, L::Rows, L::Cols>(r.data(), stride_v<R>,
+                                                       l.data(), stride_v<L>,
+                                                       d.data(), stride_v<decltype(d)>);
+        return Matrix<L::Rows, R::Cols, U>{view_trans(d)};
     } else {
+        // small transposed operands, a fully unrolled loop beats packing and partial registers
         auto ret = Matrix<L::Rows, R::Cols, U>{};
         for (size_t iy{0}; iy < L::Rows; ++iy) {
            for (size_t ix{0}; ix < R::Cols; ++ix) {
@@ -358,6 +428,181 @@ constexpr auto operator*(L const& l, R const& r) {
     }
 }
 
+namespace details {
+// true if the elements of l and r may overlap, always true during constant evaluation
+template <_concept::Matrix L, _concept::Matrix R>
+constexpr bool aliases(L const& l, R const& r) {
+    if (std::is_constant_evaluated()) {
+        return true;
+    }
+    if constexpr (not std::is_same_v<std::remove_cv_t<value_t<L>>, std::remove_cv_t<value_t<R>>>) {
+        return false;
+    } else {
+        auto first = [](auto const& m) { return reinterpret_cast<std::uintptr_t>(m.data()); };
+        auto last  = [](auto const& m) {
+            using M = std::remove_cvref_t<decltype(m)>;
+            return reinterpret_cast<std::uintptr_t>(&m(rows_v<M> - 1, cols_v<M> - 1));
+        };
+        return first(l) <= last(r) and first(r) <= last(l);
+    }
+}
+
+// distance between consecutive elements of a vector
+template <_concept::Vector V>
+constexpr size_t vector_inc_v = ((rows_v<V> == 1 and not transposed_v<V>) or (cols_v<V> == 1 and transposed_v<V>)) ? 1 : stride_v<V>;
+}
+
+/*! Matrix multiplication into an existing matrix
+ * \shortexample gemm_into(c, a, b, alpha, beta)
+ * \group Matrix Operations
+ *
+ * \param c     _concept::Matrix, destination, e.g. a Matrix or a (transposed) view
+ * \param a     _concept::Matrix
+ * \param b     _concept::Matrix
+ * \param alpha scalar factor of a * b
+ * \param beta  scalar factor of the old content of c
+ *
+ * Computes ``c = alpha * a * b + beta * c`` and writes the result directly into c, without
+ * a temporary for the product. With ``beta == 0`` the old content of c is not read.
+ * If c overlaps with a or b, the product is formed in a temporary first, so ``gemm_into(a, a, b)`` is valid.
+ * During constant evaluation overlaps can not be detected and the temporary is always used.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{3, 4, 7},
+ *                          {5, 6, 8}}};
+ *   auto b = sili::Matrix{{{1, 2},
+ *                          {4, 5},
+ *                          {3, 6}};
+ *   auto c = sili::Matrix<4, 4, int>{};
+ *   c = 1;
+ *   sili::gemm_into(view<0, 0, 2, 2>(c), a, b, 1, 1); // accumulates a * b into the top left corner
+ *   std::cout << view<0, 0, 2, 2>(c) << "\n"; // prints {{41, 69},
+ *                                              //         {54, 89}}
+ * \endcode
+ */
+template <_concept::Matrix C, _concept::Matrix A, _concept::Matrix B>
+    requires (rows_v<C> == rows_v<A> and cols_v<C> == cols_v<B> and cols_v<A> == rows_v<B>)
+constexpr void gemm_into(C&& c, A const& a, B const& b, value_t<C> alpha = 1, value_t<C> beta = 1) {
+    using T = value_t<C>;
+    if (details::aliases(c, a) or details::aliases(c, b)) {
+        // c is written while a and b are read, the product is formed in a temporary first
+        auto p = a * b;
+        for (size_t row{0}; row < rows_v<C>; ++row) {
+            for (size_t col{0}; col < cols_v<C>; ++col) {
+                c(row, col) = beta == T{0} ? alpha * p(row, col) : alpha * p(row, col) + beta * c(row, col);
+            }
+        }
+    } else if constexpr (not transposed_v<C> and not transposed_v<B>) {
+        // rows of b and c are contiguous, a is broadcast and can be transposed
+        constexpr auto lda = transposed_v<A> ? 1 : stride_v<A>;
+        constexpr auto csa = transposed_v<A> ? stride_v<A> : 1;
+        details::gemm_fixed<rows_v<A>, cols_v<B>, cols_v<A>>(a.data(), lda,
+                                                             b.data(), stride_v<B>,
+                                                             c.data(), stride_v<C>,
+                                                             csa, alpha, beta);
+    } else if constexpr (transposed_v<C> and transposed_v<A> and transposed_v<B>) {
+        // cᵀ = bᵀ * aᵀ, the matrices viewed by c, a and b are all row major
+        details::gemm_fixed<cols_v<B>, rows_v<A>, cols_v<A>>(b.data(), stride_v<B>,
+                                                             a.data(), stride_v<A>,
+                                                             c.data(), stride_v<C>,
+                                                             1, alpha, beta);
+    } else {
+        for (size_t row{0}; row < rows_v<C>; ++row) {
+            for (size_t col{0}; col < cols_v<C>; ++col) {
+                auto acc = T{};
+                for (size_t i{0}; i < cols_v<A>; ++i) {
+                    acc += a(row, i) * b(i, col);
+                }
+                c(row, col) = beta == T{0} ? alpha * acc : alpha * acc + beta * c(row, col);
+            }
+        }
+    }
+}
+
+/*! Matrix multiplication into an existing matrix
+ * \shortexample mul_into(c, a, b)
+ * \group Matrix Operations
+ *
+ * \param c _concept::Matrix, destination, e.g. a Matrix or a (transposed) view
+ * \param a _concept::Matrix
+ * \param b _concept::Matrix
+ *
+ * Same as ``c = a * b`` without the temporary result, see gemm_into().
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1, 2},
+ *                          {3, 4}}};
+ *   auto c = sili::Matrix<2, 4, int>{};
+ *   sili::mul_into(view<0, 2, 2, 4>(c), a, a);
+ *   std::cout << c << "\n"; // prints {{0, 0,  7, 10},
+ *                           //         {0, 0, 15, 22}}
+ * \endcode
+ */
+template <_concept::Matrix C, _concept::Matrix A, _concept::Matrix B>
+    requires (rows_v<C> == rows_v<A> and cols_v<C> == cols_v<B> and cols_v<A> == rows_v<B>)
+constexpr void mul_into(C&& c, A const& a, B const& b) {
+    gemm_into(std::forward<C>(c), a, b, 1, 0);
+}
+
+/*! Matrix vector multiplication into an existing vector
+ * \shortexample gemv_into(y, a, x, alpha, beta)
+ * \group Matrix Operations
+ *
+ * \param y     _concept::Vector, destination, e.g. a column of a matrix
+ * \param a     _concept::Matrix
+ * \param x     _concept::Vector
+ * \param alpha scalar factor of a * x
+ * \param beta  scalar factor of the old content of y
+ *
+ * Computes ``y = alpha * a * x + beta * y``, x and y can be row or column vectors.
+ * Rows of a are reduced with vector registers, for a transposed a the columns of a are
+ * accumulated into y instead. With ``beta == 0`` the old content of y is not read.
+ * If y overlaps with a or x, the product is formed in a temporary first.
+ *
+ * \code
+ *   auto a = sili::Matrix{{{1, 2},
+ *                          {3, 4}}};
+ *   auto y = sili::Matrix{{{1, 1}}};
+ *   sili::gemv_into(y, a, sili::Matrix{{{1}, {2}}}, 2, 1);
+ *   std::cout << y << "\n"; // prints {{11, 23}}
+ * \endcode
+ */
+template <_concept::Vector Y, _concept::Matrix A, _concept::Vector X>
+    requires (length_v<Y> == rows_v<A> and length_v<X> == cols_v<A>)
+constexpr void gemv_into(Y&& y, A const& a, X const& x, value_t<Y> alpha = 1, value_t<Y> beta = 1) {
+    using T = value_t<Y>;
+    constexpr auto M = rows_v<A>;
+    constexpr auto K = cols_v<A>;
+    if (details::aliases(y, a) or details::aliases(y, x)) {
+        // y is written while a and x are read, the product is formed in a temporary first
+        auto p = std::array<T, M>{};
+        for (size_t row{0}; row < M; ++row) {
+            for (size_t i{0}; i < K; ++i) {
+                p[row] += a(row, i) * x(i);
+            }
+        }
+        for (size_t row{0}; row < M; ++row) {
+            y(row) = beta == T{0} ? alpha * p[row] : alpha * p[row] + beta * y(row);
+        }
+    } else if constexpr (not transposed_v<A>) {
+        details::gemv_fixed<M, K>(a.data(), stride_v<A>,
+                                  x.data(), details::vector_inc_v<X>,
+                                  y.data(), details::vector_inc_v<Y>,
+                                  alpha, beta);
+    } else if constexpr (details::vector_inc_v<Y> == 1) {
+        // yᵀ = xᵀ * aᵀ, the matrix viewed by a is row major
+        details::gemm_fixed<1, M, K>(x.data(), 0,
+                                     a.data(), stride_v<A>,
+                                     y.data(), M,
+                                     details::vector_inc_v<X>, alpha, beta);
+    } else {
+        details::gemm_micro_kernel_scalar<M, 1, K>(a.data(), 1,
+                                                   x.data(), details::vector_inc_v<X>,
+                                                   y.data(), details::vector_inc_v<Y>,
+                                                   stride_v<A>, alpha, beta);
+    }
+}
+
 /*! Scalar multiplication
  * \shortexample l * s
  * \group Matrix Operations
@@ -490,9 +735,12 @@ constexpr auto operator/=(L&& l, value_t<L> const& s) -> L& {
  */
 template <_concept::Matrix L, _concept::Matrix R> requires (L::Rows == R::Rows and L::Cols == R::Cols)
 constexpr auto operator==(L const& l, R const& r) -> bool {
-    return for_each_constexpr<L>([&]<int row, int col>() {
-        return at<row, col>(l) == at<row, col>(r);
+    // all elements are compared without early exit, counting keeps the loop vectorizable
+    auto differ = size_t{0};
+    for_each_index<L>([&](size_t row, size_t col) {
+        differ += l(row, col) != r(row, col);
     });
+    return differ == 0;
 }
 
 /*! Elementwise comparision
@@ -743,28 +991,102 @@ constexpr auto join_cols(L const& l, R const& r) {
     return matrix;
 }
 
-// !TODO needs unit tests
-// lu decomposition, returns L value
-template<_concept::Matrix V> requires (rows_v<V> == cols_v<V>)
-constexpr auto luDecomposition_L(V const& v) {
-    using T = std::decay_t<value_t<V>>;
-
-    constexpr auto N = rows_v<V>;
-    auto L = Matrix<N, N, T>{};
-
-    for_constexpr<0, N>([&]<auto K>() {
-        auto kRow = view_row<K>(L);
-        auto kCol = view_col<K>(L);
-        for_constexpr<K, N>([&]<auto I>() {
-            at<K, I>(L) = at<K, I>(v) - T{kRow * view_col<I>(L)};
-        });
-        for_constexpr<K+1, N>([&]<auto I>() {
-            at<I, K>(L) = (at<I, K>(v) - T{view_row<I>(L) * kCol}) / at<K, K>(L);
-        });
-    });
-    return L;
+namespace details {
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+// float and double are processed with vector registers of 4 lanes,
+// if 4 lanes fit into one register of the target (double needs AVX)
+template <typename T>
+constexpr bool has_simd4_v = (std::is_same_v<T, float> or std::is_same_v<T, double>)
+                             and 4 * sizeof(T) <= simd_register_bytes;
+
+template <typename M>
+constexpr bool has_simd4x4_v = rows_v<M> == 4 and cols_v<M> == 4 and not transposed_v<M>
+                               and has_simd4_v<std::remove_cvref_t<value_t<M>>>;
+
+template <typename T>
+using simd4_t = simd_register_t<T, 4 * sizeof(T)>;
+
+template <int... I, typename V>
+inline auto simd_permute(V v) -> V {
+    return __builtin_shufflevector(v, v, I...);
+}
+
+// columns of a row major 4x4 matrix, transposed with shuffles
+template <typename T>
+inline auto simd_load_cols4x4(T const* m, size_t stride) -> std::array<simd4_t<T>, 4> {
+    auto r0 = simd_load<T, 4 * sizeof(T)>(m);
+    auto r1 = simd_load<T, 4 * sizeof(T)>(m + stride);
+    auto r2 = simd_load<T, 4 * sizeof(T)>(m + 2 * stride);
+    auto r3 = simd_load<T, 4 * sizeof(T)>(m + 3 * stride);
+    auto t0 = __builtin_shufflevector(r0, r1, 0, 4, 1, 5);
+    auto t1 = __builtin_shufflevector(r2, r3, 0, 4, 1, 5);
+    auto t2 = __builtin_shufflevector(r0, r1, 2, 6, 3, 7);
+    auto t3 = __builtin_shufflevector(r2, r3, 2, 6, 3, 7);
+    return {__builtin_shufflevector(t0, t1, 0, 1, 4, 5),
+            __builtin_shufflevector(t0, t1, 2, 3, 6, 7),
+            __builtin_shufflevector(t2, t3, 0, 1, 4, 5),
+            __builtin_shufflevector(t2, t3, 2, 3, 6, 7)};
+}
+
+/* 2x2 minors of two columns lo and hi
+ * The lanes of each register select the rows of the minors with the patterns
+ * P = {1, 0, 0, 0}, Q = {2, 2, 1, 1} and R = {3, 3, 3, 2}, the three registers
+ * hold the minors of the rows (Q, R), (P, R) and (P, Q).
+ */
+template <typename T>
+inline auto simd_minors4x4(simd4_t<T> lo, simd4_t<T> hi) -> std::array<simd4_t<T>, 3> {
+    auto loP = simd_permute<1, 0, 0, 0>(lo);
+    auto loQ = simd_permute<2, 2, 1, 1>(lo);
+    auto loR = simd_permute<3, 3, 3, 2>(lo);
+    auto hiP = simd_permute<1, 0, 0, 0>(hi);
+    auto hiQ = simd_permute<2, 2, 1, 1>(hi);
+    auto hiR = simd_permute<3, 3, 3, 2>(hi);
+    return {loQ * hiR - loR * hiQ,
+            loP * hiR - loR * hiP,
+            loP * hiQ - loQ * hiP};
+}
+
+// one row of the adjugate, x is the column that is expanded against the minors of the other two
+template <typename T>
+inline auto simd_cofactors4x4(simd4_t<T> x, std::array<simd4_t<T>, 3> const& minors) -> simd4_t<T> {
+    auto sign = simd4_t<T>{1, -1, 1, -1};
+    return sign * (simd_permute<1, 0, 0, 0>(x) * minors[0]
+                 - simd_permute<2, 2, 1, 1>(x) * minors[1]
+                 + simd_permute<3, 3, 3, 2>(x) * minors[2]);
+}
+
+template <typename T>
+inline auto simd_det4x4(T const* m, size_t stride) -> T {
+    auto c   = simd_load_cols4x4(m, stride);
+    auto adj = simd_cofactors4x4<T>(c[1], simd_minors4x4<T>(c[2], c[3]));
+    auto d   = adj * c[0];
+    return (d[0] + d[1]) + (d[2] + d[3]);
 }
 
+// writes the adjugate of m into adj and returns the determinant
+template <typename T>
+inline auto simd_adjugate4x4(T const* m, size_t stride, T* adj, size_t adjStride) -> T {
+    auto c    = simd_load_cols4x4(m, stride);
+    auto low  = simd_minors4x4<T>(c[2], c[3]);
+    auto high = simd_minors4x4<T>(c[0], c[1]);
+    auto a0 =  simd_cofactors4x4<T>(c[1], low);
+    auto a1 = -simd_cofactors4x4<T>(c[0], low);
+    auto a2 =  simd_cofactors4x4<T>(c[3], high);
+    auto a3 = -simd_cofactors4x4<T>(c[2], high);
+    simd_store<T, 4 * sizeof(T)>(adj, a0);
+    simd_store<T, 4 * sizeof(T)>(adj + adjStride, a1);
+    simd_store<T, 4 * sizeof(T)>(adj + 2 * adjStride, a2);
+    simd_store<T, 4 * sizeof(T)>(adj + 3 * adjStride, a3);
+    auto d = a0 * c[0];
+    return (d[0] + d[1]) + (d[2] + d[3]);
+}
+#else
+template <typename T>
+constexpr bool has_simd4_v = false;
+template <typename M>
+constexpr bool has_simd4x4_v = false;
+#endif
+}
 
 // compute 1x1 determinant
 template <_concept::Matrix V> requires (V::Rows == 1 and V::Cols == 1)
@@ -789,6 +1111,28 @@ constexpr auto det(V const& v) {
             + at<0, 0>(v)*at<1, 2>(v)*at<2, 1>(v));
 }
 
+// compute 4x4 determinant, laplace expansion along the first row sharing the 2x2 minors of the last two rows
+template <_concept::Matrix V> requires (V::Rows == 4 and V::Cols == 4)
+constexpr auto det(V const& v) {
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    if constexpr (details::has_simd4x4_v<V>) {
+        if (not std::is_constant_evaluated()) {
+            return details::simd_det4x4(v.data(), stride_v<V>);
+        }
+    }
+#endif
+    auto s01 = at<2, 0>(v)*at<3, 1>(v) - at<2, 1>(v)*at<3, 0>(v);
+    auto s02 = at<2, 0>(v)*at<3, 2>(v) - at<2, 2>(v)*at<3, 0>(v);
+    auto s03 = at<2, 0>(v)*at<3, 3>(v) - at<2, 3>(v)*at<3, 0>(v);
+    auto s12 = at<2, 1>(v)*at<3, 2>(v) - at<2, 2>(v)*at<3, 1>(v);
+    auto s13 = at<2, 1>(v)*at<3, 3>(v) - at<2, 3>(v)*at<3, 1>(v);
+    auto s23 = at<2, 2>(v)*at<3, 3>(v) - at<2, 3>(v)*at<3, 2>(v);
+    return   at<0, 0>(v)*(at<1, 1>(v)*s23 - at<1, 2>(v)*s13 + at<1, 3>(v)*s12)
+           - at<0, 1>(v)*(at<1, 0>(v)*s23 - at<1, 2>(v)*s03 + at<1, 3>(v)*s02)
+           + at<0, 2>(v)*(at<1, 0>(v)*s13 - at<1, 1>(v)*s03 + at<1, 3>(v)*s01)
+           - at<0, 3>(v)*(at<1, 0>(v)*s12 - at<1, 1>(v)*s02 + at<1, 2>(v)*s01);
+}
+
 /*! Compute determinant
  * \shortexample det(m)
  * \group Free Matrix Functions
@@ -802,23 +1146,19 @@ constexpr auto det(V const& v) {
  *   auto v = det(a);
  *   std::cout << v << "\n"; // prints -10
  * \endcode
+ *
+ * Matrices up to 4x4 use closed formulas, larger matrices are factorized (see LU).
  */
-template <_concept::Matrix M> requires (M::Rows == M::Cols and M::Rows > 3)
+template <_concept::Matrix M> requires (M::Rows == M::Cols and M::Rows > 4)
 constexpr auto det(M const& m) {
-    using T = typename M::value_t;
-    auto retValue = T{1};
-
-    auto L        = luDecomposition_L(m);
-
-    for_constexpr<0, M::Rows>([&]<int i>() {
-        retValue *= at<i, i>(L);
-    });
-
-    using std::isfinite;
-    if (not isfinite(retValue)) {
-        retValue = T{0};
+    using T = std::remove_cvref_t<typename M::value_t>;
+    if constexpr (std::is_integral_v<T>) {
+        // integer matrices are factorized in floating point, the determinant is rounded back
+        auto d = LU<M::Rows, double>{m}.det();
+        return static_cast<T>(d < 0. ? d - 0.5 : d + 0.5);
+    } else {
+        return LU{m}.det();
     }
-    return retValue;
 }
 
 //element wise product
@@ -877,8 +1217,8 @@ constexpr auto cross(L const& l, R const& r) {
 template <_concept::Matrix M>
 constexpr auto sum(M const& m) {
     auto acc = value_t<M>{};
-    for_each_constexpr<M>([&]<auto row, auto col>() {
-        acc += at<row, col>(m);
+    for_each_index<M>([&](size_t row, size_t col) {
+        acc += m(row, col);
     });
     return acc;
 }
@@ -933,6 +1273,29 @@ constexpr auto sum_cols(M const& m) {
 }
 
 
+/*! Lane wise selection of matrices
+ * \shortexample select(mask, a, b)
+ * \group Free Matrix Functions
+ *
+ * \param mask Pack<bool, N>
+ * \param a    _concept::Matrix with Pack elements
+ * \param b    _concept::Matrix with Pack elements
+ * \return     Matrix with the lanes of a where mask is set, otherwise the lanes of b
+ *
+ * a and b must have the same dimensions.
+ *
+ * \code
+ *   auto a = sili::MatrixBatch<2, 1, double, 2>{sili::Pack{1., 2.},
+ *                                               sili::Pack{3., 4.}};
+ *   auto b = select(sili::Pack{true, false}, a, -a);
+ *   std::cout << lane(b, 1) << "\n"; // prints {{-2},
+ *                                               {-4}}
+ * \endcode
+ */
+template <size_t N, _concept::Matrix L, _concept::Matrix R> requires (rows_v<L> == rows_v<R> and cols_v<L> == cols_v<R>)
+constexpr auto select(Pack<bool, N> const& mask, L const& a, R const& b) {
+    return details::apply(a, b, [&](auto const& _a, auto const& _b) constexpr { return select(mask, _a, _b); });
+}
 
 // inverse of 1x1
 template <_concept::Matrix V> requires (V::Rows == V::Cols and V::Rows == 1)
@@ -940,12 +1303,17 @@ constexpr auto inv(V v) -> std::tuple<typename V::value_t, V> {
     using T = typename V::value_t;
     using std::abs;
     auto d = det(v);
-    if (abs(d) < 1.e-5) {
+    auto singular = abs(d) < 1.e-5;
+    if (all_of(singular)) {
         return {at<0, 0>(v), v};
     }
 
-    at<0, 0>(v) = T(1) / at<0, 0>(v);
-    return {d, v};
+    auto ret = v;
+    at<0, 0>(ret) = T(1) / at<0, 0>(v);
+    if constexpr (is_pack_v<T>) {
+        return {d, select(singular, v, ret)};
+    }
+    return {d, ret};
 }
 
 // inverse of 2x2
@@ -954,12 +1322,17 @@ constexpr auto inv(V v) -> std::tuple<typename V::value_t, V> {
     using T = typename V::value_t;
     using std::abs;
     auto d = det(v);
-    if (abs(d) < 1.e-5) {
+    auto singular = abs(d) < 1.e-5;
+    if (all_of(singular)) {
         return {at<0, 0>(v), v};
     }
     auto c = T(1) / d;
-    return {d, Matrix{{{ at<1, 1>(v)*c, -at<0, 1>(v)*c},
-                       {-at<1, 0>(v)*c,  at<0, 0>(v)*c}}}};
+    auto ret = Matrix{{{ at<1, 1>(v)*c, -at<0, 1>(v)*c},
+                       {-at<1, 0>(v)*c,  at<0, 0>(v)*c}}};
+    if constexpr (is_pack_v<T>) {
+        return {d, select(singular, v, ret)};
+    }
+    return {d, ret};
 
 }
 
@@ -969,7 +1342,8 @@ constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
     using T = typename M::value_t;
     using std::abs;
     auto d = det(m);
-    if (abs(d) < 1.e-5) {
+    auto singular = abs(d) < 1.e-5;
+    if (all_of(singular)) {
         return {at<0, 0>(m), m};
     }
     auto c = T(1) / d;
@@ -982,6 +1356,68 @@ constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
         auto bl = at<(row+2)%3, (col+1)%3>(m);
         at<col, row>(ret) = (tl*br-tr*bl) * c;
     });
+    if constexpr (is_pack_v<T>) {
+        return {d, select(singular, m, ret)};
+    }
+    return {d, ret};
+}
+
+// inverse of 4x4, adjugate from the 2x2 minors of the first and the last two rows
+template <_concept::Matrix M> requires (M::Rows == M::Cols and M::Rows == 4)
+constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
+    using T = typename M::value_t;
+    using std::abs;
+    auto ret = M{};
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    if constexpr (details::has_simd4x4_v<M>) {
+        if (not std::is_constant_evaluated()) {
+            auto d = details::simd_adjugate4x4(m.data(), stride_v<M>, ret.data(), stride_v<M>);
+            if (abs(d) <= T{0}) {
+                return {T{0}, m};
+            }
+            ret *= T{1} / d;
+            return {d, ret};
+        }
+    }
+#endif
+    auto s0 = at<0, 0>(m)*at<1, 1>(m) - at<1, 0>(m)*at<0, 1>(m);
+    auto s1 = at<0, 0>(m)*at<1, 2>(m) - at<1, 0>(m)*at<0, 2>(m);
+    auto s2 = at<0, 0>(m)*at<1, 3>(m) - at<1, 0>(m)*at<0, 3>(m);
+    auto s3 = at<0, 1>(m)*at<1, 2>(m) - at<1, 1>(m)*at<0, 2>(m);
+    auto s4 = at<0, 1>(m)*at<1, 3>(m) - at<1, 1>(m)*at<0, 3>(m);
+    auto s5 = at<0, 2>(m)*at<1, 3>(m) - at<1, 2>(m)*at<0, 3>(m);
+    auto c0 = at<2, 0>(m)*at<3, 1>(m) - at<3, 0>(m)*at<2, 1>(m);
+    auto c1 = at<2, 0>(m)*at<3, 2>(m) - at<3, 0>(m)*at<2, 2>(m);
+    auto c2 = at<2, 0>(m)*at<3, 3>(m) - at<3, 0>(m)*at<2, 3>(m);
+    auto c3 = at<2, 1>(m)*at<3, 2>(m) - at<3, 1>(m)*at<2, 2>(m);
+    auto c4 = at<2, 1>(m)*at<3, 3>(m) - at<3, 1>(m)*at<2, 3>(m);
+    auto c5 = at<2, 2>(m)*at<3, 3>(m) - at<3, 2>(m)*at<2, 3>(m);
+    auto d = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    auto singular = abs(d) <= T{0};
+    if (all_of(singular)) {
+        return {T{0}, m};
+    }
+    // singular lanes continue with 1, they are replaced by m below
+    auto c = T(1) / select(singular, T{1}, d);
+    at<0, 0>(ret) = ( at<1, 1>(m)*c5 - at<1, 2>(m)*c4 + at<1, 3>(m)*c3) * c;
+    at<0, 1>(ret) = (-at<0, 1>(m)*c5 + at<0, 2>(m)*c4 - at<0, 3>(m)*c3) * c;
+    at<0, 2>(ret) = ( at<3, 1>(m)*s5 - at<3, 2>(m)*s4 + at<3, 3>(m)*s3) * c;
+    at<0, 3>(ret) = (-at<2, 1>(m)*s5 + at<2, 2>(m)*s4 - at<2, 3>(m)*s3) * c;
+    at<1, 0>(ret) = (-at<1, 0>(m)*c5 + at<1, 2>(m)*c2 - at<1, 3>(m)*c1) * c;
+    at<1, 1>(ret) = ( at<0, 0>(m)*c5 - at<0, 2>(m)*c2 + at<0, 3>(m)*c1) * c;
+    at<1, 2>(ret) = (-at<3, 0>(m)*s5 + at<3, 2>(m)*s2 - at<3, 3>(m)*s1) * c;
+    at<1, 3>(ret) = ( at<2, 0>(m)*s5 - at<2, 2>(m)*s2 + at<2, 3>(m)*s1) * c;
+    at<2, 0>(ret) = ( at<1, 0>(m)*c4 - at<1, 1>(m)*c2 + at<1, 3>(m)*c0) * c;
+    at<2, 1>(ret) = (-at<0, 0>(m)*c4 + at<0, 1>(m)*c2 - at<0, 3>(m)*c0) * c;
+    at<2, 2>(ret) = ( at<3, 0>(m)*s4 - at<3, 1>(m)*s2 + at<3, 3>(m)*s0) * c;
+    at<2, 3>(ret) = (-at<2, 0>(m)*s4 + at<2, 1>(m)*s2 - at<2, 3>(m)*s0) * c;
+    at<3, 0>(ret) = (-at<1, 0>(m)*c3 + at<1, 1>(m)*c1 - at<1, 2>(m)*c0) * c;
+    at<3, 1>(ret) = ( at<0, 0>(m)*c3 - at<0, 1>(m)*c1 + at<0, 2>(m)*c0) * c;
+    at<3, 2>(ret) = (-at<3, 0>(m)*s3 + at<3, 1>(m)*s1 - at<3, 2>(m)*s0) * c;
+    at<3, 3>(ret) = ( at<2, 0>(m)*s3 - at<2, 1>(m)*s1 + at<2, 2>(m)*s0) * c;
+    if constexpr (is_pack_v<T>) {
+        return {d, select(singular, m, ret)};
+    }
     return {d, ret};
 }
 
@@ -992,6 +1428,10 @@ constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
  * \param  m _concept::Matrix must have same number of rows as number of cols.
  * \return   Returns tuple of determinant and inverse, if detereminant is zero the inverse is invalid.
  *
+ * For a MatrixBatch the inverse is computed for each lane, lanes with a singular matrix are invalid.
+ * Matrices up to 4x4 use closed formulas, 4x4 matrices of float and double are processed with
+ * vector shuffles. Larger matrices are factorized (see LU).
+ *
  * \code
  *   auto a = sili::Matrix{{{ 1.,  2.},
  *                          {11., 12.}}};
@@ -1001,33 +1441,18 @@ constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
  *                                      { 1.1, -0.1}}
  * \endcode
  */
-template <_concept::Matrix M> requires (M::Rows == M::Cols and M::Rows > 3)
-constexpr auto inv(M m) -> std::tuple<typename M::value_t, M> {
+template <_concept::Matrix M> requires (M::Rows == M::Cols and M::Rows > 4)
+constexpr auto inv(M const& m) -> std::tuple<typename M::value_t, M> {
     using T = typename M::value_t;
-    constexpr int N = M::Rows;
-    auto det        = T{1};
-
-    bool failed{false};
-    for_constexpr<0, N>([&]<int p>() -> bool {
-        auto pivot = at<p, p>(m);
-        det = det * pivot;
-        if (fabs(pivot) < 1.e-5) {
-            failed = true;
-            return false;
-        }
-        view_col<p>(m) /= -pivot;
-        for_each_constexpr<M>([&]<int i, int j>() {
-            if (i == p or j == p) return;
-            at<i, j>(m) += at<p, j>(m) * at<i, p>(m);
-        });
-        view_row<p>(m) /= pivot;
-        at<p, p>(m) = T{1}/ pivot;
-        return true;
-    });
-    if (failed) {
-        return {0., m};
+    auto lu = LU{m};
+    auto singular = lu.singular();
+    if (all_of(singular)) {
+        return {T{0}, m};
+    }
+    if constexpr (is_pack_v<T>) {
+        return {lu.det(), select(singular, m, lu.inverse())};
     }
-    return {det, m};
+    return {lu.det(), lu.inverse()};
 }
 
 /*! Transposed view
@@ -1135,7 +1560,7 @@ constexpr auto makeI() {
 template <_concept::Vector V>
 constexpr auto norm(V const& v) {
     auto acc = value_t<V>{};
-    for_each_constexpr<V>([&]<auto row, auto col>() {
+    for_each_index<V>([&](size_t row, size_t col) {
         acc += v(row, col)*v(row, col);
     });
     using std::sqrt;
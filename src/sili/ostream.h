@@ -17,3 +17,25 @@ auto operator<<(std::ostream& os, V const& v) -> auto& {
     }
     return os;
 }
+
+template <sili::_concept::DynMatrix V>
+auto operator<<(std::ostream& os, V const& v) -> auto& {
+    for (size_t row {0}; row < v.rows(); ++row) {
+        for (size_t col {0}; col < v.cols(); ++col) {
+            os << v(row, col) << " ";
+        }
+        os << "\n";
+    }
+    return os;
+}
+
+template <sili::_concept::SymMatrix V>
+auto operator<<(std::ostream& os, V const& v) -> auto& {
+    for (size_t row {0}; row < sili::rows_v<V>; ++row) {
+        for (size_t col {0}; col < sili::cols_v<V>; ++col) {
+            os << v(row, col) << " ";
+        }
+        os << "\n";
+    }
+    return os;
+}
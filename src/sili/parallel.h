@@ -0,0 +1,470 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "DynMatrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace sili::parallel {
+
+/*! Work stealing thread pool
+ * \shortexample sili::parallel::ThreadPool{4}
+ * \group Classes
+ *
+ * \param concurrency number of threads working on a parallel call, including the calling thread
+ *
+ * Each worker owns a task queue, it takes tasks from the back of its own queue
+ * and steals from the front of the other queues when its own queue is empty.
+ * The thread calling a parallel function works on the tasks as well, until all
+ * tasks of the call are done. This makes nested parallel calls safe.
+ * A pool with a concurrency of 1 runs everything on the calling thread.
+ *
+ * Unlike the rest of sili this header allocates memory and starts threads,
+ * it is not included by sili.h.
+ *
+ * \code
+ *   auto pool = sili::parallel::ThreadPool{4};
+ *   auto ms   = std::vector<sili::Matrix<3, 3, double>>(10'000);
+ *   sili::parallel::for_each(pool, ms, [](auto& m) {
+ *       m = sili::makeI<3, double>();
+ *   });
+ * \endcode
+ */
+class ThreadPool {
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread>            threads;
+
+    std::atomic<size_t>     pending{0}; // tasks in the queues
+    std::atomic<size_t>     nextQueue{0};
+    std::mutex              sleepMutex;
+    std::condition_variable wakeup;
+    bool                    stop{false};
+
+    auto pop(size_t idx) -> std::optional<Task> {
+        auto& q = *queues[idx];
+        auto g = std::lock_guard{q.mutex};
+        if (q.tasks.empty()) {
+            return std::nullopt;
+        }
+        auto task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        pending -= 1;
+        return task;
+    }
+
+    auto steal(size_t idx) -> std::optional<Task> {
+        for (size_t i{1}; i <= queues.size(); ++i) {
+            auto& q = *queues[(idx + i) % queues.size()];
+            auto g = std::lock_guard{q.mutex};
+            if (not q.tasks.empty()) {
+                auto task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                pending -= 1;
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void work(size_t idx) {
+        while (true) {
+            if (auto task = pop(idx); task) {
+                (*task)();
+            } else if (auto task = steal(idx); task) {
+                (*task)();
+            } else {
+                auto g = std::unique_lock{sleepMutex};
+                wakeup.wait(g, [&] { return stop or pending > 0; });
+                if (stop and pending == 0) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void submit(Task task) {
+        auto& q = *queues[nextQueue++ % queues.size()];
+        {
+            auto g = std::lock_guard{q.mutex};
+            q.tasks.push_back(std::move(task));
+            pending += 1;
+        }
+        // taking the lock orders this notification after a concurrent predicate check
+        { auto g = std::lock_guard{sleepMutex}; }
+        wakeup.notify_one();
+    }
+
+public:
+    explicit ThreadPool(size_t concurrency = std::max(1u, std::thread::hardware_concurrency())) {
+        for (size_t i{1}; i < concurrency; ++i) {
+            queues.emplace_back(std::make_unique<Queue>());
+        }
+        for (size_t i{0}; i < queues.size(); ++i) {
+            threads.emplace_back([this, i] { work(i); });
+        }
+    }
+    ThreadPool(ThreadPool const&) = delete;
+    auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+
+    ~ThreadPool() {
+        {
+            auto g = std::lock_guard{sleepMutex};
+            stop = true;
+        }
+        wakeup.notify_all();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // number of threads working on a parallel call, including the calling thread
+    auto concurrency() const -> size_t {
+        return threads.size() + 1;
+    }
+
+    /* Calls body(begin, end) for consecutive chunks of [0, n) with at most grain elements
+     *
+     * Returns after all chunks are done, the first exception thrown by body is rethrown.
+     */
+    template <typename F>
+    void for_range(size_t n, size_t grain, F const& body) {
+        grain = std::max<size_t>(grain, 1);
+        auto chunks = (n + grain - 1) / grain;
+        if (chunks <= 1 or threads.empty()) {
+            for (size_t c{0}; c < chunks; ++c) {
+                body(c * grain, std::min(n, (c + 1) * grain));
+            }
+            return;
+        }
+
+        auto remaining  = std::atomic<size_t>{chunks};
+        auto error      = std::exception_ptr{};
+        auto errorMutex = std::mutex{};
+        auto runChunk = [&](size_t c) {
+            try {
+                body(c * grain, std::min(n, (c + 1) * grain));
+            } catch (...) {
+                auto g = std::lock_guard{errorMutex};
+                if (not error) {
+                    error = std::current_exception();
+                }
+            }
+            if (remaining.fetch_sub(1) == 1) {
+                remaining.notify_all();
+            }
+        };
+        for (size_t c{1}; c < chunks; ++c) {
+            submit([&runChunk, c] { runChunk(c); });
+        }
+        runChunk(0);
+
+        // help with any queued task until all chunks of this call are done
+        for (auto r = remaining.load(); r != 0; r = remaining.load()) {
+            if (auto task = steal(0); task) {
+                (*task)();
+            } else {
+                remaining.wait(r);
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+/*! Default thread pool
+ * \shortexample sili::parallel::default_pool()
+ * \group Free Parallel Functions
+ *
+ * \return ThreadPool using all hardware threads, used by all parallel functions without explicit pool
+ */
+inline auto default_pool() -> ThreadPool& {
+    static auto pool = ThreadPool{};
+    return pool;
+}
+
+namespace details {
+// chunk size for elements of type T:
+// each chunk covers at least 4KiB of elements, so scheduling is cheap compared to
+// tiny per element costs (e.g. 3x3 multiplications), and there are about
+// 4 chunks per thread, so stealing can balance uneven work
+template <typename T>
+auto grain(size_t n, size_t concurrency) -> size_t {
+    auto minGrain = std::max<size_t>(1, 4096 / sizeof(T));
+    auto chunks   = 4 * concurrency;
+    return std::max(minGrain, (n + chunks - 1) / chunks);
+}
+
+template <typename R>
+concept Range = std::ranges::contiguous_range<R> and std::ranges::sized_range<R>;
+
+// runtime sized products with fewer multiply-adds (m*n*k) are computed on the calling thread
+inline constexpr size_t gemm_parallel_min = 128 * 128 * 128;
+
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+// ret = l * r, output tiles of ret are computed by the tasks of pool
+template <_concept::DynMatrix L, _concept::DynMatrix R, typename T>
+void gemm_parallel(ThreadPool& pool, L const& l, R const& r, DynMatrix<T>& ret) {
+    using sili::details::gemm_mr;
+    using sili::details::gemm_mc;
+    using sili::details::gemm_kc;
+    using sili::details::gemm_nr;
+
+    auto m = l.rows();
+    auto n = r.cols();
+    auto k = l.cols();
+
+    // tiles of whole register blocks, smaller tiles if there are not about 4 tiles per thread
+    auto tileRows = gemm_mc;
+    auto tileCols = 16 * gemm_nr<T>;
+    auto tiles    = [&] { return ((m + tileRows - 1) / tileRows) * ((n + tileCols - 1) / tileCols); };
+    while (tiles() < 4 * pool.concurrency() and tileRows > gemm_mr) {
+        tileRows = std::max(gemm_mr, tileRows / 2 / gemm_mr * gemm_mr);
+    }
+    while (tiles() < 4 * pool.concurrency() and tileCols > gemm_nr<T>) {
+        tileCols = std::max(gemm_nr<T>, tileCols / 2 / gemm_nr<T> * gemm_nr<T>);
+    }
+    auto tilesPerRow = (n + tileCols - 1) / tileCols;
+    auto a = sili::details::gemm_operand<T>{l.data(), l.row_stride(), l.col_stride()};
+    auto b = sili::details::gemm_operand<T>{r.data(), r.row_stride(), r.col_stride()};
+
+    // every element of ret is accumulated in the same order as by the serial operator*,
+    // the result does not depend on the tiling nor on the scheduling
+    auto grain = std::max<size_t>(1, tiles() / (4 * pool.concurrency()));
+    pool.for_range(tiles(), grain, [&](size_t begin, size_t end) {
+        auto packA = std::vector<T>(tileRows * std::min(gemm_kc, k));
+        auto packB = std::vector<T>(tileCols * std::min(gemm_kc, k));
+        for (auto tile{begin}; tile < end; ++tile) {
+            auto row  = tile / tilesPerRow * tileRows;
+            auto col  = tile % tilesPerRow * tileCols;
+            auto rows = std::min(tileRows, m - row);
+            auto cols = std::min(tileCols, n - col);
+            sili::details::gemm_packed<T>(rows, cols, k, a.block(row, 0), b.block(0, col),
+                                          ret.data() + row * ret.row_stride() + col, ret.row_stride(),
+                                          packA.data(), packB.data());
+        }
+    });
+}
+#endif
+}
+
+/*! Parallel for each
+ * \shortexample sili::parallel::for_each(pool, r, f)
+ * \group Free Parallel Functions
+ *
+ * \param pool ThreadPool (optional, default_pool() if omitted)
+ * \param r    contiguous range, e.g. std::span<Matrix<…>> or std::vector<MatrixBatch<…>>
+ * \param f    callable, called as ``f(e)`` for each element e of r
+ *
+ * \code
+ *   auto ms = std::vector<sili::Matrix<3, 3, double>>(10'000);
+ *   sili::parallel::for_each(ms, [](auto& m) {
+ *       m = trans(m);
+ *   });
+ * \endcode
+ */
+template <details::Range R, typename F>
+void for_each(ThreadPool& pool, R&& r, F f) {
+    using T = std::ranges::range_value_t<R>;
+    auto data = std::ranges::data(r);
+    auto n    = std::ranges::size(r);
+    pool.for_range(n, details::grain<T>(n, pool.concurrency()), [&](size_t begin, size_t end) {
+        for (auto i{begin}; i < end; ++i) {
+            f(data[i]);
+        }
+    });
+}
+template <details::Range R, typename F>
+void for_each(R&& r, F f) {
+    for_each(default_pool(), std::forward<R>(r), std::move(f));
+}
+
+/*! Parallel transform
+ * \shortexample sili::parallel::transform(pool, in, out, f)
+ * \group Free Parallel Functions
+ *
+ * \param pool ThreadPool (optional, default_pool() if omitted)
+ * \param in   contiguous range
+ * \param out  contiguous range, must have at least as many elements as in
+ * \param f    callable, ``out[i] = f(in[i])``
+ *
+ * \code
+ *   auto ms = std::vector<sili::Matrix<4, 4, double>>(10'000);
+ *   auto ds = std::vector<double>(ms.size());
+ *   sili::parallel::transform(ms, ds, [](auto const& m) {
+ *       return det(m);
+ *   });
+ * \endcode
+ */
+template <details::Range In, details::Range Out, typename F>
+void transform(ThreadPool& pool, In&& in, Out&& out, F f) {
+    using T = std::ranges::range_value_t<In>;
+    auto src = std::ranges::data(in);
+    auto dst = std::ranges::data(out);
+    auto n   = std::ranges::size(in);
+    assert(std::ranges::size(out) >= n);
+    pool.for_range(n, details::grain<T>(n, pool.concurrency()), [&](size_t begin, size_t end) {
+        for (auto i{begin}; i < end; ++i) {
+            dst[i] = f(src[i]);
+        }
+    });
+}
+template <details::Range In, details::Range Out, typename F>
+void transform(In&& in, Out&& out, F f) {
+    transform(default_pool(), std::forward<In>(in), std::forward<Out>(out), std::move(f));
+}
+
+/*! Parallel binary transform
+ * \shortexample sili::parallel::transform(pool, l, r, out, f)
+ * \group Free Parallel Functions
+ *
+ * \param pool ThreadPool (optional, default_pool() if omitted)
+ * \param l    contiguous range
+ * \param r    contiguous range, must have at least as many elements as l
+ * \param out  contiguous range, must have at least as many elements as l
+ * \param f    callable, ``out[i] = f(l[i], r[i])``
+ *
+ * \code
+ *   auto a = std::vector<sili::Matrix<3, 3, float>>(10'000);
+ *   auto b = std::vector<sili::Matrix<3, 3, float>>(10'000);
+ *   auto c = std::vector<sili::Matrix<3, 3, float>>(10'000);
+ *   sili::parallel::transform(a, b, c, [](auto const& l, auto const& r) {
+ *       return l * r;
+ *   });
+ * \endcode
+ */
+template <details::Range L, details::Range R, details::Range Out, typename F>
+void transform(ThreadPool& pool, L&& l, R&& r, Out&& out, F f) {
+    using T = std::ranges::range_value_t<L>;
+    auto src1 = std::ranges::data(l);
+    auto src2 = std::ranges::data(r);
+    auto dst  = std::ranges::data(out);
+    auto n    = std::ranges::size(l);
+    assert(std::ranges::size(r) >= n);
+    assert(std::ranges::size(out) >= n);
+    pool.for_range(n, details::grain<T>(n, pool.concurrency()), [&](size_t begin, size_t end) {
+        for (auto i{begin}; i < end; ++i) {
+            dst[i] = f(src1[i], src2[i]);
+        }
+    });
+}
+template <details::Range L, details::Range R, details::Range Out, typename F>
+void transform(L&& l, R&& r, Out&& out, F f) {
+    transform(default_pool(), std::forward<L>(l), std::forward<R>(r), std::forward<Out>(out), std::move(f));
+}
+
+/*! Parallel transform and reduce
+ * \shortexample sili::parallel::transform_reduce(pool, in, init, reduce, f)
+ * \group Free Parallel Functions
+ *
+ * \param pool   ThreadPool (optional, default_pool() if omitted)
+ * \param in     contiguous range
+ * \param init   initial value
+ * \param reduce associative callable, combines two values
+ * \param f      callable, applied to each element of in
+ * \return       reduction of init and ``f(e)`` for all elements e of in
+ *
+ * Each chunk is reduced on its own, the results of the chunks are combined in order.
+ * The result only depends on the number of elements and the concurrency of the pool,
+ * not on the scheduling.
+ *
+ * \code
+ *   auto vs = std::vector<sili::Matrix<3, 1, double>>(10'000);
+ *   auto s  = sili::parallel::transform_reduce(vs, 0., std::plus{}, [](auto const& v) {
+ *       return norm(v);
+ *   });
+ * \endcode
+ */
+template <details::Range In, typename T, typename Reduce, typename F>
+auto transform_reduce(ThreadPool& pool, In&& in, T init, Reduce reduce, F f) -> T {
+    using E = std::ranges::range_value_t<In>;
+    auto src   = std::ranges::data(in);
+    auto n     = std::ranges::size(in);
+    auto grain = details::grain<E>(n, pool.concurrency());
+    auto parts = std::vector<std::optional<T>>((n + grain - 1) / grain);
+    pool.for_range(n, grain, [&](size_t begin, size_t end) {
+        auto acc = T(f(src[begin]));
+        for (auto i{begin + 1}; i < end; ++i) {
+            acc = reduce(std::move(acc), f(src[i]));
+        }
+        parts[begin / grain] = std::move(acc);
+    });
+    for (auto& p : parts) {
+        init = reduce(std::move(init), std::move(*p));
+    }
+    return init;
+}
+template <details::Range In, typename T, typename Reduce, typename F>
+auto transform_reduce(In&& in, T init, Reduce reduce, F f) -> T {
+    return transform_reduce(default_pool(), std::forward<In>(in), std::move(init), std::move(reduce), std::move(f));
+}
+
+/*! Parallel matrix multiplication
+ * \shortexample sili::parallel::multiply(pool, l, r, serialCutoff)
+ * \group Free Parallel Functions
+ *
+ * \param pool         ThreadPool (optional, default_pool() if omitted)
+ * \param l            _concept::DynMatrix
+ * \param r            _concept::DynMatrix with as many rows as l has columns
+ * \param serialCutoff products with fewer multiply-adds (rows × cols × depth) are computed by ``l * r`` on the calling thread
+ * \return             ``l * r``
+ *
+ * The result is split into tiles, each tile is a task of the work stealing pool and is computed
+ * with the cache blocked kernel of operator*. Each task packs into its own buffers.
+ * The result is bitwise identical to ``l * r``, independent of the concurrency of the pool
+ * and of the scheduling. The thread count is the concurrency of the pool.
+ *
+ * \code
+ *   auto pool = sili::parallel::ThreadPool{8};
+ *   auto a = sili::DynMatrix<double>{2048, 2048};
+ *   auto b = sili::DynMatrix<double>{2048, 2048};
+ *   auto c = sili::parallel::multiply(pool, a, b);
+ * \endcode
+ */
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto multiply(ThreadPool& pool, L const& l, R const& r, size_t serialCutoff = details::gemm_parallel_min) {
+    assert(l.cols() == r.rows());
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+    using U = std::remove_cvref_t<decltype(l * r)>;
+    using T = typename U::value_t;
+    if constexpr (std::is_same_v<U, DynMatrix<T>>
+                  and std::is_same_v<sili::details::dyn_value_t<L>, T> and std::is_same_v<sili::details::dyn_value_t<R>, T>
+                  and sili::details::has_simd_register_v<T>) {
+        auto work = l.rows() * r.cols() * l.cols();
+        if (work >= serialCutoff and work >= sili::details::gemm_packed_min and pool.concurrency() > 1) {
+            auto ret = DynMatrix<T>{l.rows(), r.cols(), sili::details::dyn_resource(l, r)};
+            details::gemm_parallel(pool, l, r, ret);
+            return ret;
+        }
+    }
+#endif
+    return l * r;
+}
+template <_concept::DynMatrix L, _concept::DynMatrix R>
+auto multiply(L const& l, R const& r, size_t serialCutoff = details::gemm_parallel_min) {
+    return multiply(default_pool(), l, r, serialCutoff);
+}
+
+}
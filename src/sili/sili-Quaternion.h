@@ -2,239 +2,361 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
-#if 0
 
 #include "sili.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <ranges>
+
 namespace sili {
-    /*
-     * Quaternion
-     *
-     * internal representation sili::Matrix<4, 1>(w, x, y, z)
-     */
-    template <typename T = DefaultType>
-    class Quaternion {
-    private:
-        Matrix<4, 1, T> mValue;
-
-    public:
-        auto real() -> T& {
-            return mValue(0);
-        }
-        auto imag() -> typename Matrix<3, 1, T>::View {
-            return mValue.template view<3, 1>(1, 0);
-        }
 
-        auto real() const -> T const& {
-            return mValue(0);
-        }
-        auto imag() const -> typename Matrix<3, 1, T>::CView {
-            return mValue.template view<3, 1>(1, 0);
-        }
+/*! Quaternion
+ * \shortexample sili::Quaternion<double>
+ * \group Classes
+ *
+ * \param T type of the elements
+ *
+ * Stored as a Matrix<4, 1, T> ``(w, x, y, z)``, w is the real part, ``(x, y, z)`` the imaginary part.
+ * Unit quaternions represent rotations, a default constructed quaternion is the identity.
+ * The Hamilton product uses vector registers of 4 lanes for float and double (double needs AVX),
+ * rotate() does not build the rotation matrix.
+ *
+ * \code
+ *   auto q = sili::Quaternion<double>{std::numbers::pi / 2., sili::Matrix{{{0.}, {0.}, {1.}}}};
+ *   auto v = q.rotate(sili::Matrix{{{1.}, {0.}, {0.}}});
+ *   std::cout << v << "\n"; // prints {{0.}, {1.}, {0.}}
+ * \endcode
+ */
+template <typename T = double>
+class Quaternion {
+    Matrix<4, 1, T> mValue{T{1}, T{0}, T{0}, T{0}};
 
-    public:
-        Quaternion()
-            : mValue {{T(1.), T(0.), T(0.), T(0.)}}
-        {}
-        // _angle in radian
-        Quaternion(T _angle, Matrix<3, 1, T> const& _axis)
-        {
-            using std::cos;
-            using std::sin;
-            real() = cos(_angle * T(0.5));
-            imag() = sin(_angle * T(0.5)) * _axis.normalized();
-        }
+public:
+    using value_t = T;
 
-        Quaternion(Quaternion const& _q)
-            : mValue {_q.mValue}
-        {}
-        Quaternion(Matrix<4, 1, T> const& _matrix)
-            : mValue(_matrix)
-        {}
+    constexpr Quaternion() = default;
 
-        Quaternion(Matrix<3, 3, T> const& mat) {
-            fromMatrix(mat);
-        }
+    constexpr Quaternion(T w, T x, T y, T z)
+        : mValue{w, x, y, z}
+    {}
 
-        /**
-         * computes quaternion for minimal rotation from v1 to v2
-         */
-        Quaternion(Matrix<3, 1, T> v1, Matrix<3, 1, T> v2) {
-            v1 = v1.normalized();
-            v2 = v2.normalized();
-
-            real() = T(1.) + v1.t() * v2;
-            imag() = cross(v1, v2);
-
-            auto n = norm();
-            using std::abs;
-            if (abs(n) < T(1e-9)) {
-                real() = T(1.);
-                imag() = T(0.);
-            }
-            *this = normalized();
-        }
-    private:
-        void fromMatrix(Matrix<3, 3, T> const& mat) {
-            auto trace = sum(mat.diag());
-            using std::sqrt;
-            if (trace > T(0.)) {
-                auto s = sqrt(trace+ T(1.)) * T(2.);
-                mValue(0) = T(0.25) * s;
-                mValue(1) = (mat(2, 1) - mat(1, 2)) / s;
-                mValue(2) = (mat(0, 2) - mat(2, 0)) / s;
-                mValue(3) = (mat(1, 0) - mat(0, 1)) / s;
-            } else if (mat(0, 0) > mat(1, 1) and mat(0, 0) > mat(2, 2)) {
-                auto s = sqrt(1. + mat(0, 0) - mat(1, 1) - mat(2, 2)) * T(2.);
-                mValue(0) = (mat(2, 1) - mat(1, 2)) / s;
-                mValue(1) = T(0.25) * s;
-                mValue(2) = (mat(0, 1) + mat(1, 0)) / s;
-                mValue(3) = (mat(0, 2) + mat(2, 0)) / s;
-            } else if (mat(1, 1) > mat(2, 2)) {
-                auto s = sqrt(T(1.) + mat(1, 1) - mat(0, 0) - mat(2, 2)) * T(2.);
-                mValue(0) = (mat(0, 2) - mat(2, 0)) / s;
-                mValue(1) = (mat(0, 1) + mat(1, 0)) / s;
-                mValue(2) = T(0.25) * s;
-                mValue(3) = (mat(1, 2) + mat(2, 1)) / s;
-            } else {
-                auto s = sqrt(T(1.) + mat(2, 2) - mat(0, 0) - mat(1, 1)) * T(2.);
-                mValue(0) = (mat(1, 0) - mat(0, 1)) / s;
-                mValue(1) = (mat(0, 2) + mat(2, 0)) / s;
-                mValue(2) = (mat(1, 2) + mat(2, 1)) / s;
-                mValue(3) = T(0.25) * s;
-            }
-            *this = normalized();
-        }
+    constexpr explicit Quaternion(Matrix<4, 1, T> const& value)
+        : mValue{value}
+    {}
 
-    public:
-        auto mat() const -> sili::Matrix<3, 3, T> {
-            auto const& q = mValue;
-            auto R = sili::make_eye<3, 3, double>();
-            R(0, 0) = 1 - 2 * (q(2)*q(2) + q(3)*q(3));
-            R(0, 1) = -2*q(0)*q(3) + 2*q(1)*q(2);
-            R(0, 2) = 2*q(0)*q(2) + 2*q(1)*q(3);
-
-            R(1, 0) = 2*q(0)*q(3) + 2*q(1)*q(2);
-            R(1, 1) = 1 - 2*(q(1)*q(1) + q(3)*q(3));
-            R(1, 2) = -2*q(0)*q(1) + 2*q(2)*q(3);
-
-            R(2, 0) = -2*q(0)*q(2) + 2*q(1)*q(3);
-            R(2, 1) = 2*q(0)*q(1) + 2*q(2)*q(3);
-            R(2, 2) = 1-2*(q(1)*q(1) + q(2)*q(2));
-            return R;
-        }
+    // rotation of angle (in radian) around axis
+    template <_concept::Vector V> requires (length_v<V> == 3)
+    constexpr Quaternion(T angle, V const& axis) {
+        using std::cos;
+        using std::sin;
+        auto s = sin(angle * T{0.5}) / sili::norm(axis);
+        mValue = Matrix<4, 1, T>{cos(angle * T{0.5}), axis(0) * s, axis(1) * s, axis(2) * s};
+    }
 
-        auto operator()(int e) -> T& {
-            return mValue(e);
+    // rotation of a rotation matrix
+    template <_concept::Matrix M> requires (rows_v<M> == 3 and cols_v<M> == 3)
+    constexpr explicit Quaternion(M const& mat) {
+        using std::sqrt;
+        auto trace = mat(0, 0) + mat(1, 1) + mat(2, 2);
+        if (trace > T{0}) {
+            auto s = sqrt(trace + T{1}) * T{2};
+            mValue = Matrix<4, 1, T>{T{0.25} * s,
+                                     (mat(2, 1) - mat(1, 2)) / s,
+                                     (mat(0, 2) - mat(2, 0)) / s,
+                                     (mat(1, 0) - mat(0, 1)) / s};
+        } else if (mat(0, 0) > mat(1, 1) and mat(0, 0) > mat(2, 2)) {
+            auto s = sqrt(T{1} + mat(0, 0) - mat(1, 1) - mat(2, 2)) * T{2};
+            mValue = Matrix<4, 1, T>{(mat(2, 1) - mat(1, 2)) / s,
+                                     T{0.25} * s,
+                                     (mat(0, 1) + mat(1, 0)) / s,
+                                     (mat(0, 2) + mat(2, 0)) / s};
+        } else if (mat(1, 1) > mat(2, 2)) {
+            auto s = sqrt(T{1} + mat(1, 1) - mat(0, 0) - mat(2, 2)) * T{2};
+            mValue = Matrix<4, 1, T>{(mat(0, 2) - mat(2, 0)) / s,
+                                     (mat(0, 1) + mat(1, 0)) / s,
+                                     T{0.25} * s,
+                                     (mat(1, 2) + mat(2, 1)) / s};
+        } else {
+            auto s = sqrt(T{1} + mat(2, 2) - mat(0, 0) - mat(1, 1)) * T{2};
+            mValue = Matrix<4, 1, T>{(mat(1, 0) - mat(0, 1)) / s,
+                                     (mat(0, 2) + mat(2, 0)) / s,
+                                     (mat(1, 2) + mat(2, 1)) / s,
+                                     T{0.25} * s};
         }
+        *this = normalized();
+    }
 
-        auto operator()(int e) const -> T const& {
-            return mValue(e);
+    // minimal rotation from v1 to v2
+    template <_concept::Vector V1, _concept::Vector V2> requires (length_v<V1> == 3 and length_v<V2> == 3)
+    constexpr Quaternion(V1 const& v1, V2 const& v2) {
+        using std::abs;
+        auto n1 = Matrix<3, 1, T>{v1} * (T{1} / sili::norm(v1));
+        auto n2 = Matrix<3, 1, T>{v2} * (T{1} / sili::norm(v2));
+        auto c  = cross(n1, n2);
+        mValue = Matrix<4, 1, T>{T{1} + sili::dot(n1, n2), c(0), c(1), c(2)};
+        if (abs(norm()) < T{1e-9}) {
+            *this = Quaternion{};
         }
+        *this = normalized();
+    }
 
-        auto operator+(Quaternion const& _q) const -> Quaternion {
-            return Quaternion (mValue + _q.mValue);
-        }
-        auto operator+=(Quaternion const& _q) -> Quaternion& {
-            mValue += _q.mValue;
-            return *this;
-        }
-        auto operator-(Quaternion const& _q) const -> Quaternion {
-            return {mValue - _q.mValue};
-        }
-        auto operator-=(Quaternion const& _q) -> Quaternion& {
-            mValue -= _q.mValue;
-            return *this;
-        }
-        auto operator-() const -> Quaternion {
-            return {-mValue};
-        }
-        auto operator*(T scalar) const -> Quaternion {
-            return {mValue*scalar};
-        }
-        auto operator*=(T scalar) -> Quaternion& {
-            mValue *= scalar;
-            return *this;
-        }
+    constexpr auto real() -> T& {
+        return mValue(0);
+    }
+    constexpr auto real() const -> T const& {
+        return mValue(0);
+    }
+    constexpr auto imag() {
+        return view<1, 0, 4, 1>(mValue);
+    }
+    constexpr auto imag() const {
+        return view<1, 0, 4, 1>(mValue);
+    }
 
-        operator sili::Matrix<3, 3, T>() const {
-            return mat();
-        }
+    constexpr auto value() const -> Matrix<4, 1, T> const& {
+        return mValue;
+    }
 
-        auto norm() const -> T {
-            return mValue.norm();
-        }
+    constexpr auto operator()(size_t e) -> T& {
+        return mValue(e);
+    }
+    constexpr auto operator()(size_t e) const -> T const& {
+        return mValue(e);
+    }
 
-        auto normalized() const -> Quaternion {
-            return {mValue * (T(1.) / norm())};
-        }
+    constexpr auto operator==(Quaternion const& q) const -> bool {
+        return mValue == q.mValue;
+    }
 
-        auto conjugate() const -> Quaternion {
-            Quaternion q;
-            q.real() =  real();
-            q.imag() = -imag();
-            return q;
-        }
+    // rotation matrix of a unit quaternion
+    constexpr auto mat() const -> Matrix<3, 3, T> {
+        auto const& q = mValue;
+        return Matrix<3, 3, T>{{{T{1} - T{2} * (q(2)*q(2) + q(3)*q(3)), T{2} * (q(1)*q(2) - q(0)*q(3)),         T{2} * (q(0)*q(2) + q(1)*q(3))},
+                                {T{2} * (q(0)*q(3) + q(1)*q(2)),         T{1} - T{2} * (q(1)*q(1) + q(3)*q(3)), T{2} * (q(2)*q(3) - q(0)*q(1))},
+                                {T{2} * (q(1)*q(3) - q(0)*q(2)),         T{2} * (q(0)*q(1) + q(2)*q(3)),         T{1} - T{2} * (q(1)*q(1) + q(2)*q(2))}}};
+    }
 
-        auto dot(Quaternion q) const -> T {
-            return mValue.t() * q.mValue;
-        }
+    constexpr explicit operator Matrix<3, 3, T>() const {
+        return mat();
+    }
 
-        auto operator*(Quaternion const& q) const -> Quaternion {
-            Quaternion r;
-            r.real() = real() * q.real() - imag().t() * q.imag();
-            r.imag() = real() * q.imag() + q.real() * imag() + cross(imag(), q.imag());
-            return r;
-        }
-        auto operator*=(Quaternion const& q) -> Quaternion& {
-            *this = *this * q;
-            return *this;
-        }
+    constexpr auto operator+(Quaternion const& q) const -> Quaternion {
+        return Quaternion{Matrix<4, 1, T>{mValue + q.mValue}};
+    }
+    constexpr auto operator+=(Quaternion const& q) -> Quaternion& {
+        mValue += q.mValue;
+        return *this;
+    }
+    constexpr auto operator-(Quaternion const& q) const -> Quaternion {
+        return Quaternion{Matrix<4, 1, T>{mValue - q.mValue}};
+    }
+    constexpr auto operator-=(Quaternion const& q) -> Quaternion& {
+        mValue -= q.mValue;
+        return *this;
+    }
+    constexpr auto operator-() const -> Quaternion {
+        return Quaternion{Matrix<4, 1, T>{-mValue}};
+    }
+    constexpr auto operator*(T scalar) const -> Quaternion {
+        return Quaternion{Matrix<4, 1, T>{mValue * scalar}};
+    }
+    constexpr auto operator*=(T scalar) -> Quaternion& {
+        mValue *= scalar;
+        return *this;
+    }
 
-        auto rotate(sili::Matrix<3, 1, T> const& v) const -> sili::Matrix<3, 1, T> {
-            Quaternion q;
-            q.real() = 0.;
-            q.imag() = v;
-            return (*this * q * this->conjugate()).imag();
-        }
+    constexpr auto norm() const -> T {
+        return sili::norm(mValue);
+    }
 
-        auto slerp(Quaternion<T> v1, T factor) -> Quaternion {
-            auto v0 = normalized();
-            v1 = v1.normalized();
+    constexpr auto normalized() const -> Quaternion {
+        return *this * (T{1} / norm());
+    }
 
-            auto dot = v0.dot(v1);
-            if (dot > 1 - 1e-9) {
-                return (v0 + (v1 - v0) * factor).normalized();
-            }
+    constexpr auto conjugate() const -> Quaternion {
+        return Quaternion{mValue(0), -mValue(1), -mValue(2), -mValue(3)};
+    }
 
-            if (dot < 0.) {
-                v1 = -v1;
-                dot = -dot;
-            }
+    constexpr auto dot(Quaternion const& q) const -> T {
+        return sili::dot(mValue, q.mValue);
+    }
 
-            using std::max;
-            using std::min;
-            dot = min(T(1.), max(T(-1), dot));
-            using std::acos;
-            using std::sin;
-            using std::cos;
-            auto theta_0 = acos(dot);
-            auto theta   = theta_0 * factor;
-
-            auto v2 = (v1 - v0*dot).normalized();
-            auto r =  v0 * cos(theta) + v2 * sin(theta);
-            return r.normalized();
+    // Hamilton product
+    constexpr auto operator*(Quaternion const& q) const -> Quaternion {
+        auto const& a = mValue;
+        auto const& b = q.mValue;
+#ifdef SILI_HAS_VECTOR_EXTENSIONS
+        if constexpr (details::has_simd4_v<T>) {
+            if (not std::is_constant_evaluated()) {
+                // r = aw * b + ax * (-bx, bw, -bz, by) + ay * (-by, bz, bw, -bx) + az * (-bz, -by, bx, bw)
+                using V = details::simd4_t<T>;
+                auto bv = details::simd_load<T, sizeof(V)>(b.data());
+                auto rv = a(0) * bv
+                        + a(1) * details::simd_permute<1, 0, 3, 2>(bv) * V{-1, 1, -1,  1}
+                        + a(2) * details::simd_permute<2, 3, 0, 1>(bv) * V{-1, 1,  1, -1}
+                        + a(3) * details::simd_permute<3, 2, 1, 0>(bv) * V{-1, -1, 1,  1};
+                auto r = Quaternion{};
+                details::simd_store<T, sizeof(V)>(r.mValue.data(), rv);
+                return r;
+            }
         }
-    };
+#endif
+        return Quaternion{a(0)*b(0) - a(1)*b(1) - a(2)*b(2) - a(3)*b(3),
+                          a(0)*b(1) + a(1)*b(0) + a(2)*b(3) - a(3)*b(2),
+                          a(0)*b(2) - a(1)*b(3) + a(2)*b(0) + a(3)*b(1),
+                          a(0)*b(3) + a(1)*b(2) - a(2)*b(1) + a(3)*b(0)};
+    }
+    constexpr auto operator*=(Quaternion const& q) -> Quaternion& {
+        *this = *this * q;
+        return *this;
+    }
+
+    // rotates v by a unit quaternion, ``v + w t + u × t`` with ``t = 2 u × v``
+    template <_concept::Vector V> requires (length_v<V> == 3)
+    constexpr auto rotate(V const& v) const -> Matrix<3, 1, T> {
+        auto u = Matrix<3, 1, T>{imag()};
+        auto t = cross(u, v) * T{2};
+        return v + t * real() + cross(u, t);
+    }
+
+    // spherical linear interpolation between *this (factor 0) and v1 (factor 1), along the shortest path
+    constexpr auto slerp(Quaternion const& v1, T factor) const -> Quaternion;
+};
+
+/*! Interpolation mode of slerp()
+ * \shortexample sili::Interpolation::nlerp
+ * \group Classes
+ *
+ * ``slerp`` is the exact spherical linear interpolation (one acos and two sin per quaternion).
+ * ``nlerp`` is a normalized linear interpolation with a corrected factor, which approximates slerp
+ * with polynomials only. The distance to the slerp result is below 4e-4, the worst case are rotations
+ * 180° apart, for rotations up to 90° apart it is below 1e-4 (fit from "Approximating slerp", Arseny Kapoulkine).
+ */
+enum class Interpolation {
+    slerp,
+    nlerp,
+};
+
+namespace details {
+// interpolation of unit quaternions (w, x, y, z), T is a scalar or a Pack
+template <typename T>
+constexpr auto interpolate(Matrix<4, 1, T> const& q0, Matrix<4, 1, T> const& q1, T const& t, Interpolation mode) -> Matrix<4, 1, T> {
+    using std::abs;
+    using std::acos;
+    using std::min;
+    using std::sin;
+    using std::sqrt;
+    using L = lane_t<T>;
+
+    auto d = q0(0)*q1(0) + q0(1)*q1(1) + q0(2)*q1(2) + q0(3)*q1(3);
+    // shortest path, q1 is flipped where d is negative
+    auto sign = select(d < T{0}, T{-1}, T{1});
+    d = min(abs(d), T{1});
+
+    auto a = T{};
+    auto b = T{};
+    if (mode == Interpolation::slerp) {
+        // nearly parallel lanes use a linear interpolation, sin(theta) would be zero
+        auto linear = T{1} - d <= T{std::numeric_limits<L>::epsilon()};
+        auto theta  = acos(d);
+        auto invSin = T{1} / select(linear, T{1}, sqrt(T{1} - d*d));
+        a = select(linear, T{1} - t, sin((T{1} - t) * theta) * invSin);
+        b = select(linear, t,        sin(t * theta) * invSin);
+    } else {
+        auto ka = T{L{1.0904}} + d * (T{L{-3.2452}} + d * (T{L{3.55645}} - d * T{L{1.43519}}));
+        auto kb = T{L{0.848013}} + d * (T{L{-1.06021}} + d * T{L{0.215638}});
+        auto h  = t - T{L{0.5}};
+        auto ot = t + t * h * (t - T{1}) * (ka * h * h + kb);
+        a = T{1} - ot;
+        b = ot;
+    }
+    b = b * sign;
 
-/*
- * ostream
+    auto r = Matrix<4, 1, T>{};
+    for_constexpr<size_t{0}, 4>([&]<size_t i>() {
+        r.template at<i>() = a * q0.template at<i>() + b * q1.template at<i>();
+    });
+    auto n = T{1} / sqrt(r(0)*r(0) + r(1)*r(1) + r(2)*r(2) + r(3)*r(3));
+    for_constexpr<size_t{0}, 4>([&]<size_t i>() {
+        r.template at<i>() = r.template at<i>() * n;
+    });
+    return r;
+}
+}
+
+template <typename T>
+constexpr auto Quaternion<T>::slerp(Quaternion const& v1, T factor) const -> Quaternion {
+    return Quaternion{details::interpolate(normalized().value(), v1.normalized().value(), factor, Interpolation::slerp)};
+}
+
+/*! Interpolation of arrays of quaternions
+ * \shortexample slerp(q0, q1, factors, out, mode)
+ * \group Free Matrix Functions
+ *
+ * \param q0      contiguous range of unit Quaternion<T>, values at factor 0
+ * \param q1      contiguous range of unit Quaternion<T>, values at factor 1
+ * \param factors contiguous range of T, one interpolation factor per quaternion
+ * \param out     contiguous range of Quaternion<T>, must have at least as many elements as q0
+ * \param mode    Interpolation::slerp (default) or Interpolation::nlerp
+ *
+ * ``out[i]`` interpolates between ``q0[i]`` and ``q1[i]`` along the shortest path.
+ * The quaternions are processed in Packs of ``simd_lanes<T>``, without branches per quaternion.
+ * Unlike Quaternion::slerp the inputs are not normalized.
+ *
+ * \code
+ *   auto q0 = std::vector<sili::Quaternion<float>>(1000);
+ *   auto q1 = std::vector<sili::Quaternion<float>>(1000, sili::Quaternion<float>{0.f, 1.f, 0.f, 0.f});
+ *   auto t  = std::vector<float>(1000, 0.5f);
+ *   auto r  = std::vector<sili::Quaternion<float>>(1000);
+ *   slerp(q0, q1, t, r, sili::Interpolation::nlerp);
+ * \endcode
  */
-template<typename T>
-std::ostream& operator<< (std::ostream& stream, Quaternion<T> const& q) {
+template <typename Q0, typename Q1, typename F, typename Out>
+    requires (std::ranges::contiguous_range<Q0> and std::ranges::sized_range<Q0>
+              and std::ranges::contiguous_range<Q1> and std::ranges::contiguous_range<F>
+              and std::ranges::contiguous_range<Out>)
+void slerp(Q0 const& q0, Q1 const& q1, F const& factors, Out&& out, Interpolation mode = Interpolation::slerp) {
+    using T = typename std::ranges::range_value_t<Q0>::value_t;
+    constexpr auto L = details::simd_lanes<T>;
+    using P = Pack<T, L>;
+
+    auto n = std::ranges::size(q0);
+    assert(std::ranges::size(q1) >= n and std::ranges::size(factors) >= n and std::ranges::size(out) >= n);
+    auto src0 = std::ranges::data(q0);
+    auto src1 = std::ranges::data(q1);
+    auto t    = std::ranges::data(factors);
+    auto dst  = std::ranges::data(out);
+
+    auto i = size_t{0};
+    for (; i + L <= n; i += L) {
+        auto b0 = Matrix<4, 1, P>{};
+        auto b1 = Matrix<4, 1, P>{};
+        auto bt = P{};
+        for (size_t lane{0}; lane < L; ++lane) {
+            for (size_t e{0}; e < 4; ++e) {
+                b0(e)[lane] = src0[i + lane](e);
+                b1(e)[lane] = src1[i + lane](e);
+            }
+            bt[lane] = t[i + lane];
+        }
+        auto r = details::interpolate(b0, b1, bt, mode);
+        for (size_t lane{0}; lane < L; ++lane) {
+            dst[i + lane] = Quaternion<T>{r(0)[lane], r(1)[lane], r(2)[lane], r(3)[lane]};
+        }
+    }
+    for (; i < n; ++i) {
+        dst[i] = Quaternion<T>{details::interpolate(src0[i].value(), src1[i].value(), T(t[i]), mode)};
+    }
+}
+
+template <typename T>
+auto operator<<(std::ostream& stream, Quaternion<T> const& q) -> std::ostream& {
     stream << q(0) << " " << q(1) << " " << q(2) << " " << q(3);
     return stream;
 }
 
 }
-#endif
@@ -19,6 +19,8 @@
  * \creategroup 4 Free Matrix Functions
  * \creategroup 4 Matrix Operations
  * \creategroup 5 Free Vector Functions
+ * \creategroup 6 Pack Functions
+ * \creategroup 7 Free Parallel Functions
  */
 
 
@@ -109,4 +111,17 @@
 #include "Matrix.h"
 #include "View.h"
 #include "operations.h"
+#include "Triangular.h"
+#include "LU.h"
+#include "Cholesky.h"
+#include "QR.h"
+#include "Solve.h"
+#include "Transform.h"
+#include "SVD.h"
+#include "EigSym.h"
+#include "expression.h"
+#include "MatrixBatch.h"
+#include "DynMatrix.h"
+#include "BoundedMatrix.h"
+#include "SymMatrix.h"
 #include "Iterator.h"
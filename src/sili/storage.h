@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace sili {
+namespace details {
+
+// width in bytes of the widest vector register of the target
+#if defined(__AVX512F__)
+inline constexpr size_t simd_register_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr size_t simd_register_bytes = 32;
+#else
+inline constexpr size_t simd_register_bytes = 16;
+#endif
+
+// number of lanes of T that fit into one vector register
+template <typename T>
+inline constexpr size_t simd_lanes = std::max<size_t>(1, simd_register_bytes / sizeof(T));
+
+}
+
+/*! Storage policy of aligned matrices
+ * \shortexample sili::Aligned<32>
+ * \group Classes
+ *
+ * \param Alignment alignment in bytes, defaults to the width of the widest vector register
+ *
+ * Used as fourth template parameter of Matrix (see AlignedMatrix).
+ * The storage is aligned to ``Alignment`` bytes and each row is padded, so that
+ * every row starts at an aligned address. The padding is always zero.
+ */
+template <size_t Alignment = details::simd_register_bytes>
+struct Aligned {
+    static_assert(Alignment > 0 and (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+};
+
+/*! Storage policy of affine transformations
+ * \shortexample sili::Affine
+ * \group Classes
+ *
+ * Used as fourth template parameter of a square Matrix (see Affine3).
+ * The last row is always ``[0 … 0 1]``, it is stored but set by every constructor and assignment.
+ */
+struct Affine {};
+
+/*! Storage policy of rigid transformations
+ * \shortexample sili::Rigid
+ * \group Classes
+ *
+ * Like Affine, additionally the linear part is a rotation (see Rigid3).
+ */
+struct Rigid {};
+
+namespace details {
+
+// memory layout of a Matrix
+template <size_t Cols, typename T, typename... Storage>
+struct storage_layout;
+
+// default layout, rows are packed without padding
+template <size_t Cols, typename T>
+struct storage_layout<Cols, T> {
+    static constexpr size_t stride    = Cols;
+    static constexpr size_t alignment = alignof(T);
+};
+
+// aligned layout, each row is padded to a multiple of Alignment bytes
+template <size_t Cols, typename T, size_t Alignment>
+struct storage_layout<Cols, T, Aligned<Alignment>> {
+    static constexpr size_t stride = [] {
+        auto s = Cols;
+        while (s > 0 and (s * sizeof(T)) % Alignment != 0) {
+            s += 1;
+        }
+        return s;
+    }();
+    static constexpr size_t alignment = std::max(Alignment, alignof(T));
+};
+
+// homogeneous layouts, rows are packed and the last row is constant
+template <size_t Cols, typename T>
+struct storage_layout<Cols, T, Affine> : storage_layout<Cols, T> {
+    static constexpr bool homogeneous = true;
+};
+template <size_t Cols, typename T>
+struct storage_layout<Cols, T, Rigid> : storage_layout<Cols, T> {
+    static constexpr bool homogeneous = true;
+};
+
+template <typename Layout>
+constexpr bool homogeneous_layout_v = requires { requires Layout::homogeneous; };
+
+// true for storage policies that only pad the rows
+template <typename Storage>
+constexpr bool is_padded_storage_v = false;
+template <size_t Alignment>
+constexpr bool is_padded_storage_v<Aligned<Alignment>> = true;
+
+}
+}
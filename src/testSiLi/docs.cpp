@@ -431,4 +431,265 @@ TEST_CASE("check example from docs", "[doc]") {
                                {12, 15, 18}}};
         CHECK((z == v));
     }
+
+    SECTION("lazy") {
+        auto a = sili::Matrix{{{1., 2.},
+                               {3., 4.}}};
+        auto b = sili::Matrix{{{5., 6.},
+                               {7., 8.}}};
+        auto c = sili::Matrix<2, 2, double>{};
+        c = lazy(a) + b - lazy(a) * 2.;
+        auto z = sili::Matrix{{{4., 4.},
+                               {4., 4.}}};
+        CHECK((c == z));
+    }
+
+    SECTION("eval") {
+        auto a = sili::Matrix{{{1., 2.},
+                               {3., 4.}}};
+        auto c = eval(lazy(a) * 2. + a);
+        auto z = sili::Matrix{{{3.,  6.},
+                               {9., 12.}}};
+        CHECK((c == z));
+    }
+
+    SECTION("Pack") {
+        auto p = sili::Pack<double, 4>{1., 2., 3., 4.};
+        auto q = p * 2. + 1.;
+        CHECK(q[2] == 7.);
+        auto r = select(p < 2.5, p, -p);
+        CHECK(r[3] == -4.);
+    }
+
+    SECTION("MatrixBatch") {
+        auto a = sili::MatrixBatch<2, 2, double, 4>{};
+        for (size_t i{0}; i < 4; ++i) {
+            set_lane(a, i, sili::Matrix{{{1., double(i)},
+                                         {0., 2.}}});
+        }
+        auto d = det(a * a);
+        CHECK(d[3] == 4.);
+    }
+
+    SECTION("select") {
+        auto a = sili::MatrixBatch<2, 1, double, 2>{sili::Pack{1., 2.},
+                                                    sili::Pack{3., 4.}};
+        auto b = select(sili::Pack{true, false}, a, -a);
+        auto z = sili::Matrix{{{-2.},
+                               {-4.}}};
+        CHECK((lane(b, 1) == z));
+    }
+
+    SECTION("LU") {
+        auto a = sili::Matrix{{{2., 1., 1.},
+                               {4., 3., 3.},
+                               {8., 7., 9.}}};
+        auto lu = sili::LU{a};
+        CHECK(lu.det() == 4.);
+
+        auto b = sili::Matrix{{{ 4.}, {10.}, {24.}}};
+        auto x = lu.solve(b);
+        auto z = sili::Matrix{{{1.}, {1.}, {1.}}};
+        CHECK((x == z));
+    }
+
+    SECTION("LLT") {
+        auto a = sili::Matrix{{{4., 2.},
+                               {2., 5.}}};
+        auto llt = sili::LLT{a};
+        auto l = sili::Matrix{{{2., 0.},
+                               {1., 2.}}};
+        CHECK((llt.L() == l));
+        auto x = llt.solve(sili::Matrix{{{6.}, {7.}}});
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+    }
+
+    SECTION("SymMatrix") {
+        auto p = sili::SymMatrix{{{4., 2.},
+                                  {2., 5.}}};
+        CHECK(p(0, 1) == 2.);
+        auto y = p * sili::Matrix{{{1.}, {1.}}};
+        CHECK((y == sili::Matrix{{{6.}, {7.}}}));
+        auto x = cholesky(p).solve(y);
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+
+        auto m = sili::Matrix{{{1., 0.},
+                               {0., 1.}}};
+        m += lazy(p);
+        CHECK((m == sili::Matrix{{{5., 2.}, {2., 6.}}}));
+    }
+
+    SECTION("sandwich") {
+        auto f = sili::Matrix{{{1., 0.1},
+                               {0., 1. }}};
+        auto p = sili::SymMatrix{{{4., 0.},
+                                  {0., 1.}}};
+        auto q = sili::SymMatrix{{{0.01, 0.  },
+                                  {0.,   0.01}}};
+        p = sandwich(f, p) + q;
+        auto r = full(p) - sili::Matrix{{{4.02, 0.1 },
+                                         {0.1,  1.01}}};
+        CHECK(sum(abs(r)) < 1e-12);
+    }
+
+    SECTION("view_lower_tri") {
+        auto a = sili::Matrix{{{1, 2, 3},
+                               {4, 5, 6},
+                               {7, 8, 9}}};
+        CHECK((sili::Matrix{view_lower_tri(a)} == sili::Matrix{{{1, 0, 0}, {4, 5, 0}, {7, 8, 9}}}));
+        view_lower_tri<sili::tri::Unit>(a) = 0;
+        CHECK((a == sili::Matrix{{{1, 2, 3}, {0, 5, 6}, {0, 0, 9}}}));
+    }
+
+    SECTION("view_upper_tri") {
+        auto a = sili::Matrix{{{1, 2, 3},
+                               {4, 5, 6},
+                               {7, 8, 9}}};
+        CHECK((sili::Matrix{view_upper_tri<sili::tri::Unit>(a)} == sili::Matrix{{{1, 2, 3}, {0, 1, 6}, {0, 0, 1}}}));
+    }
+
+    SECTION("trsm_into") {
+        auto l = sili::Matrix{{{2., 0.},
+                               {1., 4.}}};
+        auto x = sili::Matrix{{{2.}, {5.}}};
+        sili::trsm_into(x, view_lower_tri(l));
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+    }
+
+    SECTION("trsm") {
+        auto u = sili::Matrix{{{2., 1.},
+                               {0., 4.}}};
+        auto x = trsm(view_upper_tri(u), sili::Matrix{{{3.}, {4.}}});
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+
+        auto l = sili::Matrix{{{2., 0.},
+                               {1., 4.}}};
+        auto y = trsm(view_upper_tri(view_trans(l)), sili::Matrix{{{3.}, {4.}}});
+        CHECK((y == sili::Matrix{{{1.}, {1.}}}));
+    }
+
+    SECTION("LDLT") {
+        auto a = sili::Matrix{{{4., 2.},
+                               {2., 5.}}};
+        auto ldlt = sili::LDLT{a};
+        CHECK((ldlt.D() == sili::Matrix{{{4.}, {4.}}}));
+        CHECK(ldlt.det() == 16.);
+    }
+
+    SECTION("QR") {
+        auto a = sili::Matrix{{{1., 0.},
+                               {1., 1.},
+                               {1., 2.}}};
+        auto qr = sili::QR{a};
+        auto x = qr.solve(sili::Matrix{{{1.}, {2.}, {3.}}});
+        CHECK(std::abs(x(0, 0) - 1.) < 1.e-12);
+        CHECK(std::abs(x(1, 0) - 1.) < 1.e-12);
+    }
+
+    SECTION("lstsq") {
+        auto a = sili::Matrix{{{1., 0.},
+                               {1., 1.},
+                               {1., 2.}}};
+        auto x = lstsq(a, sili::Matrix{{{1.}, {2.}, {3.}}});
+        CHECK(std::abs(x(0, 0) - 1.) < 1.e-12);
+        CHECK(std::abs(x(1, 0) - 1.) < 1.e-12);
+    }
+
+    SECTION("svd") {
+        auto a = sili::Matrix{{{3., 0.},
+                               {0., -4.}}};
+        auto [U, S, V, converged] = svd(a);
+        CHECK((S == sili::Matrix{{{4.}, {3.}}}));
+        CHECK(converged);
+    }
+
+    SECTION("eig_sym") {
+        auto a = sili::Matrix{{{2., 1.},
+                               {1., 2.}}};
+        auto [values, vectors] = eig_sym(a);
+        CHECK(std::abs(values(0, 0) - 1.) < 1.e-12);
+        CHECK(std::abs(values(1, 0) - 3.) < 1.e-12);
+    }
+
+    SECTION("solve") {
+        auto a = sili::Matrix{{{2., 1.},
+                               {1., 3.}}};
+        auto [x, singular] = solve(a, sili::Matrix{{{3.}, {4.}}});
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+        CHECK(not singular);
+    }
+
+    SECTION("Affine3") {
+        auto a = sili::affine(sili::Matrix{{{2., 0., 0.},
+                                            {0., 2., 0.},
+                                            {0., 0., 2.}}},
+                              sili::Matrix{{{1.}, {2.}, {3.}}});
+        auto p = a * sili::Matrix{{{1.}, {1.}, {1.}}};
+        CHECK((p == sili::Matrix{{{3.}, {4.}, {5.}}}));
+    }
+
+    SECTION("Rigid3") {
+        auto r = sili::rigid(sili::Matrix{{{0., -1., 0.},
+                                           {1.,  0., 0.},
+                                           {0.,  0., 1.}}},
+                             sili::Matrix{{{1.}, {0.}, {0.}}});
+        auto [d, ri] = inv(r);
+        CHECK((translation(ri) == sili::Matrix{{{0.}, {1.}, {0.}}}));
+    }
+
+    SECTION("DynMatrix") {
+        auto buffer = std::array<std::byte, 1024>{};
+        auto arena  = sili::Arena{buffer};
+        auto a = sili::DynMatrix<double>{{{1., 2.},
+                                          {3., 4.}}, &arena};
+        auto b = a * trans(a);
+        CHECK(b(1, 1) == 25.);
+        CHECK(b.resource() == &arena);
+    }
+
+    SECTION("DynMatrix view") {
+        auto a = sili::DynMatrix<int>{{{1, 2, 3},
+                                       {4, 5, 6}}};
+        view(a, 0, 1, 2, 3) = sili::DynMatrix<int>{2, 2};
+        CHECK(a(1, 2) == 0);
+    }
+
+    SECTION("gemm_into") {
+        auto a = sili::Matrix{{{3, 4, 7},
+                               {5, 6, 8}}};
+        auto b = sili::Matrix{{{1, 2},
+                               {4, 5},
+                               {3, 6}}};
+        auto c = sili::Matrix<4, 4, int>{};
+        c = 1;
+        sili::gemm_into(view<0, 0, 2, 2>(c), a, b, 1, 1);
+        CHECK((view<0, 0, 2, 2>(c) == sili::Matrix{{{41, 69},
+                                                      {54, 89}}}));
+    }
+
+    SECTION("mul_into") {
+        auto a = sili::Matrix{{{1, 2},
+                               {3, 4}}};
+        auto c = sili::Matrix<2, 4, int>{};
+        sili::mul_into(view<0, 2, 2, 4>(c), a, a);
+        CHECK((c == sili::Matrix{{{0, 0,  7, 10},
+                                  {0, 0, 15, 22}}}));
+    }
+
+    SECTION("gemv_into") {
+        auto a = sili::Matrix{{{1, 2},
+                               {3, 4}}};
+        auto y = sili::Matrix{{{1, 1}}};
+        sili::gemv_into(y, a, sili::Matrix{{{1}, {2}}}, 2, 1);
+        CHECK((y == sili::Matrix{{{11, 23}}}));
+    }
+
+    SECTION("BoundedMatrix solve") {
+        auto a = sili::BoundedMatrix<4, 4, double>{{{2., 1.},
+                                                    {1., 3.}}};
+        auto [x, singular] = solve(a, sili::BoundedMatrix<4, 1, double>{{3.}, {4.}});
+        CHECK(not singular);
+        CHECK(std::abs(x(0) - 1.) < 1e-12);
+        CHECK(std::abs(x(1) - 1.) < 1e-12);
+    }
 }
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC0-1.0
+
+#include <sili/sili.h>
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+
+namespace {
+// every allocation falls back to the default resource, which throws while this is alive
+struct NoDefaultResource {
+    std::pmr::memory_resource* previous{std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+    ~NoDefaultResource() {
+        std::pmr::set_default_resource(previous);
+    }
+};
+
+template <typename M>
+constexpr bool is_bounded = false;
+template <size_t R, size_t C, typename T>
+constexpr bool is_bounded<sili::BoundedMatrix<R, C, T>> = true;
+}
+
+TEST_CASE("bounded matrix", "[boundedmatrix]") {
+    auto guard = NoDefaultResource{};
+
+    SECTION("construction and element access") {
+        constexpr auto c = sili::BoundedMatrix<3, 4, int>{{{1, 2},
+                                                           {3, 4}}};
+        static_assert(c.rows() == 2 and c.cols() == 2);
+        static_assert(c(1, 0) == 3);
+        static_assert(c.row_stride() == 4);
+        static_assert(sizeof(c) == 12 * sizeof(int) + 2 * sizeof(size_t));
+
+        auto a = sili::BoundedMatrix<4, 4, int>{2, 3};
+        CHECK(rows(a) == 2);
+        CHECK(cols(a) == 3);
+        CHECK(sum(a) == 0);
+        a = 5;
+        CHECK(sum(a) == 30);
+        a.resize(4, 1);
+        CHECK(sum(a) == 0);
+        a(3) = 7;
+        CHECK(a(3, 0) == 7);
+
+        // from fixed matrices and views
+        auto f = sili::Matrix{{{1, 2, 3},
+                               {4, 5, 6}}};
+        auto b = sili::BoundedMatrix<4, 4, int>{f};
+        CHECK(b == sili::BoundedMatrix<2, 3, int>{{{1, 2, 3}, {4, 5, 6}}});
+        b = view<0, 1, 2, 3>(f);
+        CHECK(b == sili::BoundedMatrix<4, 4, int>{{{2, 3}, {5, 6}}});
+
+        // views and assignments of views of itself
+        view_col(b, 1) = 0;
+        CHECK(b(1, 1) == 0);
+        b = view_trans(b);
+        CHECK(b == sili::BoundedMatrix<4, 4, int>{{{2, 5}, {0, 0}}});
+    }
+
+    SECTION("operations like fixed size matrices") {
+        auto fa = sili::Matrix{{{ 2., -1., 0.5, 3.},
+                                { 1.,  4., 2.0, 0.},
+                                {-3.,  1., 1.0, 2.},
+                                { 0.,  2., 1.5, 5.}}};
+        auto fb = sili::Matrix{{{ 1., 0.},
+                                { 3., 1.},
+                                { 0., 2.},
+                                { 1., 1.}}};
+        auto a = sili::BoundedMatrix<6, 6, double>{fa};
+        auto b = sili::BoundedMatrix<6, 3, double>{fb};
+
+        auto equal = [](auto const& d, auto const& f) {
+            CHECK(rows(d) == sili::rows_v<decltype(f)>);
+            CHECK(cols(d) == sili::cols_v<decltype(f)>);
+            for (size_t row{0}; row < rows(d); ++row) {
+                for (size_t col{0}; col < cols(d); ++col) {
+                    CHECK(std::abs(d(row, col) - f(row, col)) < 1e-12);
+                }
+            }
+        };
+        auto ab = a * b;
+        static_assert(std::is_same_v<decltype(ab), sili::BoundedMatrix<6, 3, double>>);
+        equal(ab, sili::Matrix{fa * fb});
+        equal(a + a, sili::Matrix{fa + fa});
+        equal(-b, sili::Matrix{-fb});
+        equal(trans(b), sili::Matrix{trans(fb)});
+        equal(join_rows(a, b), join_rows(fa, fb));
+        equal(sum_rows(a), sum_rows(fa));
+
+        CHECK(std::abs(det(a) - det(fa)) < 1e-12);
+        auto [d, ai] = inv(a);
+        static_assert(is_bounded<decltype(ai)>);
+        auto [fd, fai] = inv(fa);
+        CHECK(std::abs(d - fd) < 1e-12);
+        equal(ai, fai);
+
+        auto [x, singular] = solve(a, b);
+        static_assert(is_bounded<decltype(x)>);
+        CHECK(not singular);
+        auto [fx, fsingular] = solve(fa, fb);
+        equal(x, fx);
+
+        // mixing with runtime sized matrices
+        auto buffer = std::array<std::byte, 1024>{};
+        auto arena  = sili::Arena{buffer};
+        auto m = sili::DynMatrix<double>{fb, &arena};
+        CHECK(sili::DynMatrix<double>{a, &arena} * m == ab);
+        equal(a * m, sili::Matrix{fa * fb});
+    }
+
+    SECTION("singular and integer matrices") {
+        auto s = sili::BoundedMatrix<3, 3, double>{{{1., 2.},
+                                                    {2., 4.}}};
+        auto [d, si] = inv(s);
+        CHECK(d == 0.);
+        CHECK(si == s);
+        CHECK(solve(s, sili::BoundedMatrix<3, 1, double>{{1.}, {1.}}).singular);
+
+        auto i = sili::BoundedMatrix<5, 5, int>{{{2, 1, 1},
+                                                 {4, 3, 3},
+                                                 {8, 7, 9}}};
+        CHECK(det(i) == 4);
+        auto [x, singular] = solve(i, sili::BoundedMatrix<5, 1, int>{{4}, {10}, {24}});
+        CHECK(not singular);
+        CHECK(std::abs(x(0) - 1.) < 1e-12);
+        CHECK(std::abs(x(1) - 1.) < 1e-12);
+        CHECK(std::abs(x(2) - 1.) < 1e-12);
+    }
+}
@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC0-1.0
+
+#include <sili/sili.h>
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace {
+// every allocation falls back to the default resource, which throws while this is alive
+struct NoDefaultResource {
+    std::pmr::memory_resource* previous{std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+    ~NoDefaultResource() {
+        std::pmr::set_default_resource(previous);
+    }
+};
+}
+
+TEST_CASE("dynamic matrix", "[dynmatrix]") {
+    alignas(64) auto buffer = std::array<std::byte, 1 << 14>{};
+    auto arena = sili::Arena{buffer};
+    auto guard = NoDefaultResource{};
+
+    SECTION("arena") {
+        CHECK(arena.capacity() == buffer.size());
+        auto p0 = arena.allocate(3, 1);
+        auto p1 = arena.allocate(8, 8);
+        CHECK(reinterpret_cast<std::uintptr_t>(p1) % 8 == 0);
+        CHECK(static_cast<std::byte*>(p1) >= static_cast<std::byte*>(p0) + 3);
+        CHECK(arena.used() == 16);
+        arena.reset();
+        CHECK(arena.used() == 0);
+        CHECK(arena.allocate(3, 1) == p0);
+        CHECK_THROWS_AS(arena.allocate(buffer.size(), 1), std::bad_alloc);
+
+        // a new frame can use the whole buffer again
+        arena.reset();
+        auto m = sili::DynMatrix<double>{40, 40, &arena};
+        CHECK(arena.used() >= 40 * 40 * sizeof(double));
+        CHECK(reinterpret_cast<std::uintptr_t>(m.data()) % sili::details::simd_register_bytes == 0);
+    }
+
+    SECTION("construction and element access") {
+        auto a = sili::DynMatrix<int>{{{1, 2, 3},
+                                       {4, 5, 6}}, &arena};
+        CHECK(rows(a) == 2);
+        CHECK(cols(a) == 3);
+        CHECK(a(1, 2) == 6);
+        CHECK(a.resource() == &arena);
+
+        auto z = sili::DynMatrix<int>{3, 2, &arena};
+        CHECK(sum(z) == 0);
+
+        auto f = sili::DynMatrix<int>{sili::Matrix{{{1, 2, 3},
+                                                    {4, 5, 6}}}, &arena};
+        CHECK(f == a);
+
+        // copies stay in the arena of the copied matrix
+        auto c = a;
+        CHECK(c.resource() == &arena);
+        c(0, 0) = 7;
+        CHECK(a(0, 0) == 1);
+        CHECK(c != a);
+
+        auto m = std::move(c);
+        CHECK(m(0, 0) == 7);
+        CHECK(c.data() == nullptr);
+
+        m.resize(4, 4);
+        CHECK(rows(m) == 4);
+        CHECK(sum(m) == 0);
+    }
+
+    SECTION("views") {
+        auto a = sili::DynMatrix<int>{{{ 1,  2,  3,  4},
+                                       { 5,  6,  7,  8},
+                                       { 9, 10, 11, 12}}, &arena};
+        auto v = view(a, 1, 1, 3, 3);
+        CHECK(rows(v) == 2);
+        CHECK(cols(v) == 2);
+        CHECK(v(1, 0) == 10);
+        CHECK(v.resource() == &arena);
+        v = 0;
+        CHECK(a(2, 2) == 0);
+        CHECK(sum(a) == 78 - 6 - 7 - 10 - 11);
+
+        CHECK(sili::DynMatrix<int>{view_row(a, 2)} == sili::DynMatrix<int>{{{9, 0, 0, 12}}, &arena});
+        CHECK(sili::DynMatrix<int>{view_col(a, 3)} == sili::DynMatrix<int>{{{4}, {8}, {12}}, &arena});
+        CHECK(diag(a) == sili::DynMatrix<int>{{{1}, {0}, {0}}, &arena});
+
+        auto t = trans(a);
+        CHECK(rows(t) == 4);
+        CHECK(cols(t) == 3);
+        for (size_t row{0}; row < 3; ++row) {
+            for (size_t col{0}; col < 4; ++col) {
+                CHECK(t(col, row) == a(row, col));
+            }
+        }
+        // views of views
+        auto tv = view(view_trans(a), 1, 0, 3, 2);
+        CHECK(tv(0, 0) == 2);
+        CHECK(tv(1, 0) == 3);
+
+        // assigning a view of the same matrix
+        a = view(a, 0, 0, 2, 2);
+        CHECK(a == sili::DynMatrix<int>{{{1, 2}, {5, 0}}, &arena});
+    }
+
+    SECTION("operations like fixed size matrices") {
+        auto fa = sili::Matrix{{{ 2., -1., 0.5, 3.},
+                                { 1.,  4., 2.0, 0.},
+                                {-3.,  1., 1.0, 2.},
+                                { 0.,  2., 1.5, 5.}}};
+        auto fb = sili::Matrix{{{ 1., 0.,  2., -1.},
+                                { 3., 1., -2.,  0.},
+                                { 0., 2.,  1.,  4.},
+                                { 1., 1.,  0.,  2.}}};
+        auto a = sili::DynMatrix<double>{fa, &arena};
+        auto b = sili::DynMatrix<double>{fb, &arena};
+
+        auto equal = [](auto const& d, auto const& f) {
+            CHECK(rows(d) == sili::rows_v<decltype(f)>);
+            CHECK(cols(d) == sili::cols_v<decltype(f)>);
+            for (size_t row{0}; row < rows(d); ++row) {
+                for (size_t col{0}; col < cols(d); ++col) {
+                    CHECK(std::abs(d(row, col) - f(row, col)) < 1e-12);
+                }
+            }
+        };
+        equal(a + b, sili::Matrix{fa + fb});
+        equal(a - b, sili::Matrix{fa - fb});
+        equal(-a, sili::Matrix{-fa});
+        equal(a * b, sili::Matrix{fa * fb});
+        equal(a * 2., sili::Matrix{fa * 2.});
+        equal(2. * a, sili::Matrix{2. * fa});
+        equal(a / 2., sili::Matrix{fa / 2.});
+        equal(element_multi(a, b), sili::Matrix{element_multi(fa, fb)});
+        equal(abs(a), sili::Matrix{abs(fa)});
+        equal(sum_rows(a), sum_rows(fa));
+        equal(sum_cols(a), sum_cols(fa));
+        equal(join_rows(a, b), join_rows(fa, fb));
+        equal(join_cols(a, b), join_cols(fa, fb));
+        equal(a * view_trans(b), sili::Matrix{fa * view_trans(fb)});
+        equal(view(a, 0, 1, 4, 3) * view(b, 1, 0, 3, 4), sili::Matrix{view<0, 1, 4, 3>(fa) * view<1, 0, 3, 4>(fb)});
+
+        CHECK(std::abs(det(a) - det(fa)) < 1e-12);
+        auto [d, ai] = inv(a);
+        auto [fd, fai] = inv(fa);
+        CHECK(std::abs(d - fd) < 1e-12);
+        equal(ai, fai);
+        equal(a * ai, sili::makeI<4, double>());
+        equal(sili::makeI<double>(3, 4, &arena), sili::makeI<3, 4, double>());
+
+        auto c = a;
+        c += b;
+        equal(c, sili::Matrix{fa + fb});
+        c -= b;
+        c *= 3.;
+        c /= 3.;
+        equal(c, fa);
+
+        auto v = view_col(a, 0);
+        auto w = view_col(b, 1);
+        auto fv = view_col<0>(fa);
+        auto fw = view_col<1>(fb);
+        CHECK(dot(v, w) == dot(fv, fw));
+        CHECK(std::abs(norm(v) - norm(fv)) < 1e-12);
+        equal(outerProd(v, w), outerProd(fv, fw));
+        auto v3 = view(v, 0, 0, 3, 1);
+        auto w3 = view(w, 1, 0, 4, 1);
+        equal(cross(v3, w3), cross(view<0, 3>(fv), view<1, 4>(fw)));
+    }
+
+    SECTION("singular and integer matrices") {
+        auto s = sili::DynMatrix<double>{{{1., 2.},
+                                          {2., 4.}}, &arena};
+        auto [d, si] = inv(s);
+        CHECK(d == 0.);
+        CHECK(si == s);
+        CHECK(det(s) == 0.);
+
+        auto i = sili::DynMatrix<int>{{{2, 1, 1},
+                                       {4, 3, 3},
+                                       {8, 7, 9}}, &arena};
+        CHECK(det(i) == 4);
+    }
+
+    SECTION("results stay in the arena of the left operand") {
+        auto a = sili::DynMatrix<float>{5, 5, &arena};
+        view_diag(a) = 2.f;
+        auto used = arena.used();
+        auto b = a * a + a;
+        CHECK(b.resource() == &arena);
+        CHECK(arena.used() > used);
+        CHECK(b(3, 3) == 6.f);
+    }
+}
+
+TEMPLATE_TEST_CASE("dynamic matrix multiplication, cache blocked", "[dynmatrix]", float, double) {
+    using T = TestType;
+    // small integers, all products and sums are exact
+    auto fill = [](auto& m, size_t seed) {
+        for (size_t row{0}; row < m.rows(); ++row) {
+            for (size_t col{0}; col < m.cols(); ++col) {
+                m(row, col) = T((row * 7 + col * 13 + seed) % 9) - T{4};
+            }
+        }
+    };
+    auto reference = [](auto const& l, auto const& r) {
+        auto ret = sili::DynMatrix<T>{l.rows(), r.cols()};
+        for (size_t row{0}; row < l.rows(); ++row) {
+            for (size_t col{0}; col < r.cols(); ++col) {
+                for (size_t p{0}; p < l.cols(); ++p) {
+                    ret(row, col) += l(row, p) * r(p, col);
+                }
+            }
+        }
+        return ret;
+    };
+
+    // sizes crossing all block borders (gemm_mc, gemm_kc and gemm_nc) and the register blocks
+    auto shapes = std::array<std::array<size_t, 3>, 4>{{{{101, 67, 53}},
+                                                        {{sili::details::gemm_mc + 3, sili::details::gemm_kc + 5, 29}},
+                                                        {{5, 300, sili::details::gemm_nc + 7}},
+                                                        {{64, 64, 64}}}};
+    for (auto [m, k, n] : shapes) {
+        INFO(m << "x" << k << " * " << k << "x" << n);
+        auto a = sili::DynMatrix<T>{m, k};
+        auto b = sili::DynMatrix<T>{k, n};
+        fill(a, 1);
+        fill(b, 2);
+        CHECK(a * b == reference(a, b));
+
+        // strided operands are packed as well
+        auto bt = sili::DynMatrix<T>{n, k};
+        fill(bt, 3);
+        CHECK(a * view_trans(bt) == reference(a, view_trans(bt)));
+        CHECK(view(a, 1, 0, m, k) * b == reference(view(a, 1, 0, m, k), b));
+    }
+}
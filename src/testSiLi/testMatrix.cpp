@@ -3,6 +3,7 @@
 
 #include <sili/sili.h>
 #include <catch2/catch_all.hpp>
+#include <vector>
 
 using namespace sili;
 
@@ -476,6 +477,48 @@ TEST_CASE("make_mat", "[init]") {
         static_assert(std::abs(std::get<1>(z)(2, 2) - ( 0.0625)) < 1.e-9);
     }
 
+    SECTION("inv 4x4") {
+        constexpr static auto m = sili::Matrix{{{ 1.,   2.,  3.,  10.},
+                                                { 2.,   3.,  4.,  20.},
+                                                { 4.,  -1., 10.,  50.},
+                                                {10., -11., 12., -13.}}};
+        constexpr static auto z = inv(m); // Critical
+        static_assert(2248. == std::get<0>(z));
+        static_assert(std::abs((std::get<1>(z) * m)(0, 0) - 1.) < 1.e-12);
+        static_assert(std::abs((std::get<1>(z) * m)(3, 3) - 1.) < 1.e-12);
+        static_assert(std::abs((std::get<1>(z) * m)(2, 1)) < 1.e-12);
+
+        // runtime path, float and double use vector shuffles
+        auto [d, mi] = inv(m);
+        CHECK(d == 2248.);
+        CHECK(det(m) == 2248.);
+        for (size_t row{0}; row < 4; ++row) {
+            for (size_t col{0}; col < 4; ++col) {
+                CHECK(std::abs(mi(row, col) - std::get<1>(z)(row, col)) < 1.e-12);
+            }
+        }
+        auto mf = sili::Matrix<4, 4, float>{m};
+        auto [df, mfi] = inv(mf);
+        CHECK(std::abs(df - 2248.f) < 1.e-3f);
+        CHECK(std::abs(det(mf) - 2248.f) < 1.e-3f);
+        for (size_t row{0}; row < 4; ++row) {
+            for (size_t col{0}; col < 4; ++col) {
+                CHECK(std::abs(mfi(row, col) - static_cast<float>(mi(row, col))) < 1.e-5f);
+            }
+        }
+        auto ma = sili::AlignedMatrix<4, 4, double, 64>{m};
+        CHECK(det(ma) == 2248.);
+        CHECK((std::get<1>(inv(ma)) == sili::AlignedMatrix<4, 4, double, 64>{mi}));
+        CHECK(det(view_trans(m)) == 2248.);
+
+        auto singular = sili::Matrix{{{1., 2., 3., 4.},
+                                      {2., 4., 6., 8.},
+                                      {0., 1., 0., 1.},
+                                      {1., 0., 1., 0.}}};
+        CHECK(det(singular) == 0.);
+        CHECK(std::get<0>(inv(singular)) == 0.);
+    }
+
     SECTION("transposed 2x2 - view") {
         static constexpr auto m = sili::Matrix{{{2., 3.},
                                                 {0., 4.}}};
@@ -523,4 +566,1277 @@ TEST_CASE("make_mat", "[init]") {
         static_assert(2. == z(0));
         static_assert(4. == z(1));
     }
+
+    SECTION("multiplication 3x3 - constexpr") {
+        static constexpr auto m1 = sili::Matrix{{{1., 2., 3.},
+                                                 {4., 5., 6.},
+                                                 {7., 8., 9.}}};
+        static constexpr auto m2 = sili::Matrix{{{1., 0., 1.},
+                                                 {0., 2., 0.},
+                                                 {1., 0., 3.}}};
+        static constexpr auto z = m1 * m2; // Critical
+        static_assert(z == sili::Matrix{{{ 4.,  4., 10.},
+                                         {10., 10., 22.},
+                                         {16., 16., 34.}}});
+    }
+}
+
+namespace {
+template <typename T, size_t Rows, size_t Cols>
+auto makeSequence(T offset) {
+    auto m = sili::Matrix<Rows, Cols, T>{};
+    for (size_t row{0}; row < Rows; ++row) {
+        for (size_t col{0}; col < Cols; ++col) {
+            m(row, col) = static_cast<T>((row * 7 + col * 3) % 11) + offset;
+        }
+    }
+    return m;
+}
+
+template <sili::_concept::Matrix L, sili::_concept::Matrix R>
+auto referenceMultiplication(L const& l, R const& r) {
+    using U = std::remove_const_t<sili::value_t<L>>;
+    auto ret = sili::Matrix<sili::rows_v<L>, sili::cols_v<R>, U>{};
+    for (size_t row{0}; row < sili::rows_v<L>; ++row) {
+        for (size_t col{0}; col < sili::cols_v<R>; ++col) {
+            for (size_t i{0}; i < sili::cols_v<L>; ++i) {
+                ret(row, col) += l(row, i) * r(i, col);
+            }
+        }
+    }
+    return ret;
+}
+
+template <typename T, size_t N, size_t K, size_t M>
+void checkMultiplication() {
+    auto l = makeSequence<T, N, K>(T{1});
+    auto r = makeSequence<T, K, M>(T{-2});
+    CHECK((l * r == referenceMultiplication(l, r)));
+}
+}
+
+TEST_CASE("multiplication kernel", "[multiplication]") {
+    SECTION("square float") {
+        checkMultiplication<float,  2,  2,  2>();
+        checkMultiplication<float,  4,  4,  4>();
+        checkMultiplication<float,  5,  5,  5>();
+        checkMultiplication<float, 10, 10, 10>();
+        checkMultiplication<float, 20, 20, 20>();
+    }
+    SECTION("square double") {
+        checkMultiplication<double,  3,  3,  3>();
+        checkMultiplication<double,  4,  4,  4>();
+        checkMultiplication<double,  7,  7,  7>();
+        checkMultiplication<double, 20, 20, 20>();
+    }
+    SECTION("rectangular") {
+        checkMultiplication<double, 5, 7,  9>();
+        checkMultiplication<float,  9, 3, 17>();
+        checkMultiplication<int,    6, 4, 13>();
+        checkMultiplication<double, 1, 8, 11>();
+        checkMultiplication<double, 13, 2, 1>();
+    }
+    SECTION("views with stride") {
+        auto a = makeSequence<double, 9, 11>(0.5);
+        auto b = makeSequence<double, 10, 12>(1.5);
+        auto l = view<1, 2, 8, 9>(a);
+        auto r = view<2, 1, 9, 12>(b);
+        CHECK((l * r == referenceMultiplication(l, r)));
+    }
+    SECTION("transposed views") {
+        auto a = makeSequence<float, 6, 5>(0.5f);
+        auto b = makeSequence<float, 6, 7>(1.5f);
+        CHECK((view_trans(a) * b == referenceMultiplication(view_trans(a), b)));
+        CHECK((view_trans(b) * a == referenceMultiplication(view_trans(b), a)));
+
+        auto c = makeSequence<float, 7, 5>(-0.5f);
+        CHECK((a * view_trans(c) == referenceMultiplication(a, view_trans(c))));
+        CHECK((view_trans(c) * view_trans(b) == referenceMultiplication(view_trans(c), view_trans(b))));
+    }
+    SECTION("transposed views with stride") {
+        auto a = makeSequence<double, 9, 11>(0.5);
+        auto b = makeSequence<double, 10, 12>(1.5);
+        auto l = view_trans(view<1, 2, 8, 9>(a));   // 7x7
+        auto r = view_trans(view<2, 1, 9, 12>(b));  // 11x7
+        CHECK((l * view<0, 0, 7, 5>(a) == referenceMultiplication(l, view<0, 0, 7, 5>(a))));
+        CHECK((view<0, 0, 5, 11>(b) * r == referenceMultiplication(view<0, 0, 5, 11>(b), r)));
+        CHECK((view_trans(view<0, 0, 7, 5>(a)) * l == referenceMultiplication(view_trans(view<0, 0, 7, 5>(a)), l)));
+        CHECK((l * view_trans(view<0, 0, 4, 7>(b)) == referenceMultiplication(l, view_trans(view<0, 0, 4, 7>(b)))));
+    }
+    SECTION("transposed views - constexpr") {
+        static constexpr auto a = sili::Matrix{{{1, 2, 3},
+                                                {4, 5, 6}}};
+        static constexpr auto b = sili::Matrix{{{1, 0},
+                                                {0, 1},
+                                                {1, 1}}};
+        static_assert((view_trans(a) * a)(2, 1) == 36);
+        static_assert((a * view_trans(a))(0, 1) == 32);
+        static_assert((view_trans(a) * view_trans(b))(0, 2) == 5);
+    }
+}
+
+TEST_CASE("multiplication into existing matrices", "[multiplication]") {
+    // expected content of c after c = alpha * l * r + beta * c
+    auto reference = [](auto const& c, auto const& l, auto const& r, auto alpha, auto beta) {
+        auto ret = sili::Matrix{c};
+        auto p   = referenceMultiplication(l, r);
+        for (size_t row{0}; row < sili::rows_v<decltype(ret)>; ++row) {
+            for (size_t col{0}; col < sili::cols_v<decltype(ret)>; ++col) {
+                ret(row, col) = alpha * p(row, col) + beta * c(row, col);
+            }
+        }
+        return ret;
+    };
+
+    SECTION("matrices and views as destination") {
+        auto a = makeSequence<double, 7, 5>(0.5);
+        auto b = makeSequence<double, 5, 9>(-1.5);
+        auto c = makeSequence<double, 12, 14>(1.);
+        auto d = c;
+        sili::gemm_into(view<2, 3, 9, 12>(c), a, b, 2., 0.5);
+        view<2, 3, 9, 12>(d) = reference(view<2, 3, 9, 12>(d), a, b, 2., 0.5);
+        CHECK((c == d));
+
+        auto e = sili::Matrix<7, 9, double>{};
+        e = std::numeric_limits<double>::quiet_NaN(); // not read with beta == 0
+        sili::mul_into(e, a, b);
+        CHECK((e == a * b));
+
+        auto f = makeSequence<float, 20, 20>(1.f);
+        auto g = makeSequence<float, 20, 20>(-2.f);
+        auto h = sili::Matrix<20, 20, float>{};
+        sili::mul_into(h, f, g);
+        CHECK((h == referenceMultiplication(f, g)));
+        sili::gemm_into(h, f, g);
+        CHECK((h == 2.f * referenceMultiplication(f, g)));
+    }
+
+    SECTION("transposed operands and destinations") {
+        auto a = makeSequence<float, 6, 5>(0.5f);
+        auto b = makeSequence<float, 6, 7>(1.5f);
+        auto c = makeSequence<float, 7, 6>(-0.5f);
+        auto check = [&](auto&& dst, auto const& l, auto const& r) {
+            auto expected = reference(dst, l, r, 3.f, -1.f);
+            sili::gemm_into(dst, l, r, 3.f, -1.f);
+            CHECK((sili::Matrix{dst} == expected));
+        };
+        auto m = makeSequence<float, 8, 8>(2.f);
+        check(view<0, 0, 5, 7>(m), view_trans(a), b);
+        check(view<1, 0, 6, 7>(m), view_trans(a), view_trans(c));
+        check(view_trans(view<0, 1, 7, 6>(m)), view_trans(a), b);
+        check(view_trans(view<0, 1, 7, 6>(m)), view_trans(a), view_trans(c));
+        check(view_trans(view<1, 1, 6, 8>(m)), view_trans(b), a);
+    }
+
+    SECTION("aliasing") {
+        auto a = makeSequence<double, 6, 6>(0.5);
+        auto b = makeSequence<double, 6, 6>(-1.5);
+        auto expected = reference(a, a, b, 1., 1.);
+        sili::gemm_into(a, a, b);
+        CHECK((a == expected));
+
+        expected = referenceMultiplication(view_trans(a), a);
+        sili::mul_into(a, view_trans(a), a);
+        CHECK((a == expected));
+
+        // overlapping views of one matrix
+        auto m = makeSequence<double, 8, 8>(1.);
+        auto r = referenceMultiplication(view<0, 0, 4, 4>(m), view<2, 2, 6, 6>(m));
+        sili::mul_into(view<1, 1, 5, 5>(m), view<0, 0, 4, 4>(m), view<2, 2, 6, 6>(m));
+        CHECK((view<1, 1, 5, 5>(m) == r));
+    }
+
+    SECTION("matrix vector multiplication") {
+        auto a = makeSequence<float, 9, 13>(0.5f);
+        auto x = makeSequence<float, 13, 1>(-1.5f);
+        auto y = makeSequence<float, 9, 1>(1.f);
+        auto expected = reference(y, a, x, 2.f, 0.5f);
+        sili::gemv_into(y, a, x, 2.f, 0.5f);
+        CHECK((y == expected));
+
+        // columns and rows of matrices as vectors
+        auto m = makeSequence<float, 13, 13>(2.f);
+        auto n = m;
+        sili::gemv_into(view<0, 2, 9, 3>(m), a, view_trans(view_row<1>(a)), 1.f, 0.f);
+        view<0, 2, 9, 3>(n) = referenceMultiplication(a, view_trans(view_row<1>(a)));
+        CHECK((m == n));
+
+        // transposed matrix, contiguous and strided destinations
+        auto at = makeSequence<float, 13, 9>(0.5f);
+        auto z  = makeSequence<float, 1, 13>(1.f);
+        expected = reference(view_trans(view<0, 0, 1, 9>(z)), view_trans(at), view<0, 0, 13, 1>(at), 1.f, 1.f);
+        sili::gemv_into(view<0, 9>(z), view_trans(at), view_col<0>(at));
+        CHECK((view_trans(view<0, 0, 1, 9>(z)) == expected));
+
+        expected = reference(view<0, 4, 9, 5>(m), view_trans(at), x, 1.f, 2.f);
+        sili::gemv_into(view<0, 4, 9, 5>(m), view_trans(at), x, 1.f, 2.f);
+        CHECK((view<0, 4, 9, 5>(m) == expected));
+
+        // y is one of the columns of a
+        auto s = makeSequence<double, 5, 5>(0.5);
+        auto v = sili::Matrix<5, 1, double>{view_col<3>(s)};
+        auto t = reference(v, s, v, 1., 0.);
+        sili::gemv_into(view_col<3>(s), s, view_col<3>(s), 1., 0.);
+        CHECK((sili::Matrix{view_col<3>(s)} == t));
+    }
+
+    SECTION("constexpr") {
+        static constexpr auto c = [] {
+            auto a = sili::Matrix{{{1, 2},
+                                   {3, 4}}};
+            auto m = sili::Matrix<2, 4, int>{};
+            m = 1;
+            sili::gemm_into(view<0, 2, 2, 4>(m), a, view_trans(a), 1, 2);
+            sili::mul_into(a, a, a);
+            sili::gemv_into(view_col<0>(m), a, sili::Matrix{{{1}, {1}}}, 1, 0);
+            return m;
+        }();
+        static_assert(c == sili::Matrix{{{17, 1,  7, 13},
+                                         {37, 1, 13, 27}}});
+    }
+}
+
+TEST_CASE("compile time loops", "[unroll]") {
+    SECTION("for_constexpr") {
+        static constexpr auto sum = [] {
+            auto acc = size_t{0};
+            sili::for_constexpr<size_t{3}, size_t{2003}>([&]<size_t i>() {
+                acc += i;
+            });
+            return acc;
+        }();
+        static_assert(sum == 2000 * 2005 / 2); // far beyond the template instantiation depth
+
+        // index types follow Begin
+        sili::for_constexpr<-2, 2>([&]<auto i>() {
+            static_assert(std::is_same_v<decltype(i), int>);
+        });
+
+        auto visited = std::vector<int>{};
+        CHECK(not sili::for_constexpr<0, 10>([&]<int i>() {
+            visited.push_back(i);
+            return i < 3;
+        }));
+        CHECK(visited == std::vector<int>{0, 1, 2, 3});
+        CHECK(sili::for_constexpr<5, 5>([&]<int>() { return false; }));
+    }
+
+    SECTION("for_each_constexpr") {
+        auto visited = std::vector<size_t>{};
+        sili::for_each_constexpr<sili::Matrix<3, 2, int>>([&]<size_t row, size_t col>() {
+            visited.push_back(row * 10 + col);
+        });
+        CHECK(visited == std::vector<size_t>{0, 1, 10, 11, 20, 21});
+
+        visited.clear();
+        CHECK(not sili::for_each_constexpr<sili::Matrix<3, 2, int>>([&]<size_t row, size_t col>() {
+            visited.push_back(row * 10 + col);
+            return row < 1;
+        }));
+        CHECK(visited == std::vector<size_t>{0, 1, 10});
+
+        static_assert(sili::for_each_constexpr<sili::Matrix<30, 30, int>>([]<size_t row, size_t col>() {
+            return row < 30 and col < 30;
+        }));
+    }
+}
+
+TEST_CASE("unroll policy", "[unroll]") {
+    // visits all elements, returns the visited (row, col) as row * 100 + col in order
+    auto visit = []<typename Policy, typename M>(Policy, M&& m) {
+        auto order = std::vector<size_t>{};
+        sili::for_each_index<M, Policy>([&](size_t row, size_t col) {
+            order.push_back(row * 100 + col);
+            m(row, col) = static_cast<float>(order.size());
+        });
+        return order;
+    };
+
+    SECTION("all elements are visited in both modes") {
+        auto a = sili::Matrix<3, 4, float>{};
+        auto b = sili::Matrix<3, 4, float>{};
+        CHECK(visit(sili::unroll::Always{}, a) == visit(sili::unroll::Never{}, b));
+        CHECK((a == b));
+        CHECK(visit(sili::unroll::Auto{}, a).size() == 12);
+
+        // transposed views are visited column by column when rolled
+        auto c = sili::Matrix<4, 3, float>{};
+        auto order = visit(sili::unroll::Never{}, view_trans(c));
+        CHECK(order == std::vector<size_t>{0, 100, 200, 1, 101, 201, 2, 102, 202, 3, 103, 203});
+        CHECK((c == sili::Matrix<4, 3, float>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f}));
+    }
+
+    SECTION("early exit") {
+        auto a = sili::Matrix<5, 5, int>{};
+        auto visited = size_t{0};
+        auto stop = [&](size_t row, size_t col) {
+            ++visited;
+            return not (row == 1 and col == 2);
+        };
+        CHECK(not sili::for_each_index<decltype(a), sili::unroll::Never>(stop));
+        CHECK(visited == 8);
+        visited = 0;
+        CHECK(not sili::for_each_index<decltype(a), sili::unroll::Always>(stop));
+        CHECK(visited == 8);
+    }
+
+    SECTION("operations on large matrices") {
+        auto a = makeSequence<double, 20, 20>(0.5);
+        auto b = makeSequence<double, 20, 20>(-1.5);
+        auto c = a + b;
+        c -= b;
+        CHECK((c == a));
+        CHECK(not (c == b));
+        CHECK(sum(view_trans(a) * 2.) == 2. * sum(a));
+        auto d = sili::Matrix<20, 20, double>{view_trans(a)};
+        CHECK(d(3, 17) == a(17, 3));
+    }
+
+    SECTION("constexpr") {
+        static constexpr auto s = [] {
+            auto a = sili::Matrix<10, 10, int>{};
+            a = 2;
+            view<2, 2, 8, 8>(a) = view_trans(view<0, 0, 6, 6>(a)) * 3;
+            return sum(a);
+        }();
+        static_assert(s == 2 * 64 + 6 * 36);
+    }
+}
+
+TEST_CASE("lazy expressions", "[expression]") {
+    SECTION("expression is not evaluated") {
+        auto a = sili::Matrix{{{1., 2.}}};
+        auto e = lazy(a) + a;
+        static_assert(sili::_concept::Expression<decltype(e)>);
+        static_assert(not sili::_concept::Matrix<decltype(e)>);
+        static_assert(1 == decltype(e)::Rows);
+        static_assert(2 == decltype(e)::Cols);
+        a(0, 1) = 5.;
+        CHECK(e(0, 1) == 10.);
+    }
+
+    SECTION("assignment - constexpr") {
+        static constexpr auto z = [] {
+            auto a = sili::Matrix{{{1., 2.},
+                                   {3., 4.}}};
+            auto b = sili::Matrix{{{5., 6.},
+                                   {7., 8.}}};
+            auto c = sili::Matrix<2, 2, double>{};
+            c = lazy(a) + b - lazy(a) * 2. + -lazy(b) / 2. + 0.5 * lazy(b); // Critical
+            return c;
+        }();
+        static_assert(z == sili::Matrix{{{4., 4.},
+                                         {4., 4.}}});
+    }
+
+    SECTION("type promotion") {
+        static constexpr auto z = [] {
+            auto a = sili::Matrix{{{1, 2}}};
+            auto b = sili::Matrix{{{0.5, 0.25}}};
+            return eval(lazy(a) + b); // Critical
+        }();
+        static_assert(std::is_same_v<decltype(z)::value_t, double>);
+        static_assert(z == sili::Matrix{{{1.5, 2.25}}});
+    }
+
+    SECTION("views as operands and destination") {
+        auto a = sili::Matrix{{{1., 2., 3.},
+                               {4., 5., 6.},
+                               {7., 8., 9.}}};
+        auto c = sili::Matrix<3, 3, double>{};
+        view<1, 1, 3, 3>(c) = lazy(view<0, 0, 2, 2>(a)) + view_trans(view<1, 1, 3, 3>(a));
+        CHECK((c == sili::Matrix{{{0.,  0.,  0.},
+                                  {0.,  6., 10.},
+                                  {0., 10., 14.}}}));
+    }
+
+    SECTION("temporaries are owned by the expression") {
+        auto a = sili::Matrix{{{1., 2.}}};
+        auto e = lazy(a * 2.) + sili::Matrix{{{3., 4.}}};
+        CHECK((eval(e) == sili::Matrix{{{5., 8.}}}));
+    }
+
+    SECTION("in place operations") {
+        auto a = sili::Matrix{{{1., 2.}}};
+        auto b = sili::Matrix{{{3., 4.}}};
+        a += lazy(b) * 2.;
+        CHECK((a == sili::Matrix{{{7., 10.}}}));
+        a -= lazy(b) - a;
+        CHECK((a == sili::Matrix{{{11., 16.}}}));
+        a = lazy(a) + a;
+        CHECK((a == sili::Matrix{{{22., 32.}}}));
+    }
+}
+
+TEST_CASE("aligned matrix", "[aligned]") {
+    SECTION("layout") {
+        using M = sili::AlignedMatrix<3, 3, float, 16>;
+        static_assert(sili::_concept::Matrix<M>);
+        static_assert(3 == M::Rows);
+        static_assert(3 == M::Cols);
+        static_assert(4 == M::Stride);
+        static_assert(alignof(M) == 16);
+        static_assert(sizeof(M) == 3 * 4 * sizeof(float));
+
+        static_assert(8 == sili::AlignedMatrix<7, 7, double, 64>::Stride);
+        static_assert(4 == sili::AlignedMatrix<2, 4, double, 32>::Stride);
+        static_assert(1 == sili::AlignedMatrix<5, 1, double, 8>::Stride);
+
+        auto m = M{};
+        CHECK(reinterpret_cast<std::uintptr_t>(m.data()) % 16 == 0);
+    }
+
+    SECTION("initialization - constexpr") {
+        static constexpr auto m = sili::AlignedMatrix<2, 3, double, 32>{1., 2., 3.,
+                                                                         4., 5., 6.}; // Critical
+        static_assert(4 == m.Stride);
+        static_assert(m == sili::Matrix{{{1., 2., 3.},
+                                         {4., 5., 6.}}});
+        static_assert(0. == m.data()[3]);
+        static_assert(0. == m.data()[7]);
+
+        static constexpr auto m2 = sili::AlignedMatrix<2, 3, double, 32>{{{1., 2., 3.},
+                                                                          {4., 5., 6.}}}; // Critical
+        static_assert(m == m2);
+
+        static constexpr auto m3 = sili::AlignedMatrix<2, 3, double, 32>{view_trans(view_trans(m))}; // Critical
+        static_assert(m == m3);
+    }
+
+    SECTION("operations") {
+        auto a = makeSequence<float, 7, 5>(0.5f);
+        auto b = makeSequence<float, 5, 6>(1.5f);
+        auto c = makeSequence<float, 7, 5>(2.5f);
+        auto aa = sili::AlignedMatrix<7, 5, float>{a};
+        auto ab = sili::AlignedMatrix<5, 6, float>{b};
+        auto ac = sili::AlignedMatrix<7, 5, float>{c};
+
+        auto prod = aa * ab; // Critical
+        static_assert(std::is_same_v<decltype(prod), sili::AlignedMatrix<7, 6, float>>);
+        CHECK((prod == a * b));
+        CHECK((aa * b == a * b));
+        CHECK((a * ab == a * b));
+
+        auto added = aa + ac; // Critical
+        static_assert(std::is_same_v<decltype(added), sili::AlignedMatrix<7, 5, float>>);
+        CHECK((added == a + c));
+        CHECK((aa - ac == a - c));
+        CHECK((aa * 2.f == a * 2.f));
+        CHECK((view_trans(aa) * ac == view_trans(a) * c));
+        CHECK((view<1, 1, 4, 4>(aa) == view<1, 1, 4, 4>(a)));
+        CHECK((view_diag(aa) == view_diag(a)));
+        CHECK((trans(aa) == trans(a)));
+        CHECK(sum(aa) == sum(a));
+
+        // the padding stays zero
+        for (size_t row{0}; row < prod.Rows; ++row) {
+            for (size_t col{prod.Cols}; col < prod.Stride; ++col) {
+                CHECK(prod.data()[row * prod.Stride + col] == 0.f);
+            }
+            for (size_t col{added.Cols}; col < added.Stride; ++col) {
+                CHECK(added.data()[row * added.Stride + col] == 0.f);
+            }
+        }
+    }
+
+    SECTION("det and inv") {
+        auto m = sili::AlignedMatrix<3, 3, double>{ 2., 1.,  3.,
+                                                    1., 3., -3.,
+                                                   -2., 4.,  4.};
+        CHECK(det(m) == det(sili::Matrix{m}));
+        auto [d, mi] = inv(m);
+        CHECK(d == det(m));
+        CHECK(std::abs(mi(0, 0) - 0.3) < 1.e-9);
+    }
+}
+
+namespace {
+// batch with a different, well conditioned matrix in each lane
+template <size_t N, size_t Lanes>
+auto makeBatch() {
+    auto b = sili::MatrixBatch<N, N, double, Lanes>{};
+    for (size_t i{0}; i < Lanes; ++i) {
+        auto m = makeSequence<double, N, N>(static_cast<double>(i));
+        for (size_t k{0}; k < N; ++k) {
+            m(k, k) += static_cast<double>(10 + N + i);
+        }
+        set_lane(b, i, m);
+    }
+    return b;
+}
+
+template <sili::_concept::Matrix L, sili::_concept::Matrix R>
+auto approxEqual(L const& l, R const& r) {
+    return for_each_constexpr<L>([&]<auto row, auto col>() {
+        return std::abs(at<row, col>(l) - at<row, col>(r)) < 1.e-9;
+    });
+}
+
+template <size_t N>
+void checkBatchInv() {
+    auto b = makeBatch<N, 4>();
+    auto [d, bi] = inv(b);
+    for (size_t i{0}; i < 4; ++i) {
+        auto [ds, mi] = inv(lane(b, i));
+        CHECK(std::abs(d[i] - ds) < 1.e-6 * std::abs(ds));
+        CHECK(approxEqual(lane(bi, i), mi));
+        CHECK(std::abs(det(lane(b, i)) - det(b)[i]) < 1.e-6 * std::abs(ds));
+    }
+}
+}
+
+TEST_CASE("matrix batch", "[batch]") {
+    SECTION("pack - constexpr") {
+        static constexpr auto p = sili::Pack{1., 2., 3., 4.}; // Critical
+        static_assert(std::is_same_v<decltype(p), sili::Pack<double, 4> const>);
+        static_assert(p * 2. + 1. == sili::Pack{3., 5., 7., 9.});
+        static_assert(-p == sili::Pack{-1., -2., -3., -4.});
+        static_assert(p / p == 1.);
+        static_assert(p != 1.);
+        static_assert(select(p < 2.5, p, 0.) == sili::Pack{1., 2., 0., 0.});
+        static_assert(any_of(p > 3.));
+        static_assert(not all_of(p > 3.));
+        static_assert(all_of(p > 0. && p < 5.));
+        static_assert(max(p, 2.5) == sili::Pack{2.5, 2.5, 3., 4.});
+        static_assert(abs(-p) == p);
+        static_assert(sili::Pack<int, 3>{7} == sili::Pack{7, 7, 7});
+    }
+
+    SECTION("layout") {
+        using B = sili::MatrixBatch<3, 3, float, 8>;
+        static_assert(sili::_concept::Matrix<B>);
+        static_assert(std::is_same_v<B::value_t, sili::Pack<float, 8>>);
+        static_assert(alignof(sili::Pack<float, 8>) == std::min<size_t>(32, sili::details::simd_register_bytes));
+        static_assert(sizeof(B) == 3 * 3 * 8 * sizeof(float));
+        static_assert(sili::MatrixBatch<2, 2, double>::value_t::Lanes == sili::details::simd_lanes<double>);
+    }
+
+    SECTION("load and store") {
+        auto ms = std::vector<sili::Matrix<2, 3, int>>{};
+        for (int i{0}; i < 8; ++i) {
+            ms.push_back(sili::Matrix{{{i, 2 * i, 3 * i},
+                                       {4, 5, 6}}});
+        }
+        auto b = sili::load_batch<4>(&ms[4]);
+        static_assert(std::is_same_v<decltype(b), sili::MatrixBatch<2, 3, int, 4>>);
+        CHECK(b(0, 1) == sili::Pack{8, 10, 12, 14});
+        CHECK((lane(b, 2) == ms[6]));
+
+        store_batch(b * 2, &ms[0]);
+        CHECK((ms[1] == sili::Matrix{{{10, 20, 30},
+                                      { 8, 10, 12}}}));
+        CHECK((ms[5] == sili::Matrix{{{5, 10, 15},
+                                      {4,  5,  6}}}));
+    }
+
+    SECTION("operations") {
+        auto a = makeBatch<3, 4>();
+        auto b = trans(makeBatch<3, 4>()) * 0.5;
+        auto s = sili::Matrix{{{1.}, {-2.}, {3.}}};
+        auto v = a * s; // Critical
+        static_assert(std::is_same_v<decltype(v), sili::MatrixBatch<3, 1, double, 4>>);
+        auto w = view_col<1>(b);
+
+        auto sum  = a + b;
+        auto diff = a - b;
+        auto prod = a * b;
+        auto neg  = -a;
+        auto t    = trans(a);
+        auto d    = det(a);
+        auto n    = norm(v);
+        auto dt   = dot(v, w);
+        auto c    = cross(v, w);
+        for (size_t i{0}; i < 4; ++i) {
+            auto ai = lane(a, i);
+            auto bi = lane(b, i);
+            auto vi = lane(v, i);
+            auto wi = lane(w, i);
+            CHECK((lane(sum, i)  == ai + bi));
+            CHECK((lane(diff, i) == ai - bi));
+            CHECK((lane(prod, i) == ai * bi));
+            CHECK((lane(neg, i)  == -ai));
+            CHECK((lane(t, i)    == trans(ai)));
+            CHECK((vi            == ai * s));
+            CHECK((lane(c, i)    == cross(vi, wi)));
+            CHECK(d[i]  == det(ai));
+            CHECK(n[i]  == norm(vi));
+            CHECK(dt[i] == dot(vi, wi));
+        }
+    }
+
+    SECTION("inverse") {
+        checkBatchInv<1>();
+        checkBatchInv<2>();
+        checkBatchInv<3>();
+        checkBatchInv<4>();
+        checkBatchInv<6>();
+    }
+
+    SECTION("inverse - singular lane") {
+        auto b = makeBatch<3, 2>();
+        auto m = lane(b, 0);
+        set_lane(b, 1, sili::Matrix{{{1., 2., 3.},
+                                     {2., 4., 6.},
+                                     {0., 1., 0.}}});
+        auto [d, bi] = inv(b);
+        CHECK(d[0] != 0.);
+        CHECK(d[1] == 0.);
+        CHECK(approxEqual(lane(bi, 0), std::get<1>(inv(m))));
+        CHECK((lane(bi, 1) == lane(b, 1)));
+    }
+}
+
+TEST_CASE("triangular", "[triangular]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{2., 5., 7.},
+                                                {1., 4., 6.},
+                                                {3., 2., 8.}}};
+        static_assert(sili::Matrix{view_lower_tri(a)} == sili::Matrix{{{2., 0., 0.}, {1., 4., 0.}, {3., 2., 8.}}});
+        static_assert(sili::Matrix{view_upper_tri<sili::tri::Unit>(a)} == sili::Matrix{{{1., 5., 7.}, {0., 1., 6.}, {0., 0., 1.}}});
+        static_assert(view_lower_tri(a).at<0, 2>() == 0. and view_lower_tri<sili::tri::Unit>(a)(1, 1) == 1.);
+        static_assert(trsm(view_lower_tri(a), sili::Matrix{{{2.}, {5.}, {13.}}}) == sili::Matrix{{{1.}, {1.}, {1.}}}); // Critical
+        static_assert(trsm(view_upper_tri(a), sili::Matrix{{{14.}, {10.}, {8.}}}) == sili::Matrix{{{1.}, {1.}, {1.}}}); // Critical
+    }
+
+    SECTION("views") {
+        auto a = makeSequence<double, 4, 4>(1.);
+        auto b = sili::Matrix{view_lower_tri(a)};
+        for (size_t row{0}; row < 4; ++row) {
+            for (size_t col{0}; col < 4; ++col) {
+                CHECK(b(row, col) == (col <= row ? a(row, col) : 0.));
+                CHECK(view_upper_tri<sili::tri::Unit>(a)(row, col) == (col > row ? a(row, col) : col == row ? 1. : 0.));
+                CHECK(view_lower_tri(view_trans(a))(row, col) == view_upper_tri(a)(col, row));
+            }
+        }
+        // triangles of the same matrix combine elementwise
+        CHECK((sili::Matrix{view_lower_tri(a) + view_upper_tri<sili::tri::Unit>(a) - sili::makeI<4, double>()} == a));
+
+        // assignments only write the triangle
+        auto c = sili::Matrix<4, 4, double>{};
+        c = 7.;
+        view_upper_tri(c) = a;
+        CHECK((sili::Matrix{view_upper_tri(c)} == sili::Matrix{view_upper_tri(a)}));
+        CHECK(c(3, 0) == 7.);
+        view_lower_tri<sili::tri::Unit>(c) = 0.;
+        CHECK((c == sili::Matrix{view_upper_tri(a)}));
+        view_lower_tri(view<1, 1, 4, 4>(c)) = view_lower_tri(view_trans(view<1, 1, 4, 4>(a)));
+        CHECK(c(3, 2) == a(2, 3));
+        CHECK(c(1, 0) == 0.);
+    }
+
+    SECTION("solve") {
+        auto m = lane(makeBatch<6, 1>(), 0);
+        auto b = makeSequence<double, 6, 3>(-2.);
+        auto check = [&](auto const& t) {
+            auto full = sili::Matrix{t};
+            auto [x, singular] = solve(full, b);
+            CHECK(not singular);
+            CHECK(approxEqual(trsm(t, b), x));
+            CHECK(approxEqual(trsm<sili::unroll::Always>(t, b), x));
+            CHECK(approxEqual(trsm<sili::unroll::Never>(t, b), x));
+            CHECK(approxEqual(trsm(t, view_col<1>(b)), view_col<1>(x)));
+
+            auto y = b;
+            trsm_into(view<0, 1, 6, 3>(y), t);
+            CHECK(approxEqual(view<0, 1, 6, 3>(y), view<0, 1, 6, 3>(x)));
+            CHECK(approxEqual(view_col<0>(y), view_col<0>(b)));
+        };
+        check(view_lower_tri(m));
+        check(view_upper_tri(m));
+        check(view_lower_tri<sili::tri::Unit>(m));
+        check(view_upper_tri<sili::tri::Unit>(m));
+        check(view_lower_tri(view_trans(m)));
+        check(view_upper_tri(view_trans(m)));
+
+        // the zero triangle is never read
+        auto n = sili::Matrix{view_lower_tri(m)};
+        view_upper_tri<sili::tri::Unit>(n) = std::nan("");
+        CHECK(approxEqual(trsm(view_lower_tri(n), b), trsm(view_lower_tri(m), b)));
+
+        // the factors of a cholesky factorization
+        auto a   = sili::Matrix{m * trans(m)};
+        auto llt = cholesky(a);
+        auto z   = trsm(view_upper_tri(view_trans(llt.L())), trsm(view_lower_tri(llt.L()), b));
+        CHECK(approxEqual(z, llt.solve(b)));
+
+        // integer matrices are solved as double
+        auto i = sili::Matrix{{{2, 0},
+                               {1, 4}}};
+        auto xi = trsm(view_lower_tri(i), sili::Matrix{{{1}, {2}}});
+        static_assert(std::is_same_v<decltype(xi), sili::Matrix<2, 1, double>>);
+        CHECK((xi == sili::Matrix{{{0.5}, {0.375}}}));
+    }
+
+    SECTION("batch") {
+        auto m = makeBatch<5, 4>();
+        auto b = makeSequence<double, 5, 2>(1.);
+        auto x = trsm(view_lower_tri(m), b);
+        static_assert(std::is_same_v<decltype(x), sili::MatrixBatch<5, 2, double, 4>>);
+        for (size_t i{0}; i < 4; ++i) {
+            auto ml = lane(m, i);
+            CHECK(approxEqual(lane(x, i), trsm(view_lower_tri(ml), b)));
+        }
+    }
+}
+
+TEST_CASE("LU factorization", "[lu]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{2., 1., 1.},
+                                                {4., 3., 3.},
+                                                {8., 7., 9.}}};
+        static constexpr auto lu = sili::LU{a}; // Critical
+        static_assert(std::is_same_v<decltype(lu), sili::LU<3, double> const>);
+        static_assert(4. == lu.det());
+        static_assert(not lu.singular());
+        static_assert(lu.solve(sili::Matrix{{{4.}, {10.}, {24.}}}) == sili::Matrix{{{1.}, {1.}, {1.}}});
+        static_assert(lu.P() * a == lu.L() * lu.U());
+    }
+
+    SECTION("pivoting") {
+        // zero on the diagonal, can not be factorized without row swaps
+        auto a = sili::Matrix{{{0., 1., 0., 0., 2.},
+                               {1., 0., 0., 0., 0.},
+                               {0., 0., 0., 3., 0.},
+                               {0., 0., 4., 0., 0.},
+                               {0., 5., 0., 0., 1.}}};
+        auto lu = sili::LU{a};
+        CHECK(not lu.singular());
+        CHECK(lu.det() == det(a));
+        CHECK(std::abs(det(a) + 108.) < 1.e-12);
+        CHECK((lu.P() * a == lu.L() * lu.U()));
+
+        auto [d, ai] = inv(a);
+        CHECK(d == lu.det());
+        CHECK(approxEqual(ai * a, sili::makeI<5, double>()));
+    }
+
+    SECTION("multiple right hand sides") {
+        auto a = makeBatch<6, 1>();
+        auto lu = sili::LU{lane(a, 0)};
+        auto b = makeSequence<double, 6, 3>(-2.);
+        auto x = lu.solve(b);
+        static_assert(std::is_same_v<decltype(x), sili::Matrix<6, 3, double>>);
+        CHECK(approxEqual(lane(a, 0) * x, b));
+        for_constexpr<0, 3>([&]<size_t col>() {
+            CHECK(approxEqual(lu.solve(view_col<col>(b)), view_col<col>(x)));
+        });
+        CHECK(approxEqual(lu.inverse() * lane(a, 0), sili::makeI<6, double>()));
+    }
+
+    SECTION("singular") {
+        auto a = sili::Matrix{{{1., 2., 3., 4., 5.},
+                               {2., 4., 6., 8., 10.},
+                               {0., 1., 0., 1., 0.},
+                               {1., 0., 1., 0., 1.},
+                               {3., 1., 4., 1., 5.}}};
+        auto lu = sili::LU{a};
+        CHECK(lu.singular());
+        CHECK(lu.det() == 0.);
+        CHECK(det(a) == 0.);
+        CHECK(std::get<0>(inv(a)) == 0.);
+    }
+
+    SECTION("integer determinant") {
+        static constexpr auto a = sili::Matrix{{{2, 0, 1, 0, 3},
+                                                {1, 1, 0, 2, 0},
+                                                {0, 3, 1, 0, 1},
+                                                {4, 0, 0, 1, 1},
+                                                {0, 1, 2, 1, 0}}};
+        static constexpr auto d = det(a); // Critical
+        static_assert(std::is_same_v<decltype(d), int const>);
+        static_assert(d == 91);
+    }
+
+    SECTION("batch") {
+        auto a = makeBatch<5, 4>();
+        set_lane(a, 2, sili::Matrix{{{0., 1., 0., 0., 2.},
+                                     {1., 0., 0., 0., 0.},
+                                     {0., 0., 0., 3., 0.},
+                                     {0., 0., 4., 0., 0.},
+                                     {0., 5., 0., 0., 1.}}});
+        auto lu = sili::LU{a};
+        auto b  = makeSequence<double, 5, 2>(1.);
+        auto x  = lu.solve(b);
+        static_assert(std::is_same_v<decltype(x), sili::MatrixBatch<5, 2, double, 4>>);
+        CHECK(not any_of(lu.singular()));
+        for (size_t i{0}; i < 4; ++i) {
+            auto lus = sili::LU{lane(a, i)};
+            CHECK(lu.det()[i] == lus.det());
+            CHECK(approxEqual(lane(x, i), lus.solve(b)));
+            CHECK(approxEqual(lane(lu.P(), i), lus.P()));
+        }
+    }
+}
+
+TEST_CASE("cholesky", "[cholesky]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{4., 2.},
+                                                {2., 5.}}};
+        static constexpr auto llt = sili::LLT{a}; // Critical
+        static_assert(std::is_same_v<decltype(llt), sili::LLT<2, double> const>);
+        static_assert(not llt.failed());
+        static_assert(llt.L() == sili::Matrix{{{2., 0.}, {1., 2.}}});
+        static_assert(llt.solve(sili::Matrix{{{6.}, {7.}}}) == sili::Matrix{{{1.}, {1.}}});
+        static_assert(16. == llt.det());
+
+        static constexpr auto ldlt = sili::LDLT{a}; // Critical
+        static_assert(not ldlt.failed());
+        static_assert(ldlt.D() == sili::Matrix{{{4.}, {4.}}});
+        static_assert(16. == ldlt.det());
+        static_assert(ldlt.L() * sili::Matrix{{{4., 0.}, {0., 4.}}} * trans(ldlt.L()) == a);
+    }
+
+    SECTION("symmetric positive definite") {
+        auto m = lane(makeBatch<6, 1>(), 0);
+        auto a = sili::Matrix{m * trans(m)};
+        auto b = makeSequence<double, 6, 3>(-2.);
+        auto lu = sili::LU{a};
+
+        auto llt = cholesky(a);
+        CHECK(not llt.failed());
+        CHECK(approxEqual(llt.L() * trans(llt.L()), a));
+        CHECK(approxEqual(a * llt.solve(b), b));
+        CHECK(approxEqual(llt.inverse() * a, sili::makeI<6, double>()));
+        CHECK(std::abs(llt.det() - lu.det()) < 1.e-9 * lu.det());
+        CHECK(std::abs(llt.logdet() - std::log(lu.det())) < 1.e-9);
+
+        auto ldlt = sili::ldlt(a);
+        CHECK(not ldlt.failed());
+        CHECK(approxEqual(a * ldlt.solve(b), b));
+        CHECK(approxEqual(ldlt.inverse() * a, sili::makeI<6, double>()));
+        CHECK(std::abs(ldlt.det() - lu.det()) < 1.e-9 * lu.det());
+        CHECK(std::abs(ldlt.logdet() - std::log(lu.det())) < 1.e-9);
+    }
+
+    SECTION("indefinite") {
+        auto a = sili::Matrix{{{1., 2., 0.},
+                               {2., 1., 0.},
+                               {0., 0., 3.}}};
+        CHECK(sili::LLT{a}.failed());
+
+        // LDLT handles indefinite matrices without zero pivots
+        auto ldlt = sili::LDLT{a};
+        CHECK(not ldlt.failed());
+        CHECK(ldlt.det() == -9.);
+        CHECK(approxEqual(ldlt.solve(sili::Matrix{{{3.}, {3.}, {3.}}}), sili::Matrix{{{1.}, {1.}, {1.}}}));
+
+        CHECK(sili::LDLT{sili::Matrix{{{0., 1.}, {1., 0.}}}}.failed());
+    }
+
+    SECTION("batch") {
+        auto m = makeBatch<4, 4>();
+        auto a = sili::Matrix{m * trans(m)};
+        set_lane(a, 1, sili::Matrix{{{1., 2., 0., 0.},
+                                     {2., 1., 0., 0.},
+                                     {0., 0., 1., 0.},
+                                     {0., 0., 0., 1.}}});
+        auto b   = makeSequence<double, 4, 2>(1.);
+        auto llt = sili::LLT{a};
+        auto x   = llt.solve(b);
+        static_assert(std::is_same_v<decltype(x), sili::MatrixBatch<4, 2, double, 4>>);
+        CHECK((llt.failed() == sili::Pack{false, true, false, false}));
+        for (size_t i : {0, 2, 3}) {
+            auto llts = sili::LLT{lane(a, i)};
+            CHECK(std::abs(llt.det()[i] - llts.det()) < 1.e-9 * llts.det());
+            CHECK(approxEqual(lane(x, i), llts.solve(b)));
+            CHECK(approxEqual(lane(llt.L(), i), llts.L()));
+        }
+    }
+}
+
+TEST_CASE("QR decomposition", "[qr]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{1., 0.},
+                                                {1., 1.},
+                                                {1., 2.}}};
+        static constexpr auto qr = sili::QR{a}; // Critical
+        static_assert(std::is_same_v<decltype(qr), sili::QR<3, 2, double> const>);
+        static_assert(not qr.singular());
+        static constexpr auto x = qr.solve(sili::Matrix{{{1.}, {2.}, {3.}}});
+        static_assert(std::is_same_v<decltype(x), sili::Matrix<2, 1, double> const>);
+        CHECK(approxEqual(x, sili::Matrix{{{1.}, {1.}}}));
+    }
+
+    SECTION("least squares") {
+        auto a = makeSequence<double, 12, 6>(0.5);
+        for (size_t k{0}; k < 6; ++k) {
+            a(k, k) += 10.;
+        }
+        auto b  = makeSequence<double, 12, 2>(-1.);
+        auto qr = sili::qr(a);
+        CHECK(not qr.singular());
+
+        auto q = qr.Q();
+        CHECK(approxEqual(trans(q) * q, sili::makeI<12, double>()));
+        auto r = sili::Matrix<12, 6, double>{};
+        view<0, 0, 6, 6>(r) = qr.R();
+        CHECK(approxEqual(q * r, a));
+        CHECK(approxEqual(qr.applyQt(b), trans(q) * b));
+        CHECK(approxEqual(qr.applyQ(qr.applyQt(b)), b));
+
+        // normal equations
+        auto ata = sili::Matrix{trans(a) * a};
+        auto x   = lstsq(a, b);
+        static_assert(std::is_same_v<decltype(x), sili::Matrix<6, 2, double>>);
+        CHECK(approxEqual(x, std::get<1>(inv(ata)) * trans(a) * b));
+        CHECK(approxEqual(trans(a) * (a * x - b), sili::Matrix<6, 2, double>{}));
+    }
+
+    SECTION("square") {
+        auto a  = lane(makeBatch<5, 1>(), 0);
+        auto b  = makeSequence<double, 5, 1>(2.);
+        auto qr = sili::QR{a};
+        CHECK(approxEqual(qr.solve(b), sili::LU{a}.solve(b)));
+        CHECK(std::abs(std::abs(det(qr.R())) - std::abs(det(a))) < 1.e-9 * std::abs(det(a)));
+    }
+
+    SECTION("rank deficient") {
+        auto a = sili::Matrix{{{1., 2.},
+                               {2., 4.},
+                               {3., 6.}}};
+        CHECK(sili::QR{a}.singular());
+    }
+
+    SECTION("batch") {
+        auto a = sili::MatrixBatch<6, 3, double, 4>{};
+        for (size_t i{0}; i < 4; ++i) {
+            auto m = makeSequence<double, 6, 3>(static_cast<double>(i));
+            for (size_t k{0}; k < 3; ++k) {
+                m(k, k) += 5.;
+            }
+            set_lane(a, i, m);
+        }
+        auto b  = makeSequence<double, 6, 1>(1.);
+        auto qr = sili::QR{a};
+        auto x  = qr.solve(b);
+        static_assert(std::is_same_v<decltype(x), sili::MatrixBatch<3, 1, double, 4>>);
+        CHECK(not any_of(qr.singular()));
+        for (size_t i{0}; i < 4; ++i) {
+            auto qrs = sili::QR{lane(a, i)};
+            CHECK(approxEqual(lane(x, i), qrs.solve(b)));
+            CHECK(approxEqual(lane(qr.R(), i), qrs.R()));
+        }
+    }
+}
+
+namespace {
+template <sili::_concept::Matrix M, typename S>
+void checkSVD(M const& m, S const& s) {
+    constexpr auto K = S::K;
+    CHECK(s.converged);
+    auto us = s.U;
+    for (size_t col{0}; col < K; ++col) {
+        CHECK(s.S(col, 0) >= 0.);
+        if (col > 0) {
+            CHECK(s.S(col - 1, 0) >= s.S(col, 0));
+        }
+        for (size_t row{0}; row < rows(us); ++row) {
+            us(row, col) *= s.S(col, 0);
+        }
+    }
+    CHECK(approxEqual(us * trans(s.V), m));
+    CHECK(approxEqual(trans(s.U) * s.U, sili::makeI<K, double>()));
+    CHECK(approxEqual(trans(s.V) * s.V, sili::makeI<K, double>()));
+}
+}
+
+TEST_CASE("singular value decomposition", "[svd]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{3., 0.},
+                                                {0., -4.}}};
+        static constexpr auto s = svd(a); // Critical
+        static_assert(std::is_same_v<decltype(s), sili::SVD<2, 2, double> const>);
+        static_assert(s.S == sili::Matrix{{{4.}, {3.}}});
+        static_assert(s.converged);
+    }
+
+    SECTION("jacobi") {
+        auto a = makeSequence<double, 6, 6>(0.5);
+        for (size_t k{0}; k < 6; ++k) {
+            a(k, k) += static_cast<double>(k);
+        }
+        checkSVD(a, svd(a));
+        auto b = sili::Matrix{view<0, 0, 6, 4>(a)};
+        checkSVD(b, svd(b));
+        auto c = sili::Matrix{trans(b)};
+        auto sc = svd(c);
+        static_assert(std::is_same_v<decltype(sc.U), sili::Matrix<4, 4, double>>);
+        static_assert(std::is_same_v<decltype(sc.V), sili::Matrix<6, 4, double>>);
+        checkSVD(c, sc);
+        CHECK(approxEqual(sc.S, svd(b).S));
+    }
+
+    SECTION("golub reinsch") {
+        auto a = makeSequence<double, 10, 8>(-1.5);
+        for (size_t k{0}; k < 8; ++k) {
+            a(k, k) += 3. * static_cast<double>(k);
+        }
+        auto s = svd(a);
+        checkSVD(a, s);
+        // both methods find the same singular values
+        CHECK(approxEqual(s.S, sili::details::svd_jacobi(a).S));
+    }
+
+    SECTION("rank deficient") {
+        auto a = sili::Matrix{{{1., 2., 3.},
+                               {2., 4., 6.},
+                               {1., 0., 1.}}};
+        auto s = svd(a);
+        CHECK(s.converged);
+        CHECK(std::abs(s.S(2, 0)) < 1.e-12);
+        CHECK(s.S(1, 0) > 0.1);
+    }
+
+    SECTION("integer") {
+        auto s = svd(sili::Matrix{{{0, 2}, {1, 0}}});
+        static_assert(std::is_same_v<decltype(s), sili::SVD<2, 2, double>>);
+        CHECK((s.S == sili::Matrix{{{2.}, {1.}}}));
+    }
+}
+
+namespace {
+template <sili::_concept::Matrix M, typename E>
+void checkEigSym(M const& m, E const& e, double eps = 1.e-9) {
+    constexpr auto N = sili::rows_v<M>;
+    auto vd = e.vectors;
+    for (size_t col{0}; col < N; ++col) {
+        if (col > 0) {
+            CHECK(e.values(col - 1, 0) <= e.values(col, 0));
+        }
+        for (size_t row{0}; row < N; ++row) {
+            vd(row, col) *= e.values(col, 0);
+        }
+    }
+    auto approx = [&](auto const& l, auto const& r) {
+        return for_each_constexpr<M>([&]<auto row, auto col>() {
+            return std::abs(at<row, col>(l) - at<row, col>(r)) < eps;
+        });
+    };
+    CHECK(approx(vd * trans(e.vectors), m));
+    CHECK(approx(trans(e.vectors) * e.vectors, sili::makeI<N, double>()));
+}
+}
+
+TEST_CASE("symmetric eigen decomposition", "[eig_sym]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{2., 0.},
+                                                {0., 1.}}};
+        static constexpr auto e = eig_sym(a); // Critical
+        static_assert(std::is_same_v<decltype(e), sili::EigSym<2, double> const>);
+        static_assert(e.values == sili::Matrix{{{1.}, {2.}}});
+    }
+
+    SECTION("3x3 analytic") {
+        auto m = lane(makeBatch<3, 1>(), 0);
+        auto a = sili::Matrix{m * trans(m)};
+        auto e = eig_sym(a);
+        checkEigSym(a, e);
+        // agrees with cyclic jacobi
+        CHECK(approxEqual(e.values, sili::details::eig_sym_jacobi<3, double>(a).values));
+    }
+
+    SECTION("3x3 repeated eigenvalues") {
+        auto a = sili::Matrix{{{2., 1., 1.},
+                               {1., 2., 1.},
+                               {1., 1., 2.}}};
+        auto e = eig_sym(a);
+        CHECK(approxEqual(e.values, sili::Matrix{{{1.}, {1.}, {4.}}}));
+        checkEigSym(a, e);
+
+        auto d = sili::Matrix{{{3., 0., 0.},
+                               {0., 1., 0.},
+                               {0., 0., 3.}}};
+        auto ed = eig_sym(d);
+        CHECK((ed.values == sili::Matrix{{{1.}, {3.}, {3.}}}));
+        checkEigSym(d, ed);
+
+        auto z = eig_sym(sili::Matrix<3, 3, double>{});
+        checkEigSym(sili::Matrix<3, 3, double>{}, z);
+    }
+
+    SECTION("jacobi") {
+        auto m = lane(makeBatch<6, 1>(), 0);
+        auto a = sili::Matrix{m + trans(m)};
+        checkEigSym(a, eig_sym(a));
+    }
+
+    SECTION("integer") {
+        auto e = eig_sym(sili::Matrix{{{2, 1}, {1, 2}}});
+        static_assert(std::is_same_v<decltype(e), sili::EigSym<2, double>>);
+        CHECK(approxEqual(e.values, sili::Matrix{{{1.}, {3.}}}));
+    }
+
+    SECTION("batch") {
+        auto m = makeBatch<3, 4>();
+        auto a = sili::Matrix{m * trans(m)};
+        set_lane(a, 1, sili::Matrix{{{2., 0., 0.},
+                                     {0., 1., 0.},
+                                     {0., 0., 2.}}});
+        set_lane(a, 2, sili::Matrix{{{2., 1., 1.},
+                                     {1., 2., 1.},
+                                     {1., 1., 2.}}});
+        auto e = eig_sym(a);
+        static_assert(std::is_same_v<decltype(e), sili::EigSym<3, sili::Pack<double, 4>>>);
+        for (size_t i{0}; i < 4; ++i) {
+            auto es = eig_sym(lane(a, i));
+            CHECK(approxEqual(lane(e.values, i), es.values));
+            checkEigSym(lane(a, i), sili::EigSym<3, double>{lane(e.values, i), lane(e.vectors, i)});
+        }
+
+        auto b = makeBatch<4, 4>();
+        auto eb = eig_sym(sili::Matrix{b + trans(b)});
+        for (size_t i{0}; i < 4; ++i) {
+            checkEigSym(lane(b, i) + trans(lane(b, i)), sili::EigSym<4, double>{lane(eb.values, i), lane(eb.vectors, i)});
+        }
+    }
+}
+
+namespace {
+template <size_t N>
+void checkSolve() {
+    auto a = lane(makeBatch<N, 1>(), 0);
+    auto b = makeSequence<double, N, 2>(1.);
+    auto [x, singular] = solve(a, b);
+    static_assert(std::is_same_v<decltype(x), sili::Matrix<N, 2, double>>);
+    CHECK(not singular);
+    CHECK(approxEqual(x, sili::LU{a}.solve(b)));
+    CHECK(approxEqual(a * x, b));
+    CHECK(approxEqual(solve(a, view_col<1>(b)).x, view_col<1>(x)));
+}
+}
+
+TEST_CASE("solve", "[solve]") {
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Matrix{{{2., 1.},
+                                                {1., 3.}}};
+        static constexpr auto s = solve(a, sili::Matrix{{{3.}, {4.}}}); // Critical
+        static_assert(std::is_same_v<decltype(s), sili::Solution<2, 1, double> const>);
+        static_assert(s.x == sili::Matrix{{{1.}, {1.}}});
+        static_assert(not s.singular);
+    }
+
+    SECTION("closed forms and LU") {
+        checkSolve<1>();
+        checkSolve<2>();
+        checkSolve<3>();
+        checkSolve<4>();
+        checkSolve<6>();
+    }
+
+    SECTION("singular") {
+        CHECK(solve(sili::Matrix<1, 1, double>{}, sili::Matrix{{{1.}}}).singular);
+        CHECK(solve(sili::Matrix{{{1., 2.}, {2., 4.}}}, sili::Matrix{{{1.}, {1.}}}).singular);
+        CHECK(solve(sili::Matrix{{{1., 2., 3.}, {4., 5., 6.}, {7., 8., 9.}}}, sili::Matrix{{{1.}, {1.}, {1.}}}).singular);
+        auto a = lane(makeBatch<5, 1>(), 0);
+        view_row<2>(a) = sili::Matrix{view_row<3>(a)};
+        CHECK(solve(a, makeSequence<double, 5, 1>(1.)).singular);
+        // tiny but regular matrices are solved, there is no threshold
+        auto s = solve(sili::Matrix{{{1.e-4, 0.}, {0., 1.e-4}}}, sili::Matrix{{{1.}, {2.}}});
+        CHECK(not s.singular);
+        CHECK(approxEqual(s.x, sili::Matrix{{{1.e4}, {2.e4}}}));
+    }
+
+    SECTION("integer") {
+        auto [x, singular] = solve(sili::Matrix{{{2, 1}, {1, 3}}}, sili::Matrix{{{3}, {4}}});
+        static_assert(std::is_same_v<decltype(x), sili::Matrix<2, 1, double>>);
+        CHECK((x == sili::Matrix{{{1.}, {1.}}}));
+        CHECK(not singular);
+    }
+
+    SECTION("batch") {
+        auto a = makeBatch<3, 4>();
+        set_lane(a, 2, sili::Matrix{{{1., 2., 3.}, {2., 4., 6.}, {0., 0., 1.}}});
+        auto b = makeSequence<double, 3, 2>(1.);
+        auto [x, singular] = solve(a, b);
+        static_assert(std::is_same_v<decltype(x), sili::MatrixBatch<3, 2, double, 4>>);
+        CHECK((singular == sili::Pack{false, false, true, false}));
+        for (size_t i : {0, 1, 3}) {
+            CHECK(approxEqual(lane(x, i), solve(lane(a, i), b).x));
+        }
+
+        auto a5 = makeBatch<5, 4>();
+        auto s5 = solve(a5, makeSequence<double, 5, 1>(1.));
+        CHECK(not any_of(s5.singular));
+        for (size_t i{0}; i < 4; ++i) {
+            CHECK(approxEqual(lane(s5.x, i), solve(lane(a5, i), makeSequence<double, 5, 1>(1.)).x));
+        }
+    }
+}
+
+TEST_CASE("transformations", "[transform]") {
+    auto rot = sili::Matrix{{{0., -1., 0.},
+                             {1.,  0., 0.},
+                             {0.,  0., 1.}}};
+    auto lin = sili::Matrix{{{2., 1., 0.},
+                             {0., 3., 1.},
+                             {1., 0., 1.}}};
+    auto t1 = sili::Matrix{{{1.}, {2.}, {3.}}};
+    auto t2 = sili::Matrix{{{-4.}, {0.5}, {2.}}};
+
+    SECTION("constexpr") {
+        static constexpr auto a = sili::Affine3<double>{}; // Critical
+        static_assert(a == sili::makeI<4, double>());
+        static constexpr auto b = sili::Affine3<double>{2., 0., 0., 1.,
+                                                        0., 2., 0., 2.,
+                                                        0., 0., 2., 3.};
+        static_assert(b(3, 3) == 1.);
+        static constexpr auto p = b * sili::Matrix{{{1.}, {1.}, {1.}}}; // Critical
+        static_assert(p == sili::Matrix{{{3.}, {4.}, {5.}}});
+        static_assert(std::is_same_v<decltype(b * b), sili::Affine3<double>>);
+        static_assert(sili::_concept::Matrix<sili::Rigid3<float>>);
+    }
+
+    SECTION("last row is constant") {
+        auto a = sili::Affine3<double>{sili::Matrix<4, 4, double>{makeSequence<double, 4, 4>(1.)}};
+        CHECK((view_row<3>(a) == sili::Matrix{{{0., 0., 0., 1.}}}));
+        a = makeSequence<double, 4, 4>(2.);
+        CHECK((view_row<3>(a) == sili::Matrix{{{0., 0., 0., 1.}}}));
+        CHECK(a(0, 0) == makeSequence<double, 4, 4>(2.)(0, 0));
+        // sums are not transformations
+        static_assert(std::is_same_v<decltype(a + a), sili::Matrix<4, 4, double>>);
+        CHECK((a + a)(3, 3) == 2.);
+    }
+
+    SECTION("compose and transform") {
+        auto a = affine(lin, t1);
+        auto r = rigid(rot, t2);
+        auto m = sili::Matrix<4, 4, double>{a};
+        auto n = sili::Matrix<4, 4, double>{r};
+        static_assert(std::is_same_v<decltype(a * r), sili::Affine3<double>>);
+        static_assert(std::is_same_v<decltype(r * r), sili::Rigid3<double>>);
+        CHECK(approxEqual(a * r, m * n));
+        CHECK(approxEqual(r * a, n * m));
+        CHECK(approxEqual(r * r, n * n));
+
+        auto points = makeSequence<double, 3, 5>(-2.);
+        auto homogeneous = join_cols(points, sili::Matrix<1, 5, double>{1., 1., 1., 1., 0.});
+        auto tp = a * points;
+        auto th = a * homogeneous;
+        static_assert(std::is_same_v<decltype(tp), sili::Matrix<3, 5, double>>);
+        static_assert(std::is_same_v<decltype(th), sili::Matrix<4, 5, double>>);
+        CHECK(approxEqual(th, m * homogeneous));
+        CHECK(approxEqual(view<0, 0, 3, 4>(tp), view<0, 0, 3, 4>(th)));
+        // w = 0 is a direction, it is not translated
+        CHECK(approxEqual(view_col<4>(th), join_cols(lin * view_col<4>(points), sili::Matrix{{{0.}}})));
+        CHECK(det(a) == det(lin));
+    }
+
+    SECTION("inverse") {
+        auto a = affine(lin, t1);
+        auto [d, ai] = inv(a);
+        static_assert(std::is_same_v<decltype(ai), sili::Affine3<double>>);
+        CHECK(std::abs(d - det(lin)) < 1.e-12);
+        CHECK(approxEqual(ai * a, sili::makeI<4, double>()));
+        CHECK(approxEqual(ai, std::get<1>(inv(sili::Matrix<4, 4, double>{a}))));
+
+        auto r = rigid(rot, t2);
+        auto [dr, ri] = inv(r);
+        static_assert(std::is_same_v<decltype(ri), sili::Rigid3<double>>);
+        CHECK(dr == 1.);
+        CHECK(approxEqual(ri * r, sili::makeI<4, double>()));
+        CHECK((translation(ri) == sili::Matrix{{{-0.5}, {-4.}, {-2.}}}));
+
+        auto s = affine(sili::Matrix{{{1., 2., 3.}, {2., 4., 6.}, {0., 0., 1.}}}, t1);
+        CHECK(std::get<0>(inv(s)) == 0.);
+    }
 }
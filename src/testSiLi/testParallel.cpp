@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC0-1.0
+
+#include <sili/sili.h>
+#include <sili/parallel.h>
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+auto makeMatrices(size_t n) {
+    auto ms = std::vector<sili::Matrix<3, 3, double>>(n);
+    for (size_t i{0}; i < n; ++i) {
+        ms[i] = sili::Matrix{{{1. + i % 7, 2.,         0.},
+                              {0.,         3. + i % 5, 1.},
+                              {1.,         0.,         2. + i % 3}}};
+    }
+    return ms;
+}
+}
+
+TEST_CASE("parallel", "[parallel]") {
+    auto concurrency = GENERATE(size_t{1}, size_t{2}, size_t{4});
+    auto pool = sili::parallel::ThreadPool{concurrency};
+    CHECK(pool.concurrency() == concurrency);
+
+    auto n  = GENERATE(size_t{0}, size_t{1}, size_t{100}, size_t{10'000});
+    auto ms = makeMatrices(n);
+
+    SECTION("for_each") {
+        sili::parallel::for_each(pool, ms, [](auto& m) {
+            m = trans(m) * 2.;
+        });
+        auto expected = makeMatrices(n);
+        for (size_t i{0}; i < n; ++i) {
+            CHECK((ms[i] == trans(expected[i]) * 2.));
+        }
+    }
+
+    SECTION("for_each on views") {
+        sili::parallel::for_each(pool, ms, [](auto& m) {
+            view<1, 1, 3, 3>(m) = 0.;
+        });
+        for (auto const& m : ms) {
+            CHECK(m(0, 0) != 0.);
+            CHECK(m(2, 2) == 0.);
+        }
+    }
+
+    SECTION("batches") {
+        auto batches = std::vector<sili::MatrixBatch<3, 3, double, 4>>(n / 4);
+        sili::parallel::for_each(pool, batches, [](auto& b) {
+            b = sili::Matrix{{{1., 2., 3.},
+                              {0., 1., 4.},
+                              {5., 6., 0.}}};
+        });
+        auto ds = std::vector<sili::Pack<double, 4>>(batches.size());
+        sili::parallel::transform(pool, batches, ds, [](auto const& b) {
+            return det(b);
+        });
+        for (auto const& d : ds) {
+            CHECK(d == 1.);
+        }
+    }
+
+    SECTION("transform") {
+        auto ds = std::vector<double>(n);
+        sili::parallel::transform(pool, std::span{ms}, ds, [](auto const& m) {
+            return det(m);
+        });
+        for (size_t i{0}; i < n; ++i) {
+            CHECK(ds[i] == det(ms[i]));
+        }
+    }
+
+    SECTION("binary transform") {
+        auto rs = makeMatrices(n);
+        auto out = std::vector<sili::Matrix<3, 3, double>>(n);
+        sili::parallel::transform(pool, ms, rs, out, [](auto const& l, auto const& r) {
+            return l * r;
+        });
+        for (size_t i{0}; i < n; ++i) {
+            CHECK((out[i] == ms[i] * rs[i]));
+        }
+    }
+
+    SECTION("transform_reduce") {
+        auto s = sili::parallel::transform_reduce(pool, ms, 0., std::plus{}, [](auto const& m) {
+            return sum(m);
+        });
+        auto expected = std::accumulate(ms.begin(), ms.end(), 0., [](double acc, auto const& m) {
+            return acc + sum(m);
+        });
+        CHECK(std::abs(s - expected) < 1.e-9 * std::max(1., expected));
+    }
+
+    SECTION("exceptions") {
+        auto f = [&]() {
+            sili::parallel::for_each(pool, ms, [](auto const& m) {
+                if (m(0, 0) == 7.) {
+                    throw std::runtime_error{"failed"};
+                }
+            });
+        };
+        if (n >= 7) {
+            CHECK_THROWS_AS(f(), std::runtime_error);
+        } else {
+            CHECK_NOTHROW(f());
+        }
+    }
+
+    SECTION("nested") {
+        auto outer = std::vector<std::vector<sili::Matrix<3, 3, double>>>(8, ms);
+        sili::parallel::for_each(pool, outer, [&](auto& inner) {
+            sili::parallel::for_each(pool, inner, [](auto& m) {
+                m *= 2.;
+            });
+        });
+        for (auto const& inner : outer) {
+            for (size_t i{0}; i < n; ++i) {
+                CHECK((inner[i] == ms[i] * 2.));
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("parallel multiply", "[parallel]", float, double) {
+    using T = TestType;
+    auto concurrency = GENERATE(size_t{1}, size_t{2}, size_t{3}, size_t{4});
+    auto pool = sili::parallel::ThreadPool{concurrency};
+
+    auto fill = [](auto& m, unsigned seed) {
+        for (size_t row{0}; row < m.rows(); ++row) {
+            for (size_t col{0}; col < m.cols(); ++col) {
+                m(row, col) = T(std::sin(double(row * 31 + col * 17 + seed)));
+            }
+        }
+    };
+
+    // square, tall-skinny, wide and a depth beyond one cache block
+    auto shapes = std::vector<std::array<size_t, 3>>{{{200, 150, 170}},
+                                                     {{1000, 40, 40}},
+                                                     {{40, 40, 1000}},
+                                                     {{64, 600, 64}}};
+    for (auto [m, k, n] : shapes) {
+        INFO(m << "x" << k << " * " << k << "x" << n);
+        auto a = sili::DynMatrix<T>{m, k};
+        auto b = sili::DynMatrix<T>{k, n};
+        fill(a, 1);
+        fill(b, 2);
+
+        // bitwise identical to the serial product, for every thread count
+        auto c = sili::parallel::multiply(pool, a, b, 0);
+        CHECK(c == a * b);
+        CHECK(sili::parallel::multiply(pool, a, view_trans(trans(b)), 0) == c);
+
+        // below the serial cutoff
+        CHECK(sili::parallel::multiply(pool, a, b, m * n * k + 1) == c);
+    }
+}
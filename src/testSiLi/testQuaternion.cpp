@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC0-1.0
+
+#include <sili/sili.h>
+#include <sili/sili-Quaternion.h>
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace {
+template <typename T>
+auto scalarHamilton(sili::Quaternion<T> const& a, sili::Quaternion<T> const& b) {
+    return sili::Quaternion<T>{a(0)*b(0) - a(1)*b(1) - a(2)*b(2) - a(3)*b(3),
+                               a(0)*b(1) + a(1)*b(0) + a(2)*b(3) - a(3)*b(2),
+                               a(0)*b(2) - a(1)*b(3) + a(2)*b(0) + a(3)*b(1),
+                               a(0)*b(3) + a(1)*b(2) - a(2)*b(1) + a(3)*b(0)};
+}
+}
+
+TEMPLATE_TEST_CASE("quaternion", "[quaternion]", float, double) {
+    using T = TestType;
+    auto eps = std::is_same_v<T, float> ? T{1e-5} : T{1e-12};
+
+    SECTION("constexpr construction") {
+        constexpr auto id = sili::Quaternion<T>{};
+        static_assert(id(0) == T{1} and id(1) == T{0} and id(2) == T{0} and id(3) == T{0});
+        constexpr auto q = sili::Quaternion<T>{1, 2, 3, 4};
+        static_assert(q.real() == T{1});
+        static_assert(q.imag()(2) == T{4});
+        constexpr auto p = q * q.conjugate();
+        static_assert(p == sili::Quaternion<T>{30, 0, 0, 0});
+    }
+
+    SECTION("hamilton product") {
+        auto a = sili::Quaternion<T>{T{0.5}, T{-1.5}, T{2}, T{0.25}};
+        auto b = sili::Quaternion<T>{T{-3}, T{1}, T{0.75}, T{-2}};
+        auto r = a * b;
+        auto e = scalarHamilton(a, b);
+        for (size_t i{0}; i < 4; ++i) {
+            CHECK(std::abs(r(i) - e(i)) < eps);
+        }
+        // i*j = k, j*i = -k
+        auto i = sili::Quaternion<T>{0, 1, 0, 0};
+        auto j = sili::Quaternion<T>{0, 0, 1, 0};
+        CHECK(i * j == sili::Quaternion<T>{0, 0, 0, 1});
+        CHECK(j * i == sili::Quaternion<T>{0, 0, 0, -1});
+
+        auto c = a;
+        c *= b;
+        CHECK(c == r);
+    }
+
+    SECTION("rotate") {
+        auto axis = sili::Matrix<3, 1, T>{T{1}, T{-2}, T{0.5}};
+        auto q = sili::Quaternion<T>{T{0.7}, axis};
+        CHECK(std::abs(q.norm() - T{1}) < eps);
+
+        auto v = sili::Matrix<3, 1, T>{T{0.3}, T{4}, T{-1}};
+        auto r = q.rotate(v);
+        auto e = sili::Matrix<3, 1, T>{q.mat() * v};
+        for (size_t k{0}; k < 3; ++k) {
+            CHECK(std::abs(r(k) - e(k)) < eps * 10);
+        }
+        // equals q * v * q⁻¹
+        auto p = q * sili::Quaternion<T>{0, v(0), v(1), v(2)} * q.conjugate();
+        for (size_t k{0}; k < 3; ++k) {
+            CHECK(std::abs(r(k) - p(k+1)) < eps * 10);
+        }
+
+        auto z = sili::Quaternion<T>{std::numbers::pi_v<T> / T{2}, sili::Matrix<3, 1, T>{T{0}, T{0}, T{1}}};
+        auto y = z.rotate(sili::Matrix<3, 1, T>{T{1}, T{0}, T{0}});
+        CHECK(std::abs(y(0)) < eps);
+        CHECK(std::abs(y(1) - T{1}) < eps);
+        CHECK(std::abs(y(2)) < eps);
+    }
+
+    SECTION("from rotation matrix") {
+        for (auto angle : {T{0.1}, T{1.5}, T{3.}}) {
+            for (auto axis : {sili::Matrix<3, 1, T>{T{1}, T{0}, T{0}},
+                              sili::Matrix<3, 1, T>{T{0}, T{1}, T{0}},
+                              sili::Matrix<3, 1, T>{T{0}, T{0}, T{1}},
+                              sili::Matrix<3, 1, T>{T{1}, T{2}, T{3}}}) {
+                auto q = sili::Quaternion<T>{angle, axis};
+                auto m = sili::Quaternion<T>{q.mat()};
+                // q and -q are the same rotation
+                auto s = q.dot(m) < T{0} ? T{-1} : T{1};
+                for (size_t k{0}; k < 4; ++k) {
+                    CHECK(std::abs(q(k) - s * m(k)) < eps * 10);
+                }
+            }
+        }
+    }
+
+    SECTION("from two vectors") {
+        auto v1 = sili::Matrix<3, 1, T>{T{1}, T{2}, T{0}};
+        auto v2 = sili::Matrix<3, 1, T>{T{0}, T{-1}, T{3}};
+        auto q  = sili::Quaternion<T>{v1, v2};
+        auto r  = q.rotate(v1) * (T{1} / norm(v1));
+        auto n2 = v2 * (T{1} / norm(v2));
+        for (size_t k{0}; k < 3; ++k) {
+            CHECK(std::abs(r(k) - n2(k)) < eps * 10);
+        }
+    }
+
+    SECTION("slerp") {
+        auto axis = sili::Matrix<3, 1, T>{T{0}, T{0}, T{1}};
+        auto q0 = sili::Quaternion<T>{T{0.2}, axis};
+        auto q1 = sili::Quaternion<T>{T{1.4}, axis};
+        auto h  = q0.slerp(q1, T{0.5});
+        auto e  = sili::Quaternion<T>{T{0.8}, axis};
+        for (size_t k{0}; k < 4; ++k) {
+            CHECK(std::abs(h(k) - e(k)) < eps * 10);
+        }
+        auto s = q0.slerp(q1, T{0});
+        for (size_t k{0}; k < 4; ++k) {
+            CHECK(std::abs(s(k) - q0(k)) < eps * 10);
+        }
+    }
+
+    SECTION("batch slerp") {
+        // 37 pairs, so the last pairs are not a full pack
+        auto n  = size_t{37};
+        auto q0 = std::vector<sili::Quaternion<T>>{};
+        auto q1 = std::vector<sili::Quaternion<T>>{};
+        auto t  = std::vector<T>{};
+        for (size_t i{0}; i < n; ++i) {
+            auto axis0 = sili::Matrix<3, 1, T>{T(1 + i % 3), T(i % 5) - T{2}, T{0.5}};
+            auto axis1 = sili::Matrix<3, 1, T>{T{-1}, T(i % 4), T(1 + i % 2)};
+            q0.emplace_back(T(0.1 * i), axis0);
+            // i == 0 is the same rotation, i == 1 is the same rotation with the opposite sign
+            if (i == 0) {
+                q1.push_back(q0.back());
+            } else if (i == 1) {
+                q1.push_back(-q0.back());
+            } else {
+                q1.emplace_back(T(3. - 0.07 * i), axis1);
+            }
+            t.push_back(T(i % 11) / T{10});
+        }
+        auto exact  = std::vector<sili::Quaternion<T>>(n);
+        auto approx = std::vector<sili::Quaternion<T>>(n);
+        sili::slerp(q0, q1, t, exact);
+        sili::slerp(q0, q1, t, approx, sili::Interpolation::nlerp);
+
+        for (size_t i{0}; i < n; ++i) {
+            INFO(i);
+            auto e = q0[i].slerp(q1[i], t[i]);
+            for (size_t k{0}; k < 4; ++k) {
+                CHECK(std::abs(exact[i](k) - e(k)) < eps * 100);
+                CHECK(std::abs(approx[i](k) - e(k)) < T{5e-4});
+            }
+            CHECK(std::abs(exact[i].norm() - T{1}) < eps * 10);
+            CHECK(std::abs(approx[i].norm() - T{1}) < eps * 10);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2017 Lutz Freitag + Simon Gene Gottlieb
+// SPDX-License-Identifier: CC0-1.0
+
+#include <sili/sili.h>
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace {
+template <typename L, typename R>
+auto approxEqual(L const& l, R const& r) -> bool {
+    for (size_t row{0}; row < sili::rows_v<L>; ++row) {
+        for (size_t col{0}; col < sili::cols_v<L>; ++col) {
+            if (std::abs(l(row, col) - r(row, col)) > 1e-9) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// a symmetric positive definite matrix m * mᵀ + n
+template <size_t N>
+auto makeSpd() {
+    auto m = sili::Matrix<N, N, double>{};
+    for (size_t row{0}; row < N; ++row) {
+        for (size_t col{0}; col < N; ++col) {
+            m(row, col) = std::sin(double(row * N + col + 1));
+        }
+    }
+    auto a = sili::Matrix{m * trans(m)};
+    for (size_t k{0}; k < N; ++k) {
+        a(k, k) += double(N);
+    }
+    return a;
+}
+}
+
+TEST_CASE("symmetric matrix", "[symmatrix]") {
+    SECTION("constexpr") {
+        static constexpr auto p = sili::SymMatrix{{{4., 2.},
+                                                   {2., 5.}}};
+        static_assert(std::is_same_v<decltype(p), sili::SymMatrix<2, double> const>);
+        static_assert(sizeof(p) == 3 * sizeof(double));
+        static_assert(p(0, 1) == 2. and p(1, 0) == 2. and p.at<1, 1>() == 5.);
+        static_assert(p.data()[0] == 4. and p.data()[1] == 2. and p.data()[2] == 5.);
+        static_assert(full(p) == sili::Matrix{{{4., 2.}, {2., 5.}}});
+        static_assert(p * sili::Matrix{{{1.}, {1.}}} == sili::Matrix{{{6.}, {7.}}});
+        static_assert(p + p == p * 2.);
+        static_assert(cholesky(p).solve(sili::Matrix{{{6.}, {7.}}}) == sili::Matrix{{{1.}, {1.}}});
+        static_assert(sandwich(sili::Matrix{{{1., 1.}}}, p) == sili::SymMatrix{{{13.}}});
+    }
+
+    SECTION("element access and conversion") {
+        auto a = makeSpd<5>();
+        auto p = sili::SymMatrix{a};
+        static_assert(std::is_same_v<decltype(p), sili::SymMatrix<5, double>>);
+        static_assert(p.Size == 15);
+        CHECK((full(p) == a));
+
+        // only the lower triangle is read, writes are visible in both triangles
+        a(0, 4) = 100.;
+        CHECK(sili::SymMatrix{a} == p);
+        p(0, 4) = 7.;
+        CHECK(p(4, 0) == 7.);
+        CHECK(&p.at<1, 3>() == &p(3, 1));
+
+        // lazy access to all elements
+        auto m = sili::Matrix<5, 5, double>{};
+        m = lazy(p) * 2.;
+        CHECK(m(4, 0) == 14.);
+        CHECK(m(0, 4) == 14.);
+        m -= lazy(p);
+        CHECK((m == full(p)));
+        CHECK(sili::SymMatrix<5, double>{lazy(p) + m} == p * 2.);
+
+        p = 1.;
+        CHECK(sum(full(p)) == 25.);
+    }
+
+    SECTION("elementwise operations") {
+        auto a = makeSpd<4>();
+        auto b = sili::Matrix{a * 0.5 + sili::makeI<4, double>()};
+        auto p = sili::SymMatrix{a};
+        auto q = sili::SymMatrix{b};
+
+        CHECK((full(p + q) == a + b));
+        CHECK((full(p - q) == a - b));
+        CHECK((full(-p) == -a));
+        CHECK((full(p * 3.) == a * 3.));
+        CHECK((full(3. * p) == 3. * a));
+        CHECK(approxEqual(full(p / 3.), a / 3.));
+
+        auto r = p;
+        r += q;
+        r -= p;
+        CHECK(approxEqual(full(r), b));
+        r *= 4.;
+        r /= 2.;
+        CHECK(approxEqual(full(r), b + b));
+    }
+
+    SECTION("products") {
+        auto a = makeSpd<6>();
+        auto p = sili::SymMatrix{a};
+
+        auto x = sili::Matrix<6, 3, double>{};
+        for (size_t i{0}; i < 18; ++i) {
+            x(i / 3, i % 3) = std::cos(double(i));
+        }
+        CHECK(approxEqual(p * x, a * x));
+        CHECK(approxEqual(p * view_col<1>(x), a * view_col<1>(x)));
+        CHECK(approxEqual(trans(x) * p, trans(x) * a));
+        CHECK(approxEqual(view_trans(x) * p, trans(x) * a));
+
+        // j * p * jᵀ with j of a different size
+        auto j = sili::Matrix{trans(x)};
+        auto s = sandwich(j, p);
+        static_assert(std::is_same_v<decltype(s), sili::SymMatrix<3, double>>);
+        CHECK(approxEqual(full(s), j * a * trans(j)));
+        CHECK(approxEqual(full(sandwich(view_trans(x), p)), j * a * trans(j)));
+    }
+
+    SECTION("cholesky") {
+        auto a = makeSpd<7>();
+        auto p = sili::SymMatrix{a};
+        auto b = sili::Matrix<7, 2, double>{};
+        b = 1.;
+
+        auto llt = cholesky(p);
+        static_assert(std::is_same_v<decltype(llt), sili::LLT<7, double>>);
+        CHECK(not llt.failed());
+        CHECK(approxEqual(llt.L(), cholesky(a).L()));
+        CHECK(approxEqual(p * llt.solve(b), b));
+        CHECK(approxEqual(sili::SymMatrix{llt.inverse()} * a, sili::makeI<7, double>()));
+
+        auto ldlt = sili::LDLT{p};
+        CHECK(not ldlt.failed());
+        CHECK(std::abs(ldlt.det() - llt.det()) < 1e-9 * llt.det());
+
+        CHECK(cholesky(-p).failed());
+    }
+}